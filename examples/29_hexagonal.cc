@@ -62,6 +62,7 @@ int main() {
   std::cout << "\t2: Switch to Odd Flat grid\n";
   std::cout << "\t3: Switch to Even Pointy grid\n";
   std::cout << "\t4: Switch to Even Flat grid\n";
+  std::cout << "\tP: Switch between geometry and procedural mode\n";
   std::cout << "Current grid: Odd Pointy grid\n";
 
   renderer.clear(gf::Color::White);
@@ -98,6 +99,17 @@ int main() {
               currentGrid = &gridEvenFlat;
               break;
 
+            case gf::Scancode::P: {
+              gf::GridMode mode = currentGrid->getMode() == gf::GridMode::Geometry ? gf::GridMode::Procedural : gf::GridMode::Geometry;
+              std::cout << "Current mode: " << (mode == gf::GridMode::Geometry ? "Geometry" : "Procedural") << '\n';
+
+              for (auto grid : { &gridOddPointy, &gridOddFlat, &gridEvenPointy, &gridEvenFlat }) {
+                grid->setMode(mode);
+              }
+
+              break;
+            }
+
             case gf::Scancode::Escape:
               window.close();
               break;
@@ -0,0 +1,100 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gf/Clock.h>
+#include <gf/Color.h>
+#include <gf/HeadlessContext.h>
+#include <gf/Image.h>
+#include <gf/RenderTexture.h>
+#include <gf/Shapes.h>
+
+static constexpr int ThreadCount = 4;
+static constexpr int FrameCount = 100;
+
+static void renderFrames(gf::HeadlessContext& context, int index) {
+  context.setActive();
+
+  {
+    gf::RenderTexture texture({ 512, 512 });
+    texture.setActive();
+
+    gf::Clock clock;
+
+    for (int frame = 0; frame < FrameCount; ++frame) {
+      texture.clear(gf::Color::White);
+
+      for (int i = 0; i < 100; ++i) {
+        gf::CircleShape circle(10.0f + (i + frame) % 20);
+        circle.setColor(gf::Color::fromRgba32(static_cast<uint8_t>(0x20 * index), static_cast<uint8_t>(0x02 * i), 0x80, 0xC0));
+        circle.setPosition({ 5.0f * i, 2.0f * (i + frame) });
+        circle.setAnchor(gf::Anchor::Center);
+        texture.draw(circle);
+      }
+
+      texture.display();
+    }
+
+    gf::Image image = texture.capture();
+    std::printf("Thread #%i: %i frames in %i ms\n", index, FrameCount, static_cast<int>(clock.getElapsedTime().asMilliseconds()));
+
+    image.saveToFile("headless_" + std::to_string(index) + ".png");
+  }
+
+  context.setActive(false);
+}
+
+int main() {
+  gf::HeadlessContext::selectOffscreenDriver();
+
+  // the contexts are created on the main thread and then used by the workers
+  std::vector<std::unique_ptr<gf::HeadlessContext>> contexts;
+
+  for (int i = 0; i < ThreadCount; ++i) {
+    auto context = std::make_unique<gf::HeadlessContext>();
+
+    if (!context->isValid()) {
+      std::printf("Could not create a headless context.\n");
+      return 1;
+    }
+
+    context->setActive(false);
+    contexts.push_back(std::move(context));
+  }
+
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < ThreadCount; ++i) {
+    threads.emplace_back(renderFrames, std::ref(*contexts[i]), i);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return 0;
+}
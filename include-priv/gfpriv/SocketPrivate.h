@@ -42,6 +42,15 @@
 #include <gf/SocketAddress.h>
 #include <gf/Time.h>
 
+// the option that shares a port between listeners and balances the new
+// connections between them; on the BSDs and macOS, SO_REUSEPORT does not
+// balance the connections, only SO_REUSEPORT_LB (FreeBSD) does
+#if defined(SO_REUSEPORT_LB)
+#define GF_REUSE_PORT_OPTION SO_REUSEPORT_LB
+#elif defined(__linux__) && defined(SO_REUSEPORT)
+#define GF_REUSE_PORT_OPTION SO_REUSEPORT
+#endif
+
 namespace gf {
 namespace priv {
 
@@ -51,14 +60,18 @@ namespace priv {
 
   bool nativeWouldBlock(int err);
 
+  bool nativeSetReuseOption(SocketHandle handle, int option);
+
   SocketSelectorStatus nativePoll(std::vector<pollfd>& fds, Time duration);
 
-  SocketHandle nativeBindListen(const std::string& service, SocketFamily family);
+  SocketHandle nativeBindListen(const std::string& service, SocketFamily family, bool reuseAddress = false, bool reusePort = false);
 
   SocketHandle nativeConnect(const std::string& host, const std::string& service, SocketFamily family);
 
   SocketHandle nativeBind(const std::string& service, SocketFamily family);
 
+  SocketHandle nativeBind(const std::string& hostname, const std::string& service, SocketFamily family);
+
 #ifdef _WIN32
   inline
   int sendLength(Span<const uint8_t> buffer) {
@@ -123,6 +136,13 @@ namespace priv {
 
   constexpr int NoFlag = 0;
 
+#ifdef MSG_NOSIGNAL
+  // a closed connection must not kill the program with SIGPIPE
+  constexpr int SendFlag = MSG_NOSIGNAL;
+#else
+  constexpr int SendFlag = NoFlag;
+#endif
+
   std::vector<SocketAddressInfo> getRemoteAddressInfo(const std::string& hostname, const std::string& service, SocketType type, SocketFamily family = SocketFamily::Unspec);
   std::vector<SocketAddressInfo> getLocalAddressInfo(const std::string& service, SocketType type, SocketFamily family = SocketFamily::Unspec);
 
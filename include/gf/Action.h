@@ -21,8 +21,10 @@
 #ifndef GF_ACTION_H
 #define GF_ACTION_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Control.h"
@@ -184,6 +186,14 @@ inline namespace v1 {
      * @param control The control
      */
     void addControl(Control& control);
+
+    /**
+     * @brief Remove all the controls
+     *
+     * This function can be used to change the bindings of an action at
+     * runtime, before adding new controls.
+     */
+    void clearControls();
     /** @} */
 
     /**
@@ -226,6 +236,8 @@ inline namespace v1 {
       Continuous,
     };
 
+    friend class ActionContainer;
+
     std::string m_name;
     Type m_type;
     std::vector<std::unique_ptr<Control>> m_ownedControls;
@@ -236,9 +248,19 @@ inline namespace v1 {
    * @ingroup graphics_events
    * @brief A set of actions.
    *
+   * The container dispatches the events only to the controls that are
+   * interested in them, thanks to the routes of the controls (see
+   * gf::Control::getRoute()). The table of routes is built lazily and is
+   * rebuilt when an action is added or when the controls of an action
+   * change, so that bindings can be changed at runtime.
    */
   class GF_GRAPHICS_API ActionContainer {
   public:
+    /**
+     * @brief Default constructor
+     */
+    ActionContainer();
+
     /**
      * @brief Add an action.
      *
@@ -277,6 +299,8 @@ inline namespace v1 {
      *
      * @param event the event to update the actions.
      *
+     * Only the controls interested in the event are updated.
+     *
      * @sa Action;:processEvent()
      */
     void processEvent(const Event& event);
@@ -288,8 +312,18 @@ inline namespace v1 {
      */
     void reset();
 
+  private:
+    void updateRoutes();
+
+    struct RouteHash {
+      std::size_t operator()(const ControlRoute& route) const noexcept;
+    };
+
   private:
     std::vector<Ref<Action>> m_actions;
+    uint64_t m_routesGeneration;
+    std::unordered_map<ControlRoute, std::vector<Ref<Control>>, RouteHash> m_routes;
+    std::vector<Ref<Control>> m_unroutedControls;
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -0,0 +1,433 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_ARRAY2D_OPS_H
+#define GF_ARRAY2D_OPS_H
+
+#include <cassert>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "Array2D.h"
+#include "Rect.h"
+#include "Span.h"
+#include "Vector.h"
+#include "VectorOps.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_container
+   * @brief The execution of a bulk operation on a 2D array
+   *
+   * In parallel execution, the rows of the array are split in contiguous
+   * blocks that are processed by different threads. Small arrays are always
+   * processed sequentially.
+   *
+   * @sa gf::mapArray(), gf::zipArrays(), gf::reduceArray()
+   */
+  enum class Array2DExecution {
+    Sequential, ///< The operation is done in the calling thread
+    Parallel,   ///< The operation is split between the available cores
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  namespace details {
+
+    // minimum number of elements handled by a thread
+    constexpr std::size_t Array2DParallelGrain = 16384;
+
+    template<typename I>
+    std::size_t computeArrayBlockCount(Vector<I, 2> size, Array2DExecution execution) {
+      if (execution == Array2DExecution::Sequential || size.height <= 1) {
+        return 1;
+      }
+
+      std::size_t elements = static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height);
+      std::size_t count = std::max(std::thread::hardware_concurrency(), 1u);
+      count = std::min(count, elements / Array2DParallelGrain);
+      count = std::min(count, static_cast<std::size_t>(size.height));
+      return std::max(count, std::size_t(1));
+    }
+
+    // calls func(rowBegin, rowEnd, block) for each block of rows
+    template<typename I, typename Func>
+    void forEachArrayBlock(I rows, std::size_t blockCount, Func func) {
+      if (blockCount <= 1) {
+        func(I(0), rows, std::size_t(0));
+        return;
+      }
+
+      I step = static_cast<I>((static_cast<std::size_t>(rows) + blockCount - 1) / blockCount);
+      std::vector<std::thread> threads;
+      threads.reserve(blockCount - 1);
+
+      for (std::size_t block = 1; block < blockCount; ++block) {
+        I begin = static_cast<I>(block * step);
+        I end = std::min(static_cast<I>(begin + step), rows);
+
+        if (begin < end) {
+          threads.emplace_back(func, begin, end, block);
+        }
+      }
+
+      func(I(0), std::min(step, rows), std::size_t(0));
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    template<typename I>
+    bool clipArrayRegion(Vector<I, 2> size, Rect<I>& region) {
+      region.min.x = std::max(region.min.x, I(0));
+      region.min.y = std::max(region.min.y, I(0));
+      region.max.x = std::min(region.max.x, size.width);
+      region.max.y = std::min(region.max.y, size.height);
+      return region.min.x < region.max.x && region.min.y < region.max.y;
+    }
+
+  }
+#endif
+
+  /**
+   * @relates Array2D
+   * @brief Fill a rectangular region of an array
+   *
+   * The region is clipped to the array.
+   *
+   * @param array The array
+   * @param region The region to fill
+   * @param value The value to put in the region
+   */
+  template<typename T, typename I>
+  void fillRegion(Array2D<T, I>& array, Rect<I> region, const T& value) {
+    if (!details::clipArrayRegion(array.getSize(), region)) {
+      return;
+    }
+
+    auto count = static_cast<std::size_t>(region.max.x - region.min.x);
+
+    for (I y = region.min.y; y < region.max.y; ++y) {
+      std::fill_n(&array({ region.min.x, y }), count, value);
+    }
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Copy a rectangular region of an array into another array
+   *
+   * The region is clipped to the source array and to the destination array.
+   * The two arrays must be different.
+   *
+   * @param src The source array
+   * @param region The region of the source array to copy
+   * @param dst The destination array
+   * @param target The position of the region in the destination array
+   */
+  template<typename T, typename I>
+  void copyRegion(const Array2D<T, I>& src, Rect<I> region, Array2D<T, I>& dst, Vector<I, 2> target) {
+    assert(&src != &dst);
+    Vector<I, 2> origin = region.min;
+
+    if (!details::clipArrayRegion(src.getSize(), region)) {
+      return;
+    }
+
+    target += region.min - origin;
+    Rect<I> destination = Rect<I>::fromPositionSize(target, region.getSize());
+
+    if (!details::clipArrayRegion(dst.getSize(), destination)) {
+      return;
+    }
+
+    region.min += destination.min - target;
+    auto count = static_cast<std::size_t>(destination.max.x - destination.min.x);
+
+    for (I y = 0; y < destination.max.y - destination.min.y; ++y) {
+      std::copy_n(&src({ region.min.x, region.min.y + y }), count, &dst({ destination.min.x, destination.min.y + y }));
+    }
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Transform all the elements of an array
+   *
+   * Each element is replaced by `func(element)`. In parallel execution,
+   * `func` is called concurrently and must not throw.
+   *
+   * @param array The array
+   * @param func The transformation
+   * @param execution The execution of the operation
+   */
+  template<typename T, typename I, typename Func>
+  void mapArray(Array2D<T, I>& array, Func func, Array2DExecution execution = Array2DExecution::Sequential) {
+    auto cols = static_cast<std::size_t>(array.getCols());
+    T *data = array.begin();
+
+    details::forEachArrayBlock(array.getRows(), details::computeArrayBlockCount(array.getSize(), execution), [data, cols, &func](I begin, I end, std::size_t) {
+      T *first = data + static_cast<std::size_t>(begin) * cols;
+      T *last = data + static_cast<std::size_t>(end) * cols;
+
+      for (T *it = first; it != last; ++it) {
+        *it = func(*it);
+      }
+    });
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Combine the elements of two arrays
+   *
+   * Each element of `array` is replaced by `func(element, other)` where
+   * `other` is the element at the same position in `other`. The two arrays
+   * must have the same size. In parallel execution, `func` is called
+   * concurrently and must not throw.
+   *
+   * @param array The array to modify
+   * @param other The other array
+   * @param func The combination
+   * @param execution The execution of the operation
+   */
+  template<typename T, typename U, typename I, typename Func>
+  void zipArrays(Array2D<T, I>& array, const Array2D<U, I>& other, Func func, Array2DExecution execution = Array2DExecution::Sequential) {
+    assert(array.getSize() == other.getSize());
+    auto cols = static_cast<std::size_t>(array.getCols());
+    T *data = array.begin();
+    const U *otherData = other.begin();
+
+    details::forEachArrayBlock(array.getRows(), details::computeArrayBlockCount(array.getSize(), execution), [data, otherData, cols, &func](I begin, I end, std::size_t) {
+      std::size_t first = static_cast<std::size_t>(begin) * cols;
+      std::size_t last = static_cast<std::size_t>(end) * cols;
+
+      for (std::size_t i = first; i < last; ++i) {
+        data[i] = func(data[i], otherData[i]);
+      }
+    });
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Reduce all the elements of an array
+   *
+   * The result is `func(...func(func(init, e0), e1)..., en)`. In parallel
+   * execution, each block of rows is reduced from `init` and the partial
+   * results are then reduced in order, so `func` must be associative and
+   * `init` must be its neutral element. `func` must not throw.
+   *
+   * @param array The array
+   * @param init The initial value
+   * @param func The reduction
+   * @param execution The execution of the operation
+   * @returns The reduced value
+   */
+  template<typename T, typename I, typename R, typename Func>
+  R reduceArray(const Array2D<T, I>& array, R init, Func func, Array2DExecution execution = Array2DExecution::Sequential) {
+    auto cols = static_cast<std::size_t>(array.getCols());
+    const T *data = array.begin();
+
+    std::size_t blockCount = details::computeArrayBlockCount(array.getSize(), execution);
+    std::vector<R> partials(blockCount, init);
+
+    details::forEachArrayBlock(array.getRows(), blockCount, [data, cols, &func, &partials](I begin, I end, std::size_t block) {
+      const T *first = data + static_cast<std::size_t>(begin) * cols;
+      const T *last = data + static_cast<std::size_t>(end) * cols;
+      R result = partials[block];
+
+      for (const T *it = first; it != last; ++it) {
+        result = func(result, *it);
+      }
+
+      partials[block] = result;
+    });
+
+    R result = partials[0];
+
+    for (std::size_t block = 1; block < blockCount; ++block) {
+      result = func(result, partials[block]);
+    }
+
+    return result;
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Convolve an array with a separable kernel
+   *
+   * The kernel is the outer product of a horizontal kernel and a vertical
+   * kernel, each with an odd number of weights centered on the element. The
+   * elements outside the array are the nearest elements on the border.
+   *
+   * @param array The array
+   * @param horizontal The weights of the horizontal kernel
+   * @param vertical The weights of the vertical kernel
+   * @returns The convolved array
+   */
+  template<typename T, typename I>
+  Array2D<T, I> convolveSeparable(const Array2D<T, I>& array, Span<const T> horizontal, Span<const T> vertical) {
+    assert(horizontal.getSize() % 2 == 1);
+    assert(vertical.getSize() % 2 == 1);
+
+    Vector<I, 2> size = array.getSize();
+    auto cols = static_cast<std::size_t>(size.width);
+    Array2D<T, I> tmp(size, T());
+    Array2D<T, I> out(size, T());
+
+    if (array.isEmpty()) {
+      return out;
+    }
+
+    // horizontal pass, on a row padded with the border values
+
+    std::size_t radius = horizontal.getSize() / 2;
+    std::vector<T> padded(cols + 2 * radius);
+
+    for (I y = 0; y < size.height; ++y) {
+      const T *row = &array({ 0, y });
+      std::fill_n(padded.begin(), radius, row[0]);
+      std::copy_n(row, cols, padded.begin() + radius);
+      std::fill_n(padded.begin() + radius + cols, radius, row[cols - 1]);
+
+      T *dst = &tmp({ 0, y });
+
+      for (std::size_t k = 0; k < horizontal.getSize(); ++k) {
+        const T weight = horizontal[k];
+        const T *src = padded.data() + k;
+
+        for (std::size_t x = 0; x < cols; ++x) {
+          dst[x] += weight * src[x];
+        }
+      }
+    }
+
+    // vertical pass, row by row
+
+    auto verticalRadius = static_cast<I>(vertical.getSize() / 2);
+
+    for (I y = 0; y < size.height; ++y) {
+      T *dst = &out({ 0, y });
+
+      for (std::size_t k = 0; k < vertical.getSize(); ++k) {
+        const T weight = vertical[k];
+        I yy = gf::clamp(static_cast<I>(y + static_cast<I>(k) - verticalRadius), I(0), static_cast<I>(size.height - 1));
+        const T *src = &tmp({ 0, yy });
+
+        for (std::size_t x = 0; x < cols; ++x) {
+          dst[x] += weight * src[x];
+        }
+      }
+    }
+
+    return out;
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Compute the summed-area table of an array
+   *
+   * The element at @f$ (x, y) @f$ of the table is the sum of the elements
+   * of the array at @f$ (i, j) @f$ with @f$ i \le x @f$ and @f$ j \le y @f$.
+   *
+   * @param array The array
+   * @returns The summed-area table
+   * @sa gf::computeRegionSum()
+   */
+  template<typename T, typename I>
+  Array2D<T, I> computeSummedAreaTable(const Array2D<T, I>& array) {
+    Vector<I, 2> size = array.getSize();
+    auto cols = static_cast<std::size_t>(size.width);
+    Array2D<T, I> table(size, T());
+
+    if (array.isEmpty()) {
+      return table;
+    }
+
+    for (I y = 0; y < size.height; ++y) {
+      const T *src = &array({ 0, y });
+      T *dst = &table({ 0, y });
+      T sum = T();
+
+      for (std::size_t x = 0; x < cols; ++x) {
+        sum += src[x];
+        dst[x] = sum;
+      }
+
+      if (y > 0) {
+        const T *previous = &table({ 0, y - 1 });
+
+        for (std::size_t x = 0; x < cols; ++x) {
+          dst[x] += previous[x];
+        }
+      }
+    }
+
+    return table;
+  }
+
+  /**
+   * @relates Array2D
+   * @brief Compute the sum of a region with a summed-area table
+   *
+   * The region is clipped to the table. The computation is done in constant
+   * time.
+   *
+   * @param table The summed-area table of an array
+   * @param region The region of the array
+   * @returns The sum of the elements of the array in the region
+   * @sa gf::computeSummedAreaTable()
+   */
+  template<typename T, typename I>
+  T computeRegionSum(const Array2D<T, I>& table, Rect<I> region) {
+    if (!details::clipArrayRegion(table.getSize(), region)) {
+      return T();
+    }
+
+    I x0 = region.min.x - 1;
+    I y0 = region.min.y - 1;
+    I x1 = region.max.x - 1;
+    I y1 = region.max.y - 1;
+
+    T sum = table({ x1, y1 });
+
+    if (x0 >= 0) {
+      sum -= table({ x0, y1 });
+    }
+
+    if (y0 >= 0) {
+      sum -= table({ x1, y0 });
+    }
+
+    if (x0 >= 0 && y0 >= 0) {
+      sum += table({ x0, y0 });
+    }
+
+    return sum;
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_ARRAY2D_OPS_H
@@ -0,0 +1,99 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_BATCH_RECORD_H
+#define GF_BATCH_RECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreApi.h"
+#include "Matrix.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_utilities
+   * @brief A record of the geometries put in a batch
+   *
+   * A batch record keeps the version and the transform of each geometry
+   * that was put in a batch. It is used to know if the batch must be
+   * rebuilt: the batch is outdated as soon as an element has a different
+   * version or a different transform from the one that was recorded, or
+   * when the number of elements changes.
+   *
+   * @sa gf::WidgetContainer
+   */
+  class GF_CORE_API BatchRecord {
+  public:
+    /**
+     * @brief Remove all the recorded elements
+     *
+     * After this call, the batch is outdated for any non-empty list of
+     * elements.
+     */
+    void clear();
+
+    /**
+     * @brief Record an element
+     *
+     * @param version The version of the geometry of the element
+     * @param transform The transform of the element
+     */
+    void add(uint32_t version, const Matrix3f& transform);
+
+    /**
+     * @brief Get the number of recorded elements
+     *
+     * @returns The number of recorded elements
+     */
+    std::size_t getCount() const noexcept {
+      return m_elements.size();
+    }
+
+    /**
+     * @brief Check if an element has changed since it was recorded
+     *
+     * @param index The index of the element
+     * @param version The current version of the geometry of the element
+     * @param transform The current transform of the element
+     * @returns True if the element has not been recorded or has changed
+     */
+    bool hasChanged(std::size_t index, uint32_t version, const Matrix3f& transform) const;
+
+  private:
+    struct Element {
+      uint32_t version;
+      Matrix3f transform;
+    };
+
+    std::vector<Element> m_elements;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_BATCH_RECORD_H
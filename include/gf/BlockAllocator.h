@@ -22,8 +22,13 @@
 #define GF_SPATIAL_BLOCK_ALLOCATOR_H
 
 #include <cassert>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+#include "MemoryStats.h"
+#include "PoolAllocator.h"
+
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
@@ -31,48 +36,106 @@ inline namespace v1 {
 
   /**
    * @ingroup core_container
-   * @brief A null index in a block allocator
+   * @brief A contiguous allocator of objects referenced by an index
    *
-   * @sa gf::BlockAllocator
-   */
-  constexpr std::size_t NullIndex = static_cast<std::size_t>(-1);
-
-  /**
-   * @ingroup core_container
-   * @brief An allocator of objects referenced by an index
+   * The objects are stored in a single array, so accessing an object from
+   * its index is a single indirection. The free list is kept in a separate
+   * array, so that a traversal of the objects only touches the objects.
+   * When the allocator grows, the objects are moved: the addresses of the
+   * objects are not stable, only their indices are.
+   *
+   * This allocator is the right choice for index based structures with
+   * many lookups, like gf::DynamicTree. gf::PoolAllocator should be used
+   * when the addresses of the objects must stay valid.
+   *
+   * The memory owned by the allocator is accounted to the `Tag` subsystem
+   * in gf::MemoryStats.
+   *
+   * @sa gf::PoolAllocator, gf::NullIndex
    */
-  template<typename T>
+  template<typename T, MemoryTag Tag = MemoryTag::General>
   class BlockAllocator {
   public:
     /**
      * @brief Default constructor
      */
     BlockAllocator()
-    : m_firstFreeBlock(NullIndex)
+    : m_firstFreeIndex(NullIndex)
     , m_allocated(0)
     {
     }
 
+    /**
+     * @brief Copy constructor
+     *
+     * @param other The allocator to copy
+     */
+    BlockAllocator(const BlockAllocator& other)
+    : m_objects(other.m_objects)
+    , m_links(other.m_links)
+    , m_firstFreeIndex(other.m_firstFreeIndex)
+    , m_allocated(other.m_allocated)
+    {
+      MemoryStats::recordAllocation(Tag, getFootprint());
+    }
+
+    /**
+     * @brief Move constructor
+     *
+     * @param other The allocator to move
+     */
+    BlockAllocator(BlockAllocator&& other) noexcept
+    : m_objects(std::move(other.m_objects))
+    , m_links(std::move(other.m_links))
+    , m_firstFreeIndex(std::exchange(other.m_firstFreeIndex, NullIndex))
+    , m_allocated(std::exchange(other.m_allocated, 0))
+    {
+    }
+
+    /**
+     * @brief Assignment operator
+     *
+     * @param other The allocator to assign
+     */
+    BlockAllocator& operator=(BlockAllocator other) noexcept {
+      std::swap(m_objects, other.m_objects);
+      std::swap(m_links, other.m_links);
+      std::swap(m_firstFreeIndex, other.m_firstFreeIndex);
+      std::swap(m_allocated, other.m_allocated);
+      return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~BlockAllocator() {
+      MemoryStats::recordDeallocation(Tag, getFootprint());
+    }
+
     /**
      * @brief Allocate an object
      *
+     * The object is value-initialized. The objects may be moved by this
+     * function.
+     *
      * @returns The index representing the object
      */
     std::size_t allocate() {
-      std::size_t index = NullIndex;
+      std::size_t index = m_firstFreeIndex;
 
-      if (m_firstFreeBlock != NullIndex) {
-        index = m_firstFreeBlock;
-        m_firstFreeBlock = m_blocks[index].next;
-        m_blocks[index].next = NullIndex;
+      if (index != NullIndex) {
+        assert(m_links[index] != UsedIndex);
+        m_firstFreeIndex = m_links[index];
+        m_objects[index] = T();
       } else {
-        index = m_blocks.size();
-        m_blocks.push_back(Block());
+        std::size_t footprint = getFootprint();
+        index = m_objects.size();
+        m_objects.emplace_back();
+        m_links.push_back(NullIndex); // marked as used below
+        recordGrowth(footprint);
       }
 
-      assert(index < m_blocks.size());
-      assert(m_blocks[index].next == NullIndex);
-
+      m_links[index] = UsedIndex;
       ++m_allocated;
       return index;
     }
@@ -85,9 +148,9 @@ inline namespace v1 {
      * @param index A valid index
      */
     void dispose(std::size_t index) {
-      assert(index < m_blocks.size());
-      m_blocks[index].next = m_firstFreeBlock;
-      m_firstFreeBlock = index;
+      assert(isAllocated(index));
+      m_links[index] = m_firstFreeIndex;
+      m_firstFreeIndex = index;
       --m_allocated;
     }
 
@@ -97,9 +160,8 @@ inline namespace v1 {
      * @param index A valid index
      */
     T& operator[](std::size_t index) {
-      assert(index < m_blocks.size());
-      assert(m_blocks[index].next == NullIndex);
-      return m_blocks[index].data;
+      assert(isAllocated(index));
+      return m_objects[index];
     }
 
     /**
@@ -108,17 +170,41 @@ inline namespace v1 {
      * @param index A valid index
      */
     const T& operator[](std::size_t index) const {
-      assert(index < m_blocks.size());
-      assert(m_blocks[index].next == NullIndex);
-      return m_blocks[index].data;
+      assert(isAllocated(index));
+      return m_objects[index];
+    }
+
+    /**
+     * @brief Check if an index represents an allocated object
+     *
+     * @param index Any index
+     */
+    bool isAllocated(std::size_t index) const {
+      return index < m_links.size() && m_links[index] == UsedIndex;
+    }
+
+    /**
+     * @brief Reserve space for some objects
+     *
+     * @param capacity The minimum number of objects that can be allocated without growing
+     */
+    void reserve(std::size_t capacity) {
+      std::size_t footprint = getFootprint();
+      m_objects.reserve(capacity);
+      m_links.reserve(capacity);
+      recordGrowth(footprint);
     }
 
     /**
      * @brief Remove all objects at once
+     *
+     * The memory is kept for the next allocations.
      */
     void clear() {
-      m_firstFreeBlock = NullIndex;
-      m_blocks.clear();
+      m_objects.clear();
+      m_links.clear();
+      m_firstFreeIndex = NullIndex;
+      m_allocated = 0;
     }
 
     /**
@@ -130,18 +216,36 @@ inline namespace v1 {
       return m_allocated;
     }
 
+    /**
+     * @brief Get the number of objects that can be allocated without growing
+     */
+    std::size_t getCapacity() const {
+      return m_objects.capacity();
+    }
+
   private:
-    struct Block {
-      T data;
-      std::size_t next = NullIndex;
-    };
+    static constexpr std::size_t UsedIndex = NullIndex - 1;
+
+    std::size_t getFootprint() const {
+      return m_objects.capacity() * sizeof(T) + m_links.capacity() * sizeof(std::size_t);
+    }
 
-    std::size_t m_firstFreeBlock;
-    std::vector<Block> m_blocks;
+    void recordGrowth(std::size_t footprint) {
+      std::size_t current = getFootprint();
+
+      if (current != footprint) {
+        MemoryStats::recordDeallocation(Tag, footprint);
+        MemoryStats::recordAllocation(Tag, current);
+      }
+    }
+
+  private:
+    std::vector<T> m_objects;
+    std::vector<std::size_t> m_links;
+    std::size_t m_firstFreeIndex;
     std::size_t m_allocated;
   };
 
-
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
@@ -174,6 +174,102 @@ inline namespace v1 {
    */
   GF_CORE_API bool collides(const Polygon& lhs, const Polygon& rhs, Penetration& p);
 
+  /**
+   * @ingroup core_geometry
+   * @brief Data about the first contact between two moving objects
+   *
+   * @sa gf::timeOfImpact()
+   */
+  struct GF_CORE_API Impact {
+    float time; ///< Fraction of the motion when the objects touch, in @f$ [0, 1] @f$
+    Vector2f normal; ///< Contact normal, from the first object to the second
+  };
+
+  /**
+   * @relates Impact
+   * @brief Compute the time of impact of two moving circles
+   *
+   * The objects move by a translation during the step. At time @f$ t @f$,
+   * the first object is translated by `lhsMotion * t` from its original
+   * transform, and the same for the second object. If the objects already
+   * touch at the start, the time of impact is @f$ 0 @f$ and the normal is
+   * only an approximation, use collides() to get the penetration.
+   *
+   * @param lhs First circle
+   * @param lhsTrans Transformation of the first circle at the start of the step
+   * @param lhsMotion Translation of the first circle during the step
+   * @param rhs Second circle
+   * @param rhsTrans Transformation of the second circle at the start of the step
+   * @param rhsMotion Translation of the second circle during the step
+   * @param impact Data to fill if there is an impact
+   * @return True if the circles touch during the step
+   */
+  GF_CORE_API bool timeOfImpact(const CircF& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const CircF& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact);
+
+  /**
+   * @relates Impact
+   * @brief Compute the time of impact of a moving circle and a moving polygon
+   *
+   * The polygon must be convex.
+   *
+   * @param lhs The circle
+   * @param lhsTrans Transformation of the circle at the start of the step
+   * @param lhsMotion Translation of the circle during the step
+   * @param rhs The polygon
+   * @param rhsTrans Transformation of the polygon at the start of the step
+   * @param rhsMotion Translation of the polygon during the step
+   * @param impact Data to fill if there is an impact
+   * @return True if the objects touch during the step
+   */
+  GF_CORE_API bool timeOfImpact(const CircF& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const Polygon& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact);
+
+  /**
+   * @relates Impact
+   * @brief Compute the time of impact of a moving polygon and a moving circle
+   *
+   * The polygon must be convex.
+   *
+   * @param lhs The polygon
+   * @param lhsTrans Transformation of the polygon at the start of the step
+   * @param lhsMotion Translation of the polygon during the step
+   * @param rhs The circle
+   * @param rhsTrans Transformation of the circle at the start of the step
+   * @param rhsMotion Translation of the circle during the step
+   * @param impact Data to fill if there is an impact
+   * @return True if the objects touch during the step
+   */
+  GF_CORE_API bool timeOfImpact(const Polygon& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const CircF& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact);
+
+  /**
+   * @relates Impact
+   * @brief Compute the time of impact of two moving polygons
+   *
+   * The polygons must be convex.
+   *
+   * @param lhs First polygon
+   * @param lhsTrans Transformation of the first polygon at the start of the step
+   * @param lhsMotion Translation of the first polygon during the step
+   * @param rhs Second polygon
+   * @param rhsTrans Transformation of the second polygon at the start of the step
+   * @param rhsMotion Translation of the second polygon during the step
+   * @param impact Data to fill if there is an impact
+   * @return True if the polygons touch during the step
+   */
+  GF_CORE_API bool timeOfImpact(const Polygon& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const Polygon& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact);
+
+  /**
+   * @ingroup core_geometry
+   * @brief Compute the bounding box swept by a moving object
+   *
+   * This is the box that a broad phase must query so that a fast object
+   * does not tunnel through a thin one.
+   *
+   * @param bounds The bounding box at the start of the step
+   * @param motion The translation during the step
+   * @return The bounding box that contains the object during the whole step
+   */
+  GF_CORE_API RectF computeSweptBounds(const RectF& bounds, Vector2f motion);
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
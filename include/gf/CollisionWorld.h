@@ -0,0 +1,387 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_COLLISION_WORLD_H
+#define GF_COLLISION_WORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "Circ.h"
+#include "Collision.h"
+#include "CoreApi.h"
+#include "Handle.h"
+#include "Polygon.h"
+#include "PoolAllocator.h"
+#include "Rect.h"
+#include "Spatial_DynamicTree.h"
+#include "Time.h"
+#include "Transform.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_spatial
+   * @brief An identifier of a body in a collision world
+   *
+   * @sa gf::CollisionWorld
+   */
+  enum CollisionBodyId : std::size_t { };
+
+  /**
+   * @ingroup core_spatial
+   * @brief The type of a body in a collision world
+   *
+   * @sa gf::CollisionWorld
+   */
+  enum class CollisionBodyType {
+    Static,   ///< The body never moves, it is never tested against another static body
+    Dynamic,  ///< The body can move
+  };
+
+  /**
+   * @ingroup core_spatial
+   * @brief The type of a contact event
+   *
+   * @sa gf::CollisionEvent
+   */
+  enum class CollisionEventType {
+    Begin,    ///< The bodies started touching during this update
+    Persist,  ///< The bodies were already touching and are still touching
+    End,      ///< The bodies stopped touching during this update
+  };
+
+  /**
+   * @ingroup core_spatial
+   * @brief A contact event between two bodies
+   *
+   * The penetration goes from `lhs` to `rhs`. It is not meaningful for an
+   * end event.
+   *
+   * @sa gf::CollisionWorld
+   */
+  struct GF_CORE_API CollisionEvent {
+    CollisionEventType type;  ///< The type of the event
+    CollisionBodyId lhs;      ///< The first body
+    CollisionBodyId rhs;      ///< The second body
+    Handle lhsHandle;         ///< The handle of the first body
+    Handle rhsHandle;         ///< The handle of the second body
+    Penetration penetration;  ///< The penetration of the contact
+  };
+
+  /**
+   * @ingroup core_spatial
+   * @brief The first body hit by a moving body
+   *
+   * @sa gf::CollisionWorld::cast()
+   */
+  struct GF_CORE_API CollisionHit {
+    CollisionBodyId body;  ///< The body that is hit
+    Handle handle;         ///< The handle of the body that is hit
+    Impact impact;         ///< The time and normal of the impact
+  };
+
+  /**
+   * @ingroup core_spatial
+   * @brief A callback for contact events
+   */
+  using CollisionEventCallback = std::function<void(const CollisionEvent&)>;
+
+  /**
+   * @ingroup core_spatial
+   * @brief A set of bodies with persistent contacts
+   *
+   * A collision world ties a gf::DynamicTree and the functions of
+   * Collision.h together. Each body has a shape (a circle, a rectangle or
+   * a convex polygon) in local coordinates and a transform.
+   *
+   * The broad phase stores a fat bounding box for each body, i.e. its
+   * bounding box grown by a margin. The tree is only modified when a body
+   * leaves its fat bounding box, and the potential pairs are only searched
+   * for such bodies. The potential pairs are kept from one update to the
+   * next, and the narrow phase is only run on the pairs that are new or
+   * where one of the bodies moved since the last update. The other pairs
+   * keep the result of the previous update.
+   *
+   * The result is a stream of events: gf::CollisionEventType::Begin when
+   * two bodies start touching, gf::CollisionEventType::Persist while they
+   * keep touching and gf::CollisionEventType::End when they separate or
+   * when one of them is removed.
+   *
+   * When sleeping is enabled, a dynamic body that has not moved for some
+   * time falls asleep. The persist events of a pair where no body is awake
+   * are not reported anymore. Static bodies are always asleep.
+   *
+   * @sa gf::DynamicTree, gf::collides()
+   */
+  class GF_CORE_API CollisionWorld {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param margin The margin of the fat bounding boxes
+     */
+    CollisionWorld(float margin = 2.0f);
+
+    /**
+     * @brief Add a circle body
+     *
+     * @param handle A handle given back in the events
+     * @param circle The circle in local coordinates
+     * @param transform The transform of the body
+     * @param type The type of the body
+     * @returns The identifier of the body
+     */
+    CollisionBodyId addCircle(Handle handle, const CircF& circle, const Transform& transform = Transform(), CollisionBodyType type = CollisionBodyType::Dynamic);
+
+    /**
+     * @brief Add a rectangle body
+     *
+     * @param handle A handle given back in the events
+     * @param rectangle The rectangle in local coordinates
+     * @param transform The transform of the body
+     * @param type The type of the body
+     * @returns The identifier of the body
+     */
+    CollisionBodyId addRectangle(Handle handle, const RectF& rectangle, const Transform& transform = Transform(), CollisionBodyType type = CollisionBodyType::Dynamic);
+
+    /**
+     * @brief Add a convex polygon body
+     *
+     * @param handle A handle given back in the events
+     * @param polygon The convex polygon in local coordinates
+     * @param transform The transform of the body
+     * @param type The type of the body
+     * @returns The identifier of the body
+     */
+    CollisionBodyId addPolygon(Handle handle, const Polygon& polygon, const Transform& transform = Transform(), CollisionBodyType type = CollisionBodyType::Dynamic);
+
+    /**
+     * @brief Remove a body
+     *
+     * The end events of the contacts of the body are reported during the
+     * next update.
+     *
+     * @param id The identifier of the body
+     */
+    void removeBody(CollisionBodyId id);
+
+    /**
+     * @brief Remove all the bodies
+     *
+     * No end event is reported.
+     */
+    void clear();
+
+    /**
+     * @brief Set the transform of a body
+     *
+     * The body is woken up.
+     *
+     * @param id The identifier of the body
+     * @param transform The new transform of the body
+     */
+    void setTransform(CollisionBodyId id, const Transform& transform);
+
+    /**
+     * @brief Get the transform of a body
+     *
+     * @param id The identifier of the body
+     * @returns The transform of the body
+     */
+    const Transform& getTransform(CollisionBodyId id) const;
+
+    /**
+     * @brief Get the handle of a body
+     *
+     * @param id The identifier of the body
+     * @returns The handle given when the body was added
+     */
+    Handle getHandle(CollisionBodyId id) const;
+
+    /**
+     * @brief Get the bounding box of a body in world coordinates
+     *
+     * @param id The identifier of the body
+     * @returns The tight bounding box of the body
+     */
+    RectF getBounds(CollisionBodyId id) const;
+
+    /**
+     * @brief Wake up a body
+     *
+     * @param id The identifier of the body
+     */
+    void wake(CollisionBodyId id);
+
+    /**
+     * @brief Check if a body is awake
+     *
+     * @param id The identifier of the body
+     * @returns True if the body is awake
+     */
+    bool isAwake(CollisionBodyId id) const;
+
+    /**
+     * @brief Enable or disable sleeping
+     *
+     * Sleeping is enabled by default.
+     *
+     * @param enabled True to enable sleeping
+     */
+    void setSleepingEnabled(bool enabled);
+
+    /**
+     * @brief Set the time before a body falls asleep
+     *
+     * The default delay is half a second.
+     *
+     * @param delay The time a body must stay still before falling asleep
+     */
+    void setSleepDelay(Time delay) {
+      m_sleepDelay = delay;
+    }
+
+    /**
+     * @brief Update the world and report the contact events
+     *
+     * @param time The time since the last update
+     * @param callback The callback that receives the events
+     */
+    void update(Time time, CollisionEventCallback callback);
+
+    /**
+     * @brief Find the first body hit by a moving body
+     *
+     * The swept bounding box of the body is queried in the tree and the
+     * time of impact is computed with each candidate. The other bodies are
+     * considered still during the motion. This is meant for fast bodies
+     * that could tunnel through thin bodies between two updates: the body
+     * can then be moved at the time of impact with setTransform().
+     *
+     * @param id The identifier of the moving body
+     * @param motion The translation of the body during the step
+     * @param hit Data to fill if there is a hit
+     * @returns True if the body hits another body during the motion
+     * @sa gf::timeOfImpact(), gf::computeSweptBounds()
+     */
+    bool cast(CollisionBodyId id, Vector2f motion, CollisionHit& hit);
+
+    /**
+     * @brief Query the bodies whose fat bounding box intersect an area
+     *
+     * @param bounds The area
+     * @param callback A callback that receives the identifiers of the bodies
+     * @returns The number of bodies that were found
+     */
+    std::size_t query(const RectF& bounds, std::function<void(CollisionBodyId)> callback);
+
+    /**
+     * @brief Get the number of bodies
+     *
+     * @returns The number of bodies in the world
+     */
+    std::size_t getBodyCount() const {
+      return m_bodies.getAllocated();
+    }
+
+    /**
+     * @brief Get the number of potential pairs
+     *
+     * @returns The number of pairs in the pair cache
+     */
+    std::size_t getPairCount() const {
+      return m_pairs.size();
+    }
+
+    /**
+     * @brief Get the number of narrow phase tests during the last update
+     *
+     * @returns The number of pairs that were actually tested
+     */
+    std::size_t getNarrowPhaseCount() const {
+      return m_narrowPhaseCount;
+    }
+
+  private:
+    enum class ShapeType {
+      Circle,
+      Rectangle,
+      Polygon,
+    };
+
+    struct Body {
+      Handle handle;
+      CollisionBodyType type = CollisionBodyType::Dynamic;
+      ShapeType shape = ShapeType::Circle;
+      CircF circle;
+      RectF rectangle;
+      Polygon polygon;
+      Transform transform;
+      RectF fatBounds;
+      SpatialId proxy = SpatialId{};
+      Time stillTime = Time::zero();
+      bool moved = false;
+      bool awake = false;
+    };
+
+    struct Pair {
+      bool touching;
+      bool fresh;
+      Penetration penetration;
+    };
+
+    CollisionBodyId addBody(Body body);
+    void touchBody(std::size_t index);
+
+    static RectF computeBounds(const Body& body);
+    static bool collideBodies(const Body& lhs, const Body& rhs, Penetration& p);
+    static bool castBodies(const Body& lhs, Vector2f motion, const Body& rhs, Impact& impact);
+
+    static uint64_t makePairKey(std::size_t lhs, std::size_t rhs) {
+      return (static_cast<uint64_t>(lhs) << 32) | static_cast<uint64_t>(rhs);
+    }
+
+  private:
+    float m_margin;
+    bool m_sleepingEnabled;
+    Time m_sleepDelay;
+    PoolAllocator<Body, 256, MemoryTag::Spatial> m_bodies;
+    DynamicTree m_tree;
+    std::map<uint64_t, Pair> m_pairs;
+    std::vector<std::size_t> m_movedBodies;
+    std::vector<std::size_t> m_awakeBodies;
+    std::vector<std::size_t> m_proxyMoves;
+    std::vector<CollisionEvent> m_pendingEvents;
+    std::size_t m_narrowPhaseCount;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_COLLISION_WORLD_H
@@ -22,9 +22,11 @@
 #define GF_COLOR_RAMP_H
 
 #include <cassert>
+#include <cstddef>
 #include <map>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Color.h"
 #include "CoreApi.h"
@@ -36,6 +38,95 @@ namespace gf {
 inline namespace v1 {
 #endif
 
+  class Image;
+
+  /**
+   * @ingroup core_color
+   * @brief A color ramp baked in a lookup table
+   *
+   * A baked color ramp samples a color ramp at regular offsets. Computing a
+   * color is then a single lookup of the nearest sample, which is much
+   * faster than gf::ColorRampBase::computeColor() when many colors are
+   * computed, for example when exporting a heightmap.
+   *
+   * The table can also be exported as an image of height 1 and then loaded
+   * in a texture to be used in a shader.
+   *
+   * @sa gf::ColorRampBase::bake()
+   */
+  class GF_CORE_API BakedColorRamp {
+  public:
+    /**
+     * @brief Default constructor
+     *
+     * An empty baked color ramp always returns white, like an empty color
+     * ramp.
+     */
+    BakedColorRamp();
+
+    /**
+     * @brief Constructor
+     *
+     * @param min The offset of the first color
+     * @param max The offset of the last color
+     * @param colors The colors of the table, at regular offsets
+     */
+    BakedColorRamp(float min, float max, std::vector<Color4u> colors);
+
+    /**
+     * @brief Check if the baked color ramp is empty
+     *
+     * @return True if the table has no color
+     */
+    bool isEmpty() const {
+      return m_colors.empty();
+    }
+
+    /**
+     * @brief Get the number of colors in the table
+     */
+    std::size_t getSize() const {
+      return m_colors.size();
+    }
+
+    /**
+     * @brief Compute a color from an offset
+     *
+     * The offset is clamped to the offsets of the table.
+     *
+     * @param offset The offset of the wanted color
+     * @return The color of the nearest sample
+     */
+    Color4u computeColor(float offset) const {
+      if (m_colors.empty()) {
+        return Color4u(0xFF, 0xFF, 0xFF, 0xFF);
+      }
+
+      float index = (offset - m_min) * m_scale + 0.5f;
+
+      if (!(index > 0.0f)) { // also handles NaN
+        return m_colors.front();
+      }
+
+      auto i = static_cast<std::size_t>(index);
+      return i < m_colors.size() ? m_colors[i] : m_colors.back();
+    }
+
+    /**
+     * @brief Export the table to an image
+     *
+     * The image has the size of the table as width and a height of 1.
+     *
+     * @returns An image with the colors of the table
+     */
+    Image copyToImage() const;
+
+  private:
+    float m_min;
+    float m_scale;
+    std::vector<Color4u> m_colors;
+  };
+
   /**
    * @ingroup core_color
    * @brief A color ramp
@@ -116,6 +207,30 @@ inline namespace v1 {
       return gf::lerp(c1, c2, (offset - t1) / (t2 - t1));
     }
 
+    /**
+     * @brief Bake the color ramp in a lookup table
+     *
+     * The color ramp is sampled at regular offsets between its first and its
+     * last color stops.
+     *
+     * @param size The number of colors in the table
+     * @return A baked color ramp
+     */
+    BakedColorRamp bake(std::size_t size = 1024) const {
+      if (m_map.empty() || size == 0) {
+        return BakedColorRamp();
+      }
+
+      std::vector<Color4u> colors(size);
+
+      for (std::size_t i = 0; i < size; ++i) {
+        T offset = size > 1 ? m_min + (m_max - m_min) * static_cast<T>(i) / static_cast<T>(size - 1) : m_min;
+        colors[i] = ColorBase<T>::toRgba32(computeColor(offset));
+      }
+
+      return BakedColorRamp(static_cast<float>(m_min), static_cast<float>(m_max), std::move(colors));
+    }
+
   private:
     T m_min;
     T m_max;
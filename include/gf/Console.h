@@ -211,7 +211,8 @@ inline namespace v1 {
    *
    * A console is a virtual terminal where you can print the characters from a
    * console font. Each cell of the console has a background color, a
-   * foreground color and a 8-bit character.
+   * foreground color and a 8-bit character. The colors of the cells are
+   * stored with 8 bits per channel, so they are clamped to @f$ [0, 1] @f$.
    *
    * A console has a state with default values for different aspects:
    * - a default background color (initiallly gf::Color::Black)
@@ -245,14 +246,14 @@ inline namespace v1 {
      * @brief Get the width of the console
      */
     int getWidth() const {
-      return m_data.getSize().width;
+      return m_chars.getSize().width;
     }
 
     /**
      * @brief Get the height of the console
      */
     int getHeight() const {
-      return m_data.getSize().height;
+      return m_chars.getSize().height;
     }
 
     /**
@@ -329,7 +330,7 @@ inline namespace v1 {
      *
      * @sa setCharBackground()
      */
-    const Color4f& getCharBackground(Vector2i position) const;
+    Color4f getCharBackground(Vector2i position) const;
 
     /**
      * @brief Set the character foreground color
@@ -349,7 +350,7 @@ inline namespace v1 {
      *
      * @sa setCharForeground()
      */
-    const Color4f& getCharForeground(Vector2i position) const;
+    Color4f getCharForeground(Vector2i position) const;
 
     /**
      * @brief Set a character
@@ -662,8 +663,6 @@ inline namespace v1 {
     virtual void draw(RenderTarget& target, const RenderStates& states) override;
 
   private:
-    Color4f computeColor(ConsoleEffect effect, const Color4f& existing, const Color4f& current);
-
     int putWord(Vector2i position, ConsoleEffect effect, StringRef message, const Color4f& foreground, const Color4f& background);
 
     enum class PrintOption {
@@ -671,17 +670,15 @@ inline namespace v1 {
       CountOnly = 0x02,
     };
 
-    int printInternal(const RectI& rect, ConsoleEffect effect, ConsoleAlignment alignment, const std::string& message, Flags<PrintOption> flags = None);
+    int printInternal(const RectI& rect, ConsoleEffect effect, ConsoleAlignment alignment, StringRef message, Flags<PrintOption> flags = None);
 
   private:
-    struct Cell {
-      Color4f fg;
-      Color4f bg;
-      char16_t c;
-    };
-
+    // the cells are stored as separate planes with 8-bit colors so that a
+    // row of the console can be processed in a single tight loop
     const ConsoleFont *m_font;
-    Array2D<Cell, int> m_data;
+    Array2D<char16_t, int> m_chars;
+    Array2D<Color4u, int> m_foregrounds;
+    Array2D<Color4u, int> m_backgrounds;
     Color4f m_background;
     Color4f m_foreground;
 
@@ -21,6 +21,8 @@
 #ifndef GF_CONTROL_H
 #define GF_CONTROL_H
 
+#include <cstdint>
+
 #include "GraphicsApi.h"
 
 namespace gf {
@@ -30,6 +32,46 @@ inline namespace v1 {
 
   struct Event;
 
+  /**
+   * @ingroup graphics_events
+   * @brief The kind of input of a control route
+   *
+   * @sa gf::ControlRoute
+   */
+  enum class ControlRouteKind : uint8_t {
+    Keycode,        ///< A key, identified by its keycode
+    Scancode,       ///< A key, identified by its scancode
+    MouseButton,    ///< A mouse button
+    GamepadButton,  ///< A gamepad button
+    GamepadAxis,    ///< A gamepad axis
+    Close,          ///< The close event of a window
+  };
+
+  /**
+   * @ingroup graphics_events
+   * @brief The route of a control
+   *
+   * A route identifies the only events that can modify the state of a
+   * control: the kind of input, the device (for gamepads) and the code of the
+   * input (key, button or axis). It is used by gf::ActionContainer to send an
+   * event only to the controls that are interested in it.
+   *
+   * @sa gf::Control::getRoute()
+   */
+  struct ControlRoute {
+    ControlRouteKind kind;  ///< The kind of input
+    int32_t id;             ///< The device id (for gamepads)
+    int32_t code;           ///< The code of the input
+  };
+
+  /**
+   * @relates ControlRoute
+   * @brief Equality operator for control routes
+   */
+  constexpr bool operator==(const ControlRoute& lhs, const ControlRoute& rhs) {
+    return lhs.kind == rhs.kind && lhs.id == rhs.id && lhs.code == rhs.code;
+  }
+
   /**
    * @ingroup graphics_events
    * @brief A physical control.
@@ -91,6 +133,18 @@ inline namespace v1 {
      */
     virtual void processEvent(const Event& event) = 0;
 
+    /**
+     * @brief Get the route of the control
+     *
+     * If the control has a route, it only reacts to the events of this
+     * route. The default implementation returns false, meaning that the
+     * control must receive all the events.
+     *
+     * @param route The route of the control, if any
+     * @returns True if the control has a route
+     */
+    virtual bool getRoute(ControlRoute& route) const;
+
   private:
     bool m_active;
   };
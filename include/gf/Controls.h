@@ -47,6 +47,8 @@ inline namespace v1 {
 
     virtual void processEvent(const Event& event) override;
 
+    virtual bool getRoute(ControlRoute& route) const override;
+
   private:
     Keycode m_code;
   };
@@ -66,6 +68,8 @@ inline namespace v1 {
 
     virtual void processEvent(const Event& event) override;
 
+    virtual bool getRoute(ControlRoute& route) const override;
+
   private:
     Scancode m_code;
   };
@@ -85,6 +89,8 @@ inline namespace v1 {
 
     virtual void processEvent(const Event& event) override;
 
+    virtual bool getRoute(ControlRoute& route) const override;
+
   private:
     MouseButton m_button;
   };
@@ -106,6 +112,8 @@ inline namespace v1 {
 
     virtual void processEvent(const Event& event) override;
 
+    virtual bool getRoute(ControlRoute& route) const override;
+
   private:
     GamepadId m_id;
     GamepadButton m_button;
@@ -129,6 +137,8 @@ inline namespace v1 {
 
     virtual void processEvent(const Event& event) override;
 
+    virtual bool getRoute(ControlRoute& route) const override;
+
   private:
     GamepadId m_id;
     GamepadAxis m_axis;
@@ -149,6 +159,8 @@ inline namespace v1 {
     CloseControl();
 
     virtual void processEvent(const Event& event) override;
+
+    virtual bool getRoute(ControlRoute& route) const override;
   };
 
   /**
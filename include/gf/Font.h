@@ -28,6 +28,7 @@
 #include <map>
 
 #include "GraphicsApi.h"
+#include "MemoryStats.h"
 #include "Path.h"
 #include "Texture.h"
 
@@ -262,7 +263,7 @@ inline namespace v1 {
 
     struct GlyphCache {
       AlphaTexture texture;
-      std::map<uint64_t, Glyph> glyphs;
+      std::map<uint64_t, Glyph, std::less<uint64_t>, TrackedAllocator<std::pair<const uint64_t, Glyph>, MemoryTag::Fonts>> glyphs;
       Packing packing;
     };
 
@@ -0,0 +1,331 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_FRAME_ARENA_H
+#define GF_FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CoreApi.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_utilities
+   * @brief A linear allocator for transient data
+   *
+   * A frame arena hands out memory by bumping a pointer in large chunks
+   * that are kept from one frame to the next. Individual allocations are
+   * never freed: the whole arena is reset at once, generally at the end
+   * of the frame. After a few frames, the arena has reached its working
+   * size and does not ask anything to the heap anymore.
+   *
+   * If a frame needed more than one chunk, the chunks are merged into a
+   * single one at the next reset, so that the memory stays contiguous.
+   *
+   * Each thread has its own arena, available with getThreadLocal(). The
+   * arena of the main thread is reset by gf::RenderWindow::display().
+   * Code that may run outside a frame should use a gf::FrameArenaScope
+   * to give the memory back when it is done.
+   *
+   * @sa gf::FrameAllocator, gf::FrameArenaScope
+   */
+  class GF_CORE_API FrameArena {
+  public:
+    /**
+     * @brief The default size of a chunk
+     */
+    static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+    /**
+     * @brief A position in the arena
+     *
+     * @sa getMarker(), rewind()
+     */
+    struct Marker {
+      std::size_t chunk;  ///< The index of the current chunk
+      std::size_t offset; ///< The offset in the current chunk
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * No memory is allocated until the first allocation.
+     *
+     * @param chunkSize The minimum size of a chunk
+     */
+    explicit FrameArena(std::size_t chunkSize = DefaultChunkSize);
+
+    /**
+     * @brief Deleted copy constructor
+     */
+    FrameArena(const FrameArena&) = delete;
+
+    /**
+     * @brief Deleted copy assignment
+     */
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Allocate some memory
+     *
+     * @param size The size of the memory block
+     * @param alignment The alignment of the memory block, a power of two
+     * @returns A pointer to the memory block
+     */
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Give back some memory
+     *
+     * The memory is only reused if the block is the last one that was
+     * allocated, which is the case of a vector that grows.
+     *
+     * @param ptr A pointer to a memory block of this arena
+     * @param size The size of the memory block
+     */
+    void deallocate(void *ptr, std::size_t size);
+
+    /**
+     * @brief Get the current position in the arena
+     *
+     * @returns A marker that can be given to rewind()
+     */
+    Marker getMarker() const {
+      return { m_current, m_offset };
+    }
+
+    /**
+     * @brief Go back to a previous position
+     *
+     * All the memory allocated after the marker is given back.
+     *
+     * @param marker A marker obtained by getMarker()
+     */
+    void rewind(Marker marker);
+
+    /**
+     * @brief Give back all the memory of the arena
+     *
+     * The chunks are kept for the next frame.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of bytes currently in use
+     */
+    std::size_t getUsedSize() const;
+
+    /**
+     * @brief Get the number of bytes owned by the arena
+     */
+    std::size_t getCapacity() const;
+
+    /**
+     * @brief Get the number of chunks requested to the heap so far
+     *
+     * This counter does not move in a steady state. It can be checked
+     * from one frame to the next to detect a frame that needed more
+     * memory than the previous ones.
+     */
+    uint64_t getHeapAllocationCount() const {
+      return m_heapAllocationCount;
+    }
+
+    /**
+     * @brief Get the arena of the current thread
+     */
+    static FrameArena& getThreadLocal();
+
+  private:
+    struct Chunk {
+      std::unique_ptr<unsigned char[]> data;
+      std::size_t size;
+    };
+
+    void addChunk(std::size_t index, std::size_t size);
+
+  private:
+    std::size_t m_chunkSize;
+    std::vector<Chunk> m_chunks;
+    std::size_t m_current;
+    std::size_t m_offset;
+    uint64_t m_heapAllocationCount;
+  };
+
+  /**
+   * @ingroup core_utilities
+   * @brief A scope that gives back the memory of a frame arena
+   *
+   * The position of the arena is saved at construction and restored at
+   * destruction. The containers that use the arena must be declared
+   * after the scope.
+   *
+   * @sa gf::FrameArena
+   */
+  class FrameArenaScope {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param arena The arena to restore
+     */
+    explicit FrameArenaScope(FrameArena& arena = FrameArena::getThreadLocal())
+    : m_arena(arena)
+    , m_marker(arena.getMarker())
+    {
+    }
+
+    /**
+     * @brief Deleted copy constructor
+     */
+    FrameArenaScope(const FrameArenaScope&) = delete;
+
+    /**
+     * @brief Deleted copy assignment
+     */
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+    /**
+     * @brief Destructor
+     */
+    ~FrameArenaScope() {
+      m_arena.rewind(m_marker);
+    }
+
+  private:
+    FrameArena& m_arena;
+    FrameArena::Marker m_marker;
+  };
+
+  /**
+   * @ingroup core_utilities
+   * @brief A standard allocator that uses a frame arena
+   *
+   * By default, the allocator uses the arena of the current thread.
+   *
+   * @sa gf::FrameArena, gf::FrameVector
+   */
+  template<typename T>
+  class FrameAllocator {
+  public:
+    /**
+     * @brief The type of the allocated objects
+     */
+    using value_type = T;
+
+    /**
+     * @brief Constructor with the arena of the current thread
+     */
+    FrameAllocator()
+    : m_arena(&FrameArena::getThreadLocal())
+    {
+    }
+
+    /**
+     * @brief Constructor with an arena
+     *
+     * @param arena The arena to use
+     */
+    explicit FrameAllocator(FrameArena& arena) noexcept
+    : m_arena(&arena)
+    {
+    }
+
+    /**
+     * @brief Converting constructor
+     *
+     * @param other Another allocator
+     */
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept
+    : m_arena(other.getArena())
+    {
+    }
+
+    /**
+     * @brief Allocate memory for objects
+     *
+     * @param count The number of objects
+     */
+    T *allocate(std::size_t count) {
+      return static_cast<T *>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Deallocate memory for objects
+     *
+     * @param ptr The pointer returned by allocate()
+     * @param count The number of objects
+     */
+    void deallocate(T *ptr, std::size_t count) noexcept {
+      m_arena->deallocate(ptr, count * sizeof(T));
+    }
+
+    /**
+     * @brief Get the underlying arena
+     */
+    FrameArena *getArena() const noexcept {
+      return m_arena;
+    }
+
+  private:
+    FrameArena *m_arena;
+  };
+
+  /**
+   * @relates FrameAllocator
+   * @brief Equality operator between two allocators
+   */
+  template<typename T, typename U>
+  inline
+  bool operator==(const FrameAllocator<T>& lhs, const FrameAllocator<U>& rhs) noexcept {
+    return lhs.getArena() == rhs.getArena();
+  }
+
+  /**
+   * @relates FrameAllocator
+   * @brief Inequality operator between two allocators
+   */
+  template<typename T, typename U>
+  inline
+  bool operator!=(const FrameAllocator<T>& lhs, const FrameAllocator<U>& rhs) noexcept {
+    return lhs.getArena() != rhs.getArena();
+  }
+
+  /**
+   * @ingroup core_utilities
+   * @brief A vector allocated in a frame arena
+   */
+  template<typename T>
+  using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_FRAME_ARENA_H
@@ -0,0 +1,359 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_GPU_NOISES_H
+#define GF_GPU_NOISES_H
+
+#include <cstddef>
+
+#include "GraphicsApi.h"
+#include "Heightmap.h"
+#include "Rect.h"
+#include "Shader.h"
+#include "Texture.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  class FractalNoise2D;
+  class GradientNoise2D;
+  class Image;
+  class PerlinNoise2D;
+  class RenderTarget;
+  class SimplexNoise2D;
+  class WorleyNoise2D;
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief The encoding of the values of a GPU noise
+   *
+   * @sa gf::GpuNoise2D
+   */
+  enum class GpuNoiseEncoding {
+    Grayscale,  ///< The value is stored in the red, green and blue channels, with a 8-bit precision
+    Packed,     ///< The value is stored in the red and green channels, with a 16-bit precision
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief A 2D noise computed on the GPU
+   *
+   * A GPU noise renders the values of a noise in a render target, generally
+   * a gf::RenderTexture. A GPU noise is built from its CPU counterpart and
+   * uses the same permutation tables, so that the GPU values match the CPU
+   * values, up to the precision of the encoding.
+   *
+   * The values are mapped from a value range (@f$ [-1, 1] @f$ by default)
+   * to @f$ [0, 1] @f$ and clamped. The pixel @f$ (i, j) @f$ of a target of
+   * size @f$ (w, h) @f$ receives the value of the noise at
+   * @f$ (x + i \cdot \frac{W}{w}, y + j \cdot \frac{H}{h}) @f$ where
+   * @f$ (x, y) @f$ is the position of the rendered area and @f$ (W, H) @f$
+   * is its size. It is the same sampling as gf::Heightmap::addNoise() with
+   * an area of size `scale` at the origin.
+   *
+   * ~~~{.cc}
+   * gf::PerlinNoise2D noise(random, 1.0);
+   * gf::GpuPerlinNoise2D gpuNoise(noise);
+   * gpuNoise.setEncoding(gf::GpuNoiseEncoding::Packed);
+   *
+   * gf::RenderTexture texture({ 512, 512 });
+   * texture.setActive();
+   * gpuNoise.render(texture, gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 4.0f, 4.0f }));
+   * texture.display();
+   *
+   * gf::Heightmap heightmap = gpuNoise.decode(texture.capture());
+   * ~~~
+   *
+   * @sa gf::Noise2D, gf::PixelReadback
+   */
+  class GF_GRAPHICS_API GpuNoise2D {
+  public:
+    /**
+     * @brief Default constructor
+     */
+    GpuNoise2D();
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~GpuNoise2D();
+
+    /**
+     * @brief Deleted copy constructor
+     */
+    GpuNoise2D(const GpuNoise2D&) = delete;
+
+    /**
+     * @brief Deleted copy assignment
+     */
+    GpuNoise2D& operator=(const GpuNoise2D&) = delete;
+
+    /**
+     * @brief Set the range of the values
+     *
+     * The values of the noise in this range are mapped to @f$ [0, 1] @f$.
+     * Values outside the range are clamped.
+     *
+     * @param min The value mapped to 0
+     * @param max The value mapped to 1
+     */
+    void setValueRange(float min, float max);
+
+    /**
+     * @brief Set the encoding of the values
+     *
+     * By default, the encoding is gf::GpuNoiseEncoding::Grayscale.
+     *
+     * @param encoding The new encoding
+     */
+    void setEncoding(GpuNoiseEncoding encoding) {
+      m_encoding = encoding;
+    }
+
+    /**
+     * @brief Get the encoding of the values
+     *
+     * @returns The current encoding
+     */
+    GpuNoiseEncoding getEncoding() const {
+      return m_encoding;
+    }
+
+    /**
+     * @brief Render the noise in a target
+     *
+     * The whole target is covered, the current view of the target is
+     * ignored.
+     *
+     * @param target The render target
+     * @param area The area of the noise to render
+     */
+    void render(RenderTarget& target, const RectF& area);
+
+    /**
+     * @brief Decode the values of an image
+     *
+     * The image must have been captured from a target where the noise was
+     * rendered, with gf::RenderTexture::capture() or gf::PixelReadback.
+     *
+     * @param image The captured image
+     * @returns A heightmap with the values of the noise
+     */
+    Heightmap decode(const Image& image) const;
+
+  protected:
+    /**
+     * @brief The octaves of a noise
+     */
+    struct Octaves {
+      float scale = 1.0f;
+      int count = 1;
+      float lacunarity = 2.0f;
+      float persistence = 0.5f;
+      float dimension = 1.0f;
+    };
+
+    /**
+     * @brief Get the shader of the noise
+     *
+     * The shader is ready to be used, except for the octaves and the
+     * encoding that are set by render().
+     */
+    virtual Shader& getShader() = 0;
+
+    /**
+     * @brief Get the octaves of the noise
+     *
+     * By default, a noise has one octave.
+     */
+    virtual Octaves getOctaves() const;
+
+    /**
+     * @brief Get the shader of another noise
+     */
+    static Shader& getShaderOf(GpuNoise2D& noise) {
+      return noise.getShader();
+    }
+
+    /**
+     * @brief Get the octaves of another noise
+     */
+    static Octaves getOctavesOf(const GpuNoise2D& noise) {
+      return noise.getOctaves();
+    }
+
+  private:
+    float m_min;
+    float m_max;
+    GpuNoiseEncoding m_encoding;
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief Gradient 2D noise computed on the GPU
+   *
+   * The step of the CPU noise must be one of gf::linearStep(),
+   * gf::cubicStep(), gf::quinticStep() or gf::cosineStep().
+   *
+   * @sa gf::GradientNoise2D
+   */
+  class GF_GRAPHICS_API GpuGradientNoise2D : public GpuNoise2D {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param noise The CPU noise
+     */
+    GpuGradientNoise2D(const GradientNoise2D& noise);
+
+  protected:
+    Shader& getShader() override;
+
+  private:
+    Shader m_shader;
+    Texture m_lattice;
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief Simplex 2D noise computed on the GPU
+   *
+   * @sa gf::SimplexNoise2D
+   */
+  class GF_GRAPHICS_API GpuSimplexNoise2D : public GpuNoise2D {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param noise The CPU noise
+     */
+    GpuSimplexNoise2D(const SimplexNoise2D& noise);
+
+  protected:
+    Shader& getShader() override;
+
+  private:
+    Shader m_shader;
+    Texture m_lattice;
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief Worley 2D noise computed on the GPU
+   *
+   * The distance of the CPU noise must be one of gf::manhattanDistance(),
+   * gf::squareDistance(), gf::euclideanDistance(), gf::chebyshevDistance()
+   * or gf::naturalDistance(). The CPU noise can have at most 256 points
+   * and 4 coefficients.
+   *
+   * @sa gf::WorleyNoise2D
+   */
+  class GF_GRAPHICS_API GpuWorleyNoise2D : public GpuNoise2D {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param noise The CPU noise
+     */
+    GpuWorleyNoise2D(const WorleyNoise2D& noise);
+
+  protected:
+    Shader& getShader() override;
+
+  private:
+    Shader m_shader;
+    Texture m_cells;
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief Fractal 2D noise computed on the GPU
+   *
+   * The octaves are computed in the shader of the basic noise, so the basic
+   * noise must not be a fractal noise itself. At most 16 octaves are
+   * computed.
+   *
+   * @sa gf::FractalNoise2D
+   */
+  class GF_GRAPHICS_API GpuFractalNoise2D : public GpuNoise2D {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param noise The basic noise function
+     * @param scale The scale factor
+     * @param octaves The number of octaves
+     * @param lacunarity The factor applied to frequency
+     * @param persistence The factor applied to amplitude
+     * @param dimension The contrast between the layers
+     */
+    GpuFractalNoise2D(GpuNoise2D& noise, double scale, std::size_t octaves = 8, double lacunarity = 2.0, double persistence = 0.5, double dimension = 1.0);
+
+    /**
+     * @brief Constructor
+     *
+     * The parameters are taken from the CPU noise.
+     *
+     * @param noise The basic noise function
+     * @param fractal The CPU fractal noise
+     */
+    GpuFractalNoise2D(GpuNoise2D& noise, const FractalNoise2D& fractal);
+
+  protected:
+    Shader& getShader() override;
+    Octaves getOctaves() const override;
+
+  private:
+    GpuNoise2D& m_noise;
+    Octaves m_octaves;
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief Perlin 2D noise computed on the GPU
+   *
+   * @sa gf::PerlinNoise2D
+   */
+  class GF_GRAPHICS_API GpuPerlinNoise2D : public GpuNoise2D {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param noise The CPU noise
+     */
+    GpuPerlinNoise2D(const PerlinNoise2D& noise);
+
+  protected:
+    Shader& getShader() override;
+    Octaves getOctaves() const override;
+
+  private:
+    GpuGradientNoise2D m_gradient;
+    Octaves m_octaves;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_GPU_NOISES_H
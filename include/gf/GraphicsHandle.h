@@ -38,6 +38,7 @@ inline namespace v1 {
     Buffer,       ///< A GPU buffer
     Framebuffer,  ///< A GPU framebuffer
     Texture,      ///< A GPU texture
+    VertexArray,  ///< A GPU vertex array object
   };
 
   /**
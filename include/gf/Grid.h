@@ -21,8 +21,11 @@
 #ifndef GF_GRID_H
 #define GF_GRID_H
 
+#include <memory>
+
 #include "GraphicsApi.h"
 #include "Hexagon.h"
+#include "Shader.h"
 #include "Transformable.h"
 #include "Vector.h"
 #include "VertexArray.h"
@@ -33,9 +36,26 @@ namespace gf {
 inline namespace v1 {
 #endif
 
+  /**
+   * @ingroup graphics_drawables
+   * @brief The rendering mode of a grid
+   *
+   * @sa gf::SquareGrid, gf::HexagonGrid
+   */
+  enum class GridMode {
+    Geometry,   ///< The lines are vertices drawn with the line width of the driver
+    Procedural, ///< The lines are computed by a shader on a single quad
+  };
+
   /**
    * @ingroup graphics_drawables
    * @brief A square grid
+   *
+   * In gf::GridMode::Procedural, the grid is a single quad and a fragment
+   * shader computes anti-aliased lines, so the cost does not depend on the
+   * size of the grid, and the line width (in pixels) is not limited by the
+   * driver. In this mode, the border of the grid is drawn on all sides and
+   * commitGeometry() returns an empty buffer.
    */
   class GF_GRAPHICS_API SquareGrid : public gf::Transformable {
   public:
@@ -115,6 +135,24 @@ inline namespace v1 {
       return m_lineWidth;
     }
 
+    /**
+     * @brief Set the rendering mode of the grid
+     *
+     * The default mode is gf::GridMode::Geometry.
+     *
+     * @param mode The new rendering mode
+     */
+    void setMode(GridMode mode);
+
+    /**
+     * @brief Get the rendering mode of the grid
+     *
+     * @returns The current rendering mode
+     */
+    GridMode getMode() const noexcept {
+      return m_mode;
+    }
+
     /**
      * @brief Get the local bounding rectangle of the entity
      *
@@ -160,12 +198,19 @@ inline namespace v1 {
     Vector2f m_cellSize;
     Color4f m_color;
     float m_lineWidth;
+    GridMode m_mode;
     VertexArray m_vertices;
+    std::shared_ptr<Shader> m_shader; // shared by the copies, the uniforms are set before each draw
   };
 
   /**
    * @ingroup graphics_drawables
    * @brief A hexagonal grid
+   *
+   * In gf::GridMode::Procedural, the grid is a single quad and a fragment
+   * shader computes anti-aliased lines, so the cost does not depend on the
+   * size of the grid, and the line width (in pixels) is not limited by the
+   * driver. In this mode, commitGeometry() returns an empty buffer.
    */
   class GF_GRAPHICS_API HexagonGrid : public gf::Transformable {
   public:
@@ -258,6 +303,24 @@ inline namespace v1 {
       return m_lineWidth;
     }
 
+    /**
+     * @brief Set the rendering mode of the grid
+     *
+     * The default mode is gf::GridMode::Geometry.
+     *
+     * @param mode The new rendering mode
+     */
+    void setMode(GridMode mode);
+
+    /**
+     * @brief Get the rendering mode of the grid
+     *
+     * @returns The current rendering mode
+     */
+    GridMode getMode() const noexcept {
+      return m_mode;
+    }
+
     /**
      * @brief Get the local bounding rectangle of the entity
      *
@@ -304,7 +367,9 @@ inline namespace v1 {
     HexagonHelper m_helper;
     Color4f m_color;
     float m_lineWidth;
+    GridMode m_mode;
     VertexArray m_vertices;
+    std::shared_ptr<Shader> m_shader; // shared by the copies, the uniforms are set before each draw
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
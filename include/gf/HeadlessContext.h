@@ -0,0 +1,136 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_HEADLESS_CONTEXT_H
+#define GF_HEADLESS_CONTEXT_H
+
+#include "GraphicsApi.h"
+#include "Library.h"
+#include "Vector.h"
+
+struct SDL_Window;
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup graphics_window_monitor
+   * @brief An OpenGL context without any visible window
+   *
+   * gf::HeadlessContext provides an OpenGL context that can be used to
+   * render in a gf::RenderTexture without a gf::Window. It is useful for
+   * batch rendering, tools and benchmarks.
+   *
+   * The context is backed by a hidden window. If the program runs on a
+   * machine without a display, call selectOffscreenDriver() before any
+   * gf::Library is created: SDL then uses its `offscreen` video driver
+   * that relies on EGL and does not need any display server.
+   *
+   * Each headless context is independent: it does not share its objects
+   * with the other contexts. So several contexts can render in parallel,
+   * one per thread. The contexts should be created on the main thread and
+   * then attached to a worker thread with setActive().
+   *
+   * ~~~{.cc}
+   * gf::HeadlessContext::selectOffscreenDriver();
+   *
+   * gf::HeadlessContext context;
+   * gf::RenderTexture texture({ 256, 256 });
+   *
+   * texture.clear(gf::Color::White);
+   * texture.draw(shape);
+   * texture.display();
+   *
+   * gf::Image image = texture.capture();
+   * ~~~
+   *
+   * @sa gf::RenderTexture, gf::SharedGraphics
+   */
+  class GF_GRAPHICS_API HeadlessContext {
+  public:
+    /**
+     * @brief Create a headless context
+     *
+     * The context is active on the current thread after its creation.
+     *
+     * @param size The size of the underlying hidden surface
+     */
+    HeadlessContext(Vector2i size = Vector2i(1, 1));
+
+    /**
+     * @brief Destructor
+     *
+     * The context is made active on the current thread in order to
+     * release its resources, and then deactivated.
+     */
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext(HeadlessContext&&) = delete;
+
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(HeadlessContext&&) = delete;
+
+    /**
+     * @brief Check if the context has been successfully created
+     *
+     * @returns True if the context can be used
+     */
+    bool isValid() const {
+      return m_context != nullptr;
+    }
+
+    /**
+     * @brief Activate or deactivate the context on the current thread
+     *
+     * A context can be active on only one thread at a time. So it must be
+     * deactivated on a thread before being activated on another thread.
+     *
+     * @param active True to activate, false to deactivate
+     */
+    void setActive(bool active = true);
+
+    /**
+     * @brief Select a video driver that does not need a display
+     *
+     * This function must be called before any gf::Library (or gf::Window)
+     * is created. It has no effect if the `SDL_VIDEODRIVER` environment
+     * variable is already defined, so that the user can still choose
+     * another driver.
+     */
+    static void selectOffscreenDriver();
+
+  private:
+    Library m_lib; // to automatically initialize SDL
+
+  private:
+    SDL_Window *m_window;
+    void *m_context;
+    unsigned m_vao;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_HEADLESS_CONTEXT_H
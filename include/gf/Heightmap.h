@@ -24,9 +24,11 @@
 #include <tuple>
 
 #include "Array2D.h"
+#include "Array2DOps.h"
 #include "ColorRamp.h"
 #include "CoreApi.h"
 #include "Image.h"
+#include "MemoryStats.h"
 #include "Noise.h"
 #include "Rect.h"
 
@@ -35,6 +37,8 @@ namespace gf {
 inline namespace v1 {
 #endif
 
+  class SnapshotHistory;
+
   /**
    * @ingroup core_procedural_generation
    * @brief A heightmap
@@ -248,11 +252,12 @@ inline namespace v1 {
      *
      * The heightmap is assumed to be normalized.
      *
+     * @param execution The execution of the export
      * @returns A grayscale image representing the heightmap
      *
      * @sa copyToColoredImage()
      */
-    Image copyToGrayscaleImage() const;
+    Image copyToGrayscaleImage(Array2DExecution execution = Array2DExecution::Parallel) const;
 
     /**
      * @brief Export to a colored image
@@ -263,21 +268,47 @@ inline namespace v1 {
      * actual water level can be specified and the ramp is automatically
      * adapted on the fly.
      *
+     * The ramp is baked before the export, see gf::ColorRampBase::bake().
+     *
      * @param ramp A color ramp
      * @param waterLevel The actual water level (defaults to @f$ 0.5 @f$)
      * @param render The rendering mode
+     * @param execution The execution of the export
      * @returns A colored image representing the heightmap
      *
      * @sa copyToGrayscaleImage()
      */
-    Image copyToColoredImage(const ColorRampD& ramp, double waterLevel = 0.5, Render render = Render::Colored) const;
+    Image copyToColoredImage(const ColorRampD& ramp, double waterLevel = 0.5, Render render = Render::Colored, Array2DExecution execution = Array2DExecution::Parallel) const;
+
+    /**
+     * @brief Export to a colored image with a baked color ramp
+     *
+     * This function is the same as the previous one, but the ramp is
+     * already baked. Use it when several heightmaps are exported with the
+     * same ramp.
+     *
+     * @param ramp A baked color ramp
+     * @param waterLevel The actual water level (defaults to @f$ 0.5 @f$)
+     * @param render The rendering mode
+     * @param execution The execution of the export
+     * @returns A colored image representing the heightmap
+     */
+    Image copyToColoredImage(const BakedColorRamp& ramp, double waterLevel = 0.5, Render render = Render::Colored, Array2DExecution execution = Array2DExecution::Parallel) const;
 
     /**
      * @}
      */
 
+    /**
+     * @brief Track the values of the heightmap in a snapshot history
+     *
+     * @param history The snapshot history
+     */
+    void trackState(SnapshotHistory& history);
+
   private:
     Array2D<double, int> m_data;
+    MemoryReservation m_memory { MemoryTag::Heightmaps };
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
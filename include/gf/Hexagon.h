@@ -25,8 +25,10 @@
 #include "MapCell.h"
 #include "Math.h"
 #include "Rect.h"
+#include "Span.h"
 #include "Vector.h"
 
+#include <array>
 #include <vector>
 
 namespace gf {
@@ -93,6 +95,96 @@ inline namespace v1 {
      */
     std::vector<Vector2f> computeCorners(Vector2i coords, float radius) const;
 
+    /**
+     * @brief Compute the six corners of the hexagon without allocation
+     *
+     * This version writes the corners in a buffer provided by the caller. It
+     * should be preferred when computing the corners of many hexagons, e.g.
+     * when building the geometry of a grid.
+     *
+     * @param coords The position of the hexagon in the map
+     * @param radius Radius of hexagon
+     * @param corners A buffer of (at least) six corners
+     */
+    void computeCorners(Vector2i coords, float radius, Span<Vector2f> corners) const noexcept;
+
+    /**
+     * @name Coordinates
+     * @{
+     */
+
+    /**
+     * @brief Convert offset coordinates to axial coordinates
+     *
+     * Offset coordinates are the coordinates used in the map storage, they
+     * depend on the axis and the index of the map. Axial coordinates are
+     * independent of the storage and are more convenient for algorithms.
+     *
+     * @param coords The offset coordinates of the hexagon
+     * @returns The axial coordinates of the hexagon
+     *
+     * @sa convertAxialToOffset()
+     */
+    Vector2i convertOffsetToAxial(Vector2i coords) const noexcept;
+
+    /**
+     * @brief Convert axial coordinates to offset coordinates
+     *
+     * @param coords The axial coordinates of the hexagon
+     * @returns The offset coordinates of the hexagon
+     *
+     * @sa convertOffsetToAxial()
+     */
+    Vector2i convertAxialToOffset(Vector2i coords) const noexcept;
+
+    /**
+     * @brief Compute the distance between two hexagons
+     *
+     * The distance is the number of steps between the two hexagons.
+     *
+     * @param origin The offset coordinates of the first hexagon
+     * @param target The offset coordinates of the second hexagon
+     * @returns The distance between the two hexagons
+     */
+    int computeDistance(Vector2i origin, Vector2i target) const noexcept;
+
+    /**
+     * @brief Compute the six neighbors of a hexagon
+     *
+     * The neighbors may be outside the map, you have to check their validity.
+     *
+     * @param coords The offset coordinates of the hexagon
+     * @returns The offset coordinates of the six neighbors
+     */
+    std::array<Vector2i, 6> computeNeighbors(Vector2i coords) const noexcept;
+
+    /**
+     * @brief Get the six directions in axial coordinates
+     *
+     * The directions are in the same order as the neighbors returned by
+     * computeNeighbors(). Going around a ring of hexagons can be done by
+     * following these directions in order.
+     *
+     * @returns The six axial directions
+     */
+    static Span<const Vector2i> getAxialDirections() noexcept;
+
+    /**
+     * @brief Get the axis of the hexagons
+     */
+    MapCellAxis getAxis() const noexcept {
+      return m_axis;
+    }
+
+    /**
+     * @brief Get the index of the hexagons
+     */
+    MapCellIndex getIndex() const noexcept {
+      return m_index;
+    }
+
+    /** @} */
+
   private:
     MapCellAxis m_axis;
     MapCellIndex m_index;
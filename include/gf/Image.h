@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "CoreApi.h"
+#include "MemoryStats.h"
 #include "Path.h"
 #include "Span.h"
 #include "Vector.h"
@@ -256,6 +257,16 @@ inline namespace v1 {
      */
     const uint8_t* getPixelsPtr() const;
 
+    /**
+     * @brief Get a pointer to the array of pixels
+     *
+     * This function allows to fill the pixels of the image in bulk. The
+     * same warnings as the read-only version apply.
+     *
+     * @return Pointer to the array of pixels
+     */
+    uint8_t* getPixelsPtr();
+
     /**
      * @brief Flip the pixels horizontally
      *
@@ -265,7 +276,7 @@ inline namespace v1 {
 
   private:
     Vector2i m_size;
-    std::vector<uint8_t> m_pixels;
+    TrackedVector<uint8_t, MemoryTag::Images> m_pixels;
 
   };
 
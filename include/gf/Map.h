@@ -24,13 +24,20 @@
 #include "Array2D.h"
 #include "CoreApi.h"
 #include "Flags.h"
+#include "Hexagon.h"
+#include "MapCell.h"
 #include "Vector.h"
 
+#include <utility>
+#include <vector>
+
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
 
+  class SnapshotHistory;
+
   /**
    * @ingroup core_roguelike
    * @brief A property of a cell
@@ -316,8 +323,269 @@ inline namespace v1 {
      * @}
      */
 
+    /**
+     * @brief Track the cells of the map in a snapshot history
+     *
+     * @param history The snapshot history
+     */
+    void trackState(SnapshotHistory& history);
+
+  private:
+    Array2D<Flags<CellProperty>, int> m_cells;
+  };
+
+  /**
+   * @ingroup core_roguelike
+   * @brief A hexagonal map
+   *
+   * A hexagonal map is a model of map where cells are organized in a
+   * hexagonal grid. It provides the same services as gf::SquareMap: field of
+   * vision and route finding. In addition, it can compute a flow field
+   * towards a target, which is useful when many entities go to the same
+   * place.
+   *
+   * The cells are stored in offset coordinates (the same coordinates as
+   * gf::HexagonHelper and gf::HexagonGrid) so that the storage is compact.
+   * The algorithms work internally in axial coordinates.
+   *
+   * The map keeps the data needed by the route algorithms between calls, so
+   * that computing many routes on the same map does not allocate memory,
+   * except for the returned route.
+   *
+   * @sa gf::CellProperty, gf::SquareMap, gf::HexagonHelper
+   */
+  class GF_CORE_API HexagonMap {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param size The size of the map
+     * @param axis The orientation of hexagon cells. X for pointy and Y for flat
+     * @param index The index of data storage. Odd or Even indicate on which col or row is the offset
+     */
+    HexagonMap(Vector2i size, MapCellAxis axis, MapCellIndex index);
+
+    /**
+     * @brief Get the size of the map
+     *
+     * @returns The size of the map
+     */
+    Vector2i getSize() const;
+
+    /**
+     * @brief Get a range of the positions of the map
+     *
+     * @returns A 2D range of all the positions
+     *
+     * @sa Array2D::getPositionRange()
+     */
+    PositionRange<int> getRange() const;
+
+    /**
+     * @brief Get the hexagon helper associated to the map
+     *
+     * @returns A helper for computing coordinates in the map
+     */
+    const HexagonHelper& getHelper() const noexcept {
+      return m_helper;
+    }
+
+    /**
+     * @name Cell properties
+     * @{
+     */
+
+    /**
+     * @brief Set the properties of a cell
+     *
+     * @param pos The position of the cell
+     * @param flags The properties of the cell
+     *
+     * @sa setTransparent(), setWalkable(), setEmpty()
+     */
+    void setCell(Vector2i pos, Flags<CellProperty> flags);
+
+    /**
+     * @brief Initialize the cells with some properties
+     *
+     * @param flags The properties to set
+     */
+    void reset(Flags<CellProperty> flags);
+
+    /**
+     * @brief Make a cell transparent
+     *
+     * @param pos The position of the cell
+     * @param transparent The new transparent status of the cell
+     *
+     * @sa isTransparent()
+     */
+    void setTransparent(Vector2i pos, bool transparent = true);
+
+    /**
+     * @brief Check if a cell is transparent
+     *
+     * @returns True if the cell is transparent
+     *
+     * @sa setTransparent()
+     */
+    bool isTransparent(Vector2i pos) const;
+
+    /**
+     * @brief Make a cell walkable
+     *
+     * @param pos The position of the cell
+     * @param walkable The new walkable status of the cell
+     *
+     * @sa isWalkable()
+     */
+    void setWalkable(Vector2i pos, bool walkable = true);
+
+    /**
+     * @brief Check if a cell is walkable
+     *
+     * @sa setWalkable()
+     */
+    bool isWalkable(Vector2i pos) const;
+
+    /**
+     * @brief Make a cell empty
+     *
+     * An empty cell is walkable and transparent
+     *
+     * @param pos The position of the cell
+     */
+    void setEmpty(Vector2i pos);
+
+    /**
+     * @}
+     */
+
+    /**
+     * @name Field of Vision
+     * @{
+     */
+
+    /**
+     * @brief Make the whole map not visible
+     *
+     * @sa computeFieldOfVision()
+     */
+    void clearFieldOfVision();
+
+    /**
+     * @brief Make the whole map not explored
+     *
+     * @sa computeFieldOfVision()
+     */
+    void clearExplored();
+
+    /**
+     * @brief Compute a field of vision
+     *
+     * The field of vision is computed with a shadowcasting algorithm adapted
+     * to hexagons: the rings around the entity are visited in order and each
+     * opaque cell casts a shadow on the following rings. A transparent cell
+     * is visible if its center is not in a shadow. An opaque cell is visible
+     * if any part of it is not in a shadow.
+     *
+     * The map is not cleared before computing the field of vision. This
+     * algorithm marks visible cells as explored.
+     *
+     * @param pos The position of the entity
+     * @param maxRadius The maximum radius that the entity can see (0 means no limit)
+     * @param limit Is the limit included in the field of vision?
+     *
+     * @sa clearFieldOfVision(), isInFieldOfVision()
+     */
+    void computeFieldOfVision(Vector2i pos, int maxRadius = 0, FieldOfVisionLimit limit = FieldOfVisionLimit::Included);
+
+    /**
+     * @brief Compute a local field of vision
+     *
+     * This algorithm does not mark visible cells as explored.
+     *
+     * @param pos The position of the entity
+     * @param maxRadius The maximum radius that the entity can see (0 means no limit)
+     * @param limit Is the limit included in the field of vision?
+     *
+     * @sa clearFieldOfVision(), isInFieldOfVision()
+     */
+    void computeLocalFieldOfVision(Vector2i pos, int maxRadius = 0, FieldOfVisionLimit limit = FieldOfVisionLimit::Included);
+
+    /**
+     * @brief Check if a cell is visible
+     *
+     * @returns True if the cell is visible
+     *
+     * @sa computeFieldOfVision()
+     */
+    bool isInFieldOfVision(Vector2i pos) const;
+
+    /**
+     * @brief Check if a cell is explored
+     *
+     * @sa computeFieldOfVision(), isInFieldOfVision()
+     */
+    bool isExplored(Vector2i pos) const;
+
+    /**
+     * @}
+     */
+
+    /**
+     * @name Route
+     * @{
+     */
+
+    /**
+     * @brief Compute a route between two points
+     *
+     * The algorithm use the walkable property of the cells. Every step between
+     * two neighbor cells has a cost of 1.
+     *
+     * @param origin The origin of the route
+     * @param target The target of the route
+     * @param algorithm The algorithm to use for computing the route
+     * @returns The route between the two points (included) or if the route doesn't exist, it return an empty vector
+     */
+    std::vector<Vector2i> computeRoute(Vector2i origin, Vector2i target, Route algorithm = Route::AStar);
+
+    /**
+     * @brief Compute a flow field towards a target
+     *
+     * For each walkable cell that can reach the target, the flow field
+     * contains the next cell on a shortest route to the target. The target
+     * points to itself and the other cells contain @f$ (-1, -1) @f$.
+     *
+     * @param target The target of the flow field
+     * @returns The flow field
+     */
+    Array2D<Vector2i, int> computeFlowField(Vector2i target);
+
+    /**
+     * @}
+     */
+
+  private:
+    struct RouteNode {
+      float distance;
+      Vector2i previous;
+      uint32_t generation;
+      bool closed;
+    };
+
+    void prepareSearch();
+
   private:
+    HexagonHelper m_helper;
     Array2D<Flags<CellProperty>, int> m_cells;
+    // search context, kept between calls
+    uint32_t m_generation;
+    Array2D<RouteNode, int> m_nodes;
+    std::vector<std::pair<float, Vector2i>> m_heap;
+    std::vector<Vector2i> m_queue;
+    std::vector<std::pair<double, double>> m_shadows;
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
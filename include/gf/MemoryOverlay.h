@@ -0,0 +1,112 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_MEMORY_OVERLAY_H
+#define GF_MEMORY_OVERLAY_H
+
+#include "GraphicsApi.h"
+#include "Text.h"
+#include "Time.h"
+#include "Transformable.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  class Font;
+
+  /**
+   * @ingroup graphics_drawables
+   * @brief A debug overlay that shows the memory usage of the subsystems
+   *
+   * The overlay shows, for each gf::MemoryTag, the live bytes, the peak
+   * bytes and the number of allocations recorded by gf::MemoryStats.
+   * The text is rebuilt by update() at a fixed period, so that the
+   * overlay does not allocate at each frame. It is generally drawn in a
+   * screen view.
+   *
+   * @sa gf::MemoryStats
+   */
+  class GF_GRAPHICS_API MemoryOverlay : public Transformable {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param font The font to use
+     * @param characterSize The size of the characters
+     */
+    MemoryOverlay(Font& font, unsigned characterSize = 12);
+
+    /**
+     * @brief Set the period between two refreshes
+     *
+     * By default, the period is half a second.
+     *
+     * @param period The period
+     */
+    void setRefreshPeriod(Time period) {
+      m_period = period;
+    }
+
+    /**
+     * @brief Set the color of the text
+     *
+     * @param color The color
+     */
+    void setColor(const Color4f& color) {
+      m_text.setColor(color);
+    }
+
+    /**
+     * @brief Update the overlay
+     *
+     * @param time The time since the last update
+     */
+    void update(Time time);
+
+    /**
+     * @brief Rebuild the text now
+     */
+    void refresh();
+
+    /**
+     * @brief Get the local bounding rectangle of the overlay
+     *
+     * @return Local bounding rectangle of the overlay
+     */
+    RectF getLocalBounds() const {
+      return m_text.getLocalBounds();
+    }
+
+    virtual void draw(RenderTarget& target, const RenderStates& states) override;
+
+  private:
+    Text m_text;
+    Time m_period;
+    Time m_elapsed;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_MEMORY_OVERLAY_H
@@ -0,0 +1,289 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_MEMORY_STATS_H
+#define GF_MEMORY_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CoreApi.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_utilities
+   * @brief A subsystem that owns some memory
+   *
+   * The GPU tags are estimations computed from the sizes and the formats
+   * of the objects, the driver may use more memory.
+   *
+   * @sa gf::MemoryStats
+   */
+  enum class MemoryTag : int {
+    General,      ///< Memory that does not belong to a specific subsystem
+    Images,       ///< Pixels of gf::Image
+    Fonts,        ///< Glyph caches of gf::Font
+    Heightmaps,   ///< Data and scratch buffers of gf::Heightmap
+    Spatial,      ///< Nodes of the spatial indices
+    Geometry,     ///< Vertices of gf::VertexArray
+    GpuTextures,  ///< Textures on the GPU (estimation)
+    GpuBuffers,   ///< Vertex and index buffers on the GPU (estimation)
+  };
+
+  /**
+   * @ingroup core_utilities
+   * @brief The number of memory tags
+   */
+  constexpr std::size_t MemoryTagCount = 8;
+
+  /**
+   * @ingroup core_utilities
+   * @brief The memory usage of a subsystem
+   */
+  struct MemoryUsage {
+    std::size_t liveBytes = 0;        ///< The number of bytes currently allocated
+    std::size_t peakBytes = 0;        ///< The maximum number of bytes allocated at the same time
+    uint64_t allocationCount = 0;     ///< The number of allocations
+    uint64_t deallocationCount = 0;   ///< The number of deallocations
+  };
+
+  /**
+   * @ingroup core_utilities
+   * @brief Accounting of the memory owned by the subsystems
+   *
+   * The subsystems of gf record their allocations with a tag, either
+   * directly, with a gf::MemoryReservation, or with a
+   * gf::TrackedAllocator. The counters can be queried at any time, from
+   * any thread.
+   *
+   * @sa gf::MemoryTag, gf::MemoryUsage
+   */
+  class GF_CORE_API MemoryStats {
+  public:
+    /**
+     * @brief Deleted constructor
+     */
+    MemoryStats() = delete;
+
+    /**
+     * @brief Record an allocation
+     *
+     * @param tag The subsystem that owns the memory
+     * @param size The size of the allocation, in bytes
+     */
+    static void recordAllocation(MemoryTag tag, std::size_t size);
+
+    /**
+     * @brief Record a deallocation
+     *
+     * @param tag The subsystem that owned the memory
+     * @param size The size of the deallocation, in bytes
+     */
+    static void recordDeallocation(MemoryTag tag, std::size_t size);
+
+    /**
+     * @brief Get the memory usage of a subsystem
+     *
+     * @param tag The subsystem
+     */
+    static MemoryUsage getUsage(MemoryTag tag);
+
+    /**
+     * @brief Get the memory usage of all the subsystems
+     *
+     * The peak is the sum of the peaks of the subsystems.
+     */
+    static MemoryUsage getTotalUsage();
+
+    /**
+     * @brief Set the peaks to the current live sizes
+     */
+    static void resetPeaks();
+
+    /**
+     * @brief Get the name of a tag
+     *
+     * @param tag The subsystem
+     */
+    static const char *getTagName(MemoryTag tag);
+  };
+
+  /**
+   * @ingroup core_utilities
+   * @brief An amount of memory accounted to a subsystem
+   *
+   * This is useful for objects that do not allocate their memory
+   * directly, like GPU objects or containers that do not take an
+   * allocator. The size is recorded at construction and given back at
+   * destruction. A copy records the same size again.
+   *
+   * @sa gf::MemoryStats
+   */
+  class GF_CORE_API MemoryReservation {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param tag The subsystem that owns the memory
+     * @param size The initial size, in bytes
+     */
+    explicit MemoryReservation(MemoryTag tag, std::size_t size = 0);
+
+    /**
+     * @brief Copy constructor
+     */
+    MemoryReservation(const MemoryReservation& other);
+
+    /**
+     * @brief Move constructor
+     */
+    MemoryReservation(MemoryReservation&& other) noexcept;
+
+    /**
+     * @brief Copy assignment
+     */
+    MemoryReservation& operator=(const MemoryReservation& other);
+
+    /**
+     * @brief Move assignment
+     */
+    MemoryReservation& operator=(MemoryReservation&& other) noexcept;
+
+    /**
+     * @brief Destructor
+     */
+    ~MemoryReservation();
+
+    /**
+     * @brief Change the size
+     *
+     * @param size The new size, in bytes
+     */
+    void resize(std::size_t size);
+
+    /**
+     * @brief Get the size
+     */
+    std::size_t getSize() const {
+      return m_size;
+    }
+
+  private:
+    MemoryTag m_tag;
+    std::size_t m_size;
+  };
+
+  /**
+   * @ingroup core_utilities
+   * @brief A standard allocator that records its allocations
+   *
+   * @sa gf::MemoryStats, gf::TrackedVector
+   */
+  template<typename T, MemoryTag Tag>
+  class TrackedAllocator {
+  public:
+    /**
+     * @brief The type of the allocated objects
+     */
+    using value_type = T;
+
+    /**
+     * @brief The same allocator for another type
+     */
+    template<typename U>
+    struct rebind {
+      using other = TrackedAllocator<U, Tag>; ///< The other allocator
+    };
+
+    /**
+     * @brief Default constructor
+     */
+    TrackedAllocator() noexcept = default;
+
+    /**
+     * @brief Converting constructor
+     */
+    template<typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept
+    {
+    }
+
+    /**
+     * @brief Allocate memory for objects
+     *
+     * @param count The number of objects
+     */
+    T *allocate(std::size_t count) {
+      T *ptr = std::allocator<T>().allocate(count);
+      MemoryStats::recordAllocation(Tag, count * sizeof(T));
+      return ptr;
+    }
+
+    /**
+     * @brief Deallocate memory for objects
+     *
+     * @param ptr The pointer returned by allocate()
+     * @param count The number of objects
+     */
+    void deallocate(T *ptr, std::size_t count) noexcept {
+      MemoryStats::recordDeallocation(Tag, count * sizeof(T));
+      std::allocator<T>().deallocate(ptr, count);
+    }
+  };
+
+  /**
+   * @relates TrackedAllocator
+   * @brief Equality operator between two allocators
+   */
+  template<typename T, typename U, MemoryTag Tag>
+  constexpr
+  bool operator==(const TrackedAllocator<T, Tag>&, const TrackedAllocator<U, Tag>&) noexcept {
+    return true;
+  }
+
+  /**
+   * @relates TrackedAllocator
+   * @brief Inequality operator between two allocators
+   */
+  template<typename T, typename U, MemoryTag Tag>
+  constexpr
+  bool operator!=(const TrackedAllocator<T, Tag>&, const TrackedAllocator<U, Tag>&) noexcept {
+    return false;
+  }
+
+  /**
+   * @ingroup core_utilities
+   * @brief A vector whose memory is accounted to a subsystem
+   */
+  template<typename T, MemoryTag Tag>
+  using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_MEMORY_STATS_H
@@ -90,6 +90,28 @@ inline namespace v1 {
 
     double getValue(double x, double y) override;
 
+    /**
+     * @brief Get the step of the noise
+     *
+     * @returns The step used to interpolate between the lattice points
+     */
+    Step<double> getStep() const {
+      return m_step;
+    }
+
+    /**
+     * @brief Get the gradient at a lattice point
+     *
+     * The lattice repeats itself every 256 points in each direction.
+     *
+     * @param i The x coordinate of the lattice point
+     * @param j The y coordinate of the lattice point
+     * @returns The gradient at this lattice point
+     */
+    Vector2d getGradient(uint8_t i, uint8_t j) const {
+      return at(i, j);
+    }
+
   private:
     Step<double> m_step;
     std::array<uint8_t, 256> m_perm;
@@ -181,6 +203,41 @@ inline namespace v1 {
 
     double getValue(double x, double y) override;
 
+    /**
+     * @brief Get the scale factor
+     */
+    double getScale() const {
+      return m_scale;
+    }
+
+    /**
+     * @brief Get the number of octaves
+     */
+    std::size_t getOctaves() const {
+      return m_octaves;
+    }
+
+    /**
+     * @brief Get the factor applied to frequency
+     */
+    double getLacunarity() const {
+      return m_lacunarity;
+    }
+
+    /**
+     * @brief Get the factor applied to amplitude
+     */
+    double getPersistence() const {
+      return m_persistence;
+    }
+
+    /**
+     * @brief Get the contrast between the layers
+     */
+    double getDimension() const {
+      return m_dimension;
+    }
+
   private:
     Noise2D& m_noise;
     double m_scale;
@@ -247,6 +304,20 @@ inline namespace v1 {
 
     double getValue(double x, double y) override;
 
+    /**
+     * @brief Get the underlying gradient noise
+     */
+    const GradientNoise2D& getGradientNoise() const {
+      return m_gradient;
+    }
+
+    /**
+     * @brief Get the underlying fractal noise
+     */
+    const FractalNoise2D& getFractalNoise() const {
+      return m_fractal;
+    }
+
   private:
     GradientNoise2D m_gradient;
     FractalNoise2D m_fractal;
@@ -303,6 +374,19 @@ inline namespace v1 {
 
     double getValue(double x, double y) override;
 
+    /**
+     * @brief Get the gradient at a lattice point
+     *
+     * The lattice repeats itself every 256 points in each direction.
+     *
+     * @param i The x coordinate of the lattice point
+     * @param j The y coordinate of the lattice point
+     * @returns The gradient at this lattice point
+     */
+    Vector2d getGradient(uint8_t i, uint8_t j) const {
+      return at(i, j);
+    }
+
   private:
     std::array<uint8_t, 256> m_perm;
 
@@ -407,6 +491,31 @@ inline namespace v1 {
 
     double getValue(double x, double y) override;
 
+    /**
+     * @brief Get the distance function
+     */
+    Distance2<double> getDistance() const {
+      return m_distance;
+    }
+
+    /**
+     * @brief Get the coefficients for the noise
+     */
+    const std::vector<double>& getCoefficients() const {
+      return m_coeffs;
+    }
+
+    /**
+     * @brief Get the points of the noise
+     *
+     * The points are in @f$ [-1, 2)^2 @f$. Each random point in the unit
+     * square is repeated in the three closest neighbouring squares so that
+     * the noise tiles. The order of the points is unspecified.
+     */
+    const std::vector<Vector2d>& getCells() const {
+      return m_cells;
+    }
+
   private:
     std::size_t m_count;
     Distance2<double> m_distance;
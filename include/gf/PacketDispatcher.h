@@ -0,0 +1,229 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_PACKET_DISPATCHER_H
+#define GF_PACKET_DISPATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Id.h"
+#include "NetApi.h"
+#include "Packet.h"
+#include "Serialization.h"
+#include "SerializationOps.h"
+#include "Span.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup net_sockets
+   * @brief A dispatcher of packets to typed handlers
+   *
+   * A packet dispatcher maps the type of a packet (the `Id` written by
+   * gf::Packet::is()) to a handler. The header of the packet is parsed
+   * only once and the payload is deserialized in a message object that
+   * is allocated at registration and reused for every packet of this
+   * type, so that containers in the message keep their capacity.
+   *
+   * ~~~{.cc}
+   * struct Move {
+   *   static constexpr gf::Id type = "Move"_id;
+   *   int32_t x;
+   *   int32_t y;
+   * };
+   *
+   * template<typename Archive>
+   * Archive& operator|(Archive& ar, Move& data) {
+   *   return ar | data.x | data.y;
+   * }
+   *
+   * gf::PacketDispatcher dispatcher;
+   * dispatcher.registerHandler<Move>([](Move& move) {
+   *   // do something useful
+   * });
+   *
+   * gf::Packet packet;
+   * socket.recvPacket(packet);
+   * dispatcher.dispatch(packet);
+   * ~~~
+   *
+   * The message given to a handler is only valid until the next packet
+   * of the same type is dispatched. A handler may move out of it.
+   *
+   * @sa gf::Packet, gf::TcpServer
+   */
+  class GF_NET_API PacketDispatcher {
+  public:
+    /**
+     * @brief Constructor
+     */
+    PacketDispatcher();
+
+    /**
+     * @brief Deleted copy constructor
+     */
+    PacketDispatcher(const PacketDispatcher&) = delete;
+
+    /**
+     * @brief Deleted copy assignment
+     */
+    PacketDispatcher& operator=(const PacketDispatcher&) = delete;
+
+    /**
+     * @brief Move constructor
+     */
+    PacketDispatcher(PacketDispatcher&&) noexcept;
+
+    /**
+     * @brief Move assignment
+     */
+    PacketDispatcher& operator=(PacketDispatcher&&) noexcept;
+
+    /**
+     * @brief Destructor
+     */
+    ~PacketDispatcher();
+
+    /**
+     * @brief Register a handler for a type of message
+     *
+     * The handler is called with a reference to the reused message:
+     * `handler(T&)`. A previous handler for the same type is replaced.
+     *
+     * @param handler The handler
+     */
+    template<typename T, typename Func>
+    void registerHandler(Func handler) {
+      static_assert(T::type != InvalidId, "T must define its type");
+      registerHandler<T>(T::type, std::move(handler));
+    }
+
+    /**
+     * @brief Register a handler for a type of message with an explicit type
+     *
+     * This can be used when the same message structure is sent with
+     * different types.
+     *
+     * @param type The type of message
+     * @param handler The handler
+     */
+    template<typename T, typename Func>
+    void registerHandler(Id type, Func handler) {
+      static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+      insertSlot(type, std::unique_ptr<Slot>(new TypedSlot<T, Func>(std::move(handler))));
+    }
+
+    /**
+     * @brief Remove the handler of a type of message
+     *
+     * @param type The type of message
+     */
+    void unregisterHandler(Id type);
+
+    /**
+     * @brief Check if a type of message has a handler
+     *
+     * @param type The type of message
+     */
+    bool hasHandler(Id type) const;
+
+    /**
+     * @brief Dispatch a packet
+     *
+     * @param packet The packet
+     * @returns True if the packet was well-formed and a handler was found
+     */
+    bool dispatch(const Packet& packet) {
+      return dispatch(gf::span(packet.bytes.data(), packet.bytes.size()));
+    }
+
+    /**
+     * @brief Dispatch the bytes of a packet
+     *
+     * @param bytes The bytes of a packet, as in gf::Packet::bytes
+     * @returns True if the bytes were well-formed and a handler was found
+     */
+    bool dispatch(Span<const uint8_t> bytes);
+
+    /**
+     * @brief Dispatch all the packets in a receive buffer
+     *
+     * The buffer is a sequence of packets, each prefixed by its size as
+     * sent by gf::TcpSocket::sendPacket(). The dispatch stops at the first
+     * incomplete packet, so that the remaining bytes can be completed with
+     * the next receive.
+     *
+     * @param buffer The receive buffer
+     * @param dispatched If not null, the number of packets with a handler
+     * @returns The number of bytes consumed in the buffer
+     */
+    std::size_t dispatchBuffer(Span<const uint8_t> buffer, std::size_t *dispatched = nullptr);
+
+  private:
+    struct GF_NET_API Slot {
+      virtual ~Slot();
+      virtual void handle(Deserializer& deserializer) = 0;
+    };
+
+    template<typename T, typename Func>
+    struct TypedSlot : Slot {
+      TypedSlot(Func handler)
+      : handler(std::move(handler))
+      {
+      }
+
+      void handle(Deserializer& deserializer) override {
+        deserializer | message;
+        handler(message);
+      }
+
+      T message;
+      Func handler;
+    };
+
+    struct Entry {
+      Id type = InvalidId;
+      std::unique_ptr<Slot> slot;
+    };
+
+    void insertSlot(Id type, std::unique_ptr<Slot> slot);
+    Slot *findSlot(Id type) const;
+    std::size_t findIndex(Id type) const;
+    void rehash(std::size_t capacity);
+
+  private:
+    std::vector<Entry> m_entries;
+    std::size_t m_count;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_PACKET_DISPATCHER_H
@@ -0,0 +1,142 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_PIXEL_READBACK_H
+#define GF_PIXEL_READBACK_H
+
+#include "GraphicsApi.h"
+#include "GraphicsHandle.h"
+#include "Image.h"
+#include "Vector.h"
+#include "VertexBuffer.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  class RenderTexture;
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief An asynchronous read back of the pixels of a render texture
+   *
+   * gf::RenderTexture::capture() waits for the GPU to finish its work
+   * before copying the pixels. gf::PixelReadback splits the operation in
+   * two: the copy is requested in a pixel buffer on the GPU side, and the
+   * pixels are retrieved later, typically one frame after, when the copy
+   * is done.
+   *
+   * With OpenGL ES 2.0, pixel buffers are not available and the copy is
+   * done synchronously when the read back is requested.
+   *
+   * ~~~{.cc}
+   * gf::PixelReadback readback;
+   * readback.request(texture);
+   *
+   * // later
+   * if (readback.isReady()) {
+   *   gf::Image image = readback.retrieve();
+   * }
+   * ~~~
+   *
+   * @sa gf::RenderTexture::capture()
+   */
+  class GF_GRAPHICS_API PixelReadback {
+  public:
+    /**
+     * @brief Default constructor
+     */
+    PixelReadback();
+
+    /**
+     * @brief Destructor
+     */
+    ~PixelReadback();
+
+    /**
+     * @brief Deleted copy constructor
+     */
+    PixelReadback(const PixelReadback&) = delete;
+
+    /**
+     * @brief Deleted copy assignment
+     */
+    PixelReadback& operator=(const PixelReadback&) = delete;
+
+    /**
+     * @brief Request the pixels of a render texture
+     *
+     * The commands that were previously issued to the render texture must
+     * have been submitted. If a read back is already pending, it is
+     * discarded.
+     *
+     * @param texture The render texture to read
+     */
+    void request(RenderTexture& texture);
+
+    /**
+     * @brief Check if a read back has been requested and not retrieved
+     *
+     * @returns True if a read back is pending
+     */
+    bool isPending() const {
+      return m_pending;
+    }
+
+    /**
+     * @brief Check if the pixels are available
+     *
+     * This function does not block.
+     *
+     * @returns True if the pending read back can be retrieved without waiting
+     */
+    bool isReady();
+
+    /**
+     * @brief Retrieve the pixels
+     *
+     * If the copy is not finished yet, this function waits for it. The
+     * image has the same orientation as the one returned by
+     * gf::RenderTexture::capture().
+     *
+     * @returns An image with the pixels of the render texture
+     * @sa isReady()
+     */
+    Image retrieve();
+
+  private:
+    void discard();
+
+  private:
+    GraphicsHandle<GraphicsTag::Buffer> m_buffer;
+    void *m_fence;
+    Vector2i m_size;
+    std::size_t m_capacity;
+    bool m_pending;
+    Image m_image;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_PIXEL_READBACK_H
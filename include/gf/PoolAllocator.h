@@ -0,0 +1,401 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_POOL_ALLOCATOR_H
+#define GF_POOL_ALLOCATOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "MemoryStats.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_container
+   * @brief A null index in a pool allocator
+   *
+   * @sa gf::PoolAllocator
+   */
+  constexpr std::size_t NullIndex = static_cast<std::size_t>(-1);
+
+  /**
+   * @ingroup core_container
+   * @brief A paged allocator of objects referenced by an index
+   *
+   * The objects are stored in pages of `PageSize` objects that are never
+   * moved, so the address of an object stays valid until it is disposed,
+   * even if other objects are allocated in the meantime. In a page, the
+   * objects are contiguous and the free list is kept in a separate array,
+   * so that a traversal of the objects only touches the objects.
+   *
+   * The objects are constructed by allocate() and destroyed by dispose().
+   * clear() disposes all the objects at once but keeps the pages. When the
+   * allocator is destroyed, its pages are given to a cache in the current
+   * thread so that the next allocator of the same type in this thread can
+   * reuse them without asking the heap. The cache is freed when the thread
+   * exits; an allocator released after that (e.g. a static allocator
+   * destroyed at the end of the program) frees its pages directly.
+   *
+   * The pages owned by the allocator are accounted to the `Tag` subsystem
+   * in gf::MemoryStats, and so are the pages kept in the thread cache until
+   * they are freed.
+   *
+   * Accessing an object goes through the page table. If the addresses of
+   * the objects do not need to be stable, gf::BlockAllocator stores the
+   * objects contiguously and is faster for lookups.
+   *
+   * @sa gf::BlockAllocator, gf::NullIndex
+   */
+  template<typename T, std::size_t PageSize = 256, MemoryTag Tag = MemoryTag::General>
+  class PoolAllocator {
+    static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two.");
+  public:
+    /**
+     * @brief Default constructor
+     */
+    PoolAllocator()
+    : m_firstFreeIndex(NullIndex)
+    , m_allocated(0)
+    {
+    }
+
+    /**
+     * @brief Copy constructor
+     *
+     * @param other The allocator to copy
+     */
+    PoolAllocator(const PoolAllocator& other)
+    : m_firstFreeIndex(other.m_firstFreeIndex)
+    , m_allocated(0)
+    {
+      m_pages.reserve(other.m_pages.size());
+
+      try {
+        for (auto& otherPage : other.m_pages) {
+          m_pages.push_back(acquirePage());
+          Page& page = *m_pages.back();
+
+          for (std::size_t slot = 0; slot < PageSize; ++slot) {
+            if (otherPage->links[slot] == UsedIndex) {
+              page.links[slot] = NullIndex; // not marked as used until the object is built
+              new (page.getObject(slot)) T(*otherPage->getObject(slot));
+              ++m_allocated;
+            }
+
+            page.links[slot] = otherPage->links[slot];
+          }
+        }
+      } catch (...) {
+        release();
+        throw;
+      }
+    }
+
+    /**
+     * @brief Move constructor
+     *
+     * @param other The allocator to move
+     */
+    PoolAllocator(PoolAllocator&& other) noexcept
+    : m_pages(std::move(other.m_pages))
+    , m_firstFreeIndex(std::exchange(other.m_firstFreeIndex, NullIndex))
+    , m_allocated(std::exchange(other.m_allocated, 0))
+    {
+      other.m_pages.clear();
+    }
+
+    /**
+     * @brief Assignment operator
+     *
+     * @param other The allocator to assign
+     */
+    PoolAllocator& operator=(PoolAllocator other) noexcept {
+      std::swap(m_pages, other.m_pages);
+      std::swap(m_firstFreeIndex, other.m_firstFreeIndex);
+      std::swap(m_allocated, other.m_allocated);
+      return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~PoolAllocator() {
+      release();
+    }
+
+    /**
+     * @brief Allocate an object
+     *
+     * The object is value-initialized.
+     *
+     * @returns The index representing the object
+     */
+    std::size_t allocate() {
+      if (m_firstFreeIndex == NullIndex) {
+        addPage();
+      }
+
+      std::size_t index = m_firstFreeIndex;
+      Page& page = getPage(index);
+      std::size_t slot = index % PageSize;
+      assert(page.links[slot] != UsedIndex);
+
+      new (page.getObject(slot)) T();
+
+      m_firstFreeIndex = page.links[slot];
+      page.links[slot] = UsedIndex;
+      ++m_allocated;
+      return index;
+    }
+
+    /**
+     * @brief Deallocate the object at the given index
+     *
+     * After this function call, the index is not valid anymore.
+     *
+     * @param index A valid index
+     */
+    void dispose(std::size_t index) {
+      Page& page = getPage(index);
+      std::size_t slot = index % PageSize;
+      assert(page.links[slot] == UsedIndex);
+
+      page.getObject(slot)->~T();
+
+      page.links[slot] = m_firstFreeIndex;
+      m_firstFreeIndex = index;
+      --m_allocated;
+    }
+
+    /**
+     * @brief Access the object at a given index
+     *
+     * @param index A valid index
+     */
+    T& operator[](std::size_t index) {
+      Page& page = getPage(index);
+      assert(page.links[index % PageSize] == UsedIndex);
+      return *page.getObject(index % PageSize);
+    }
+
+    /**
+     * @brief Access the object at a given index
+     *
+     * @param index A valid index
+     */
+    const T& operator[](std::size_t index) const {
+      const Page& page = getPage(index);
+      assert(page.links[index % PageSize] == UsedIndex);
+      return *page.getObject(index % PageSize);
+    }
+
+    /**
+     * @brief Check if an index represents an allocated object
+     *
+     * @param index Any index
+     */
+    bool isAllocated(std::size_t index) const {
+      return index < getCapacity() && getPage(index).links[index % PageSize] == UsedIndex;
+    }
+
+    /**
+     * @brief Reserve space for some objects
+     *
+     * @param capacity The minimum number of objects that can be allocated without adding a page
+     */
+    void reserve(std::size_t capacity) {
+      while (getCapacity() < capacity) {
+        addPage();
+      }
+    }
+
+    /**
+     * @brief Remove all objects at once
+     *
+     * The pages are kept for the next allocations.
+     */
+    void clear() {
+      destroyObjects();
+
+      m_firstFreeIndex = NullIndex;
+
+      for (std::size_t i = m_pages.size(); i > 0; --i) {
+        linkPage(i - 1);
+      }
+
+      assert(m_allocated == 0);
+    }
+
+    /**
+     * @brief Remove all objects and give back the pages
+     */
+    void release() {
+      destroyObjects();
+
+      auto cache = getPageCache();
+
+      for (auto& page : m_pages) {
+        if (cache != nullptr && cache->size() < MaxCachedPages) {
+          cache->push_back(std::move(page));
+        } else {
+          MemoryStats::recordDeallocation(Tag, sizeof(Page));
+        }
+      }
+
+      m_pages.clear();
+      m_firstFreeIndex = NullIndex;
+    }
+
+    /**
+     * @brief Get the number of allocated objects
+     *
+     * @returns The number of allocated objects
+     */
+    std::size_t getAllocated() const {
+      return m_allocated;
+    }
+
+    /**
+     * @brief Get the number of objects that can be allocated without adding a page
+     */
+    std::size_t getCapacity() const {
+      return m_pages.size() * PageSize;
+    }
+
+  private:
+    static constexpr std::size_t UsedIndex = NullIndex - 1;
+    static constexpr std::size_t MaxCachedPages = 64;
+
+    struct Page {
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type objects[PageSize];
+      std::size_t links[PageSize];
+
+      T *getObject(std::size_t slot) {
+        return reinterpret_cast<T *>(&objects[slot]);
+      }
+
+      const T *getObject(std::size_t slot) const {
+        return reinterpret_cast<const T *>(&objects[slot]);
+      }
+    };
+
+    Page& getPage(std::size_t index) {
+      assert(index / PageSize < m_pages.size());
+      return *m_pages[index / PageSize];
+    }
+
+    const Page& getPage(std::size_t index) const {
+      assert(index / PageSize < m_pages.size());
+      return *m_pages[index / PageSize];
+    }
+
+    void addPage() {
+      m_pages.push_back(acquirePage());
+      linkPage(m_pages.size() - 1);
+    }
+
+    // put all the slots of a page in front of the free list, in order
+    void linkPage(std::size_t pageIndex) {
+      Page& page = *m_pages[pageIndex];
+      std::size_t base = pageIndex * PageSize;
+
+      for (std::size_t slot = 0; slot < PageSize - 1; ++slot) {
+        page.links[slot] = base + slot + 1;
+      }
+
+      page.links[PageSize - 1] = m_firstFreeIndex;
+      m_firstFreeIndex = base;
+    }
+
+    void destroyObjects() {
+      for (auto& page : m_pages) {
+        for (std::size_t slot = 0; slot < PageSize; ++slot) {
+          if (page->links[slot] == UsedIndex) {
+            page->getObject(slot)->~T();
+            page->links[slot] = NullIndex;
+          }
+        }
+      }
+
+      m_allocated = 0;
+    }
+
+    static std::unique_ptr<Page> acquirePage() {
+      auto cache = getPageCache();
+
+      if (cache == nullptr || cache->empty()) {
+        MemoryStats::recordAllocation(Tag, sizeof(Page));
+        return std::unique_ptr<Page>(new Page);
+      }
+
+      std::unique_ptr<Page> page = std::move(cache->back());
+      cache->pop_back();
+      return page;
+    }
+
+    struct PageCache {
+      ~PageCache() {
+        // the thread-local objects of the main thread are destroyed before
+        // the static objects, that may still release their pages
+        isPageCacheDestroyed() = true;
+
+        for (std::size_t i = 0; i < pages.size(); ++i) {
+          MemoryStats::recordDeallocation(Tag, sizeof(Page));
+        }
+      }
+
+      std::vector<std::unique_ptr<Page>> pages;
+    };
+
+    static bool& isPageCacheDestroyed() {
+      thread_local bool destroyed = false;
+      return destroyed;
+    }
+
+    static std::vector<std::unique_ptr<Page>> *getPageCache() {
+      if (isPageCacheDestroyed()) {
+        return nullptr;
+      }
+
+      thread_local PageCache cache;
+      return &cache.pages;
+    }
+
+  private:
+    std::vector<std::unique_ptr<Page>> m_pages;
+    std::size_t m_firstFreeIndex;
+    std::size_t m_allocated;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_POOL_ALLOCATOR_H
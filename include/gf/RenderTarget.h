@@ -71,6 +71,23 @@ inline namespace v1 {
     std::size_t offset; ///< Offset of the attribute in the vertex
   };
 
+  /**
+   * @ingroup graphics_renderers
+   * @brief Instance info
+   *
+   * The instances are given in an array of custom structures. Each
+   * attribute of the instances has the same value for all the vertices of
+   * an instance.
+   *
+   * @sa gf::RenderTarget::customDrawInstanced()
+   */
+  struct GF_GRAPHICS_API RenderInstanceInfo {
+    const void *data; ///< Pointer to the instances
+    std::size_t size; ///< The size of one instance
+    std::size_t count; ///< Number of instances
+    Span<const RenderAttributeInfo> attributes; ///< The attributes in the instances
+  };
+
   /**
    * @ingroup graphics_gpu
    * @brief Trait for framebuffer
@@ -272,6 +289,52 @@ inline namespace v1 {
      */
     void customDraw(const VertexBuffer& buffer, Span<const RenderAttributeInfo> attributes, const RenderStates& states = RenderStates());
 
+    /**
+     * @brief Draw several instances of primitives defined by an array of custom vertices
+     *
+     * The geometry is drawn once for each instance, with the attributes of
+     * the instance. If the hardware does not support instanced drawing, the
+     * instances are expanded on the CPU, which gives the same result.
+     *
+     * @param vertices Pointer to the vertices
+     * @param size The size of one vertex
+     * @param count Number of vertices in the array
+     * @param type Type of primitives to draw
+     * @param attributes The attributes in the vertices
+     * @param instances The instances
+     * @param states Render states to use for drawing
+     *
+     * @sa hasInstancingSupport()
+     */
+    void customDrawInstanced(const void *vertices, std::size_t size, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states = RenderStates());
+
+    /**
+     * @brief Draw several instances of primitives defined by an array of custom vertices and their indices
+     *
+     * @param vertices Pointer to the vertices
+     * @param size The size of one vertex
+     * @param indices Pointer to the indices
+     * @param count Number of indices in the array
+     * @param type Type of primitives to draw
+     * @param attributes The attributes in the vertices
+     * @param instances The instances
+     * @param states Render states to use for drawing
+     *
+     * @sa hasInstancingSupport()
+     */
+    void customDrawInstanced(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states = RenderStates());
+
+    /**
+     * @brief Check if instanced drawing is done by the hardware
+     *
+     * Instanced drawing is always available with OpenGL 3.3. With OpenGL
+     * ES 2.0, it needs the `ANGLE_instanced_arrays` or the
+     * `EXT_instanced_arrays` extension.
+     *
+     * @returns True if the instances are not expanded on the CPU
+     */
+    static bool hasInstancingSupport();
+
     /** @} */
 
     /**
@@ -455,7 +518,14 @@ inline namespace v1 {
       std::size_t count = 0;
     };
 
-    void drawStart(const RenderStates& states, Locations& locations, std::size_t size, Span<const RenderAttributeInfo> attributes);
+    void drawBuffer(const VertexBuffer& buffer, Span<const RenderAttributeInfo> attributes, const RenderStates& states, bool useVertexArray);
+    void drawInstances(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states);
+    void drawExpandedInstances(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states);
+
+    Shader& drawStart(const RenderStates& states);
+    void computeLocations(Shader& shader, Span<const RenderAttributeInfo> attributes, Locations& locations);
+    uint64_t computeLayout(const Locations& locations, std::size_t size, Span<const RenderAttributeInfo> attributes);
+    void enableAttributes(const Locations& locations, std::size_t size, Span<const RenderAttributeInfo> attributes);
     void drawFinish(const Locations& locations);
 
   private:
@@ -28,6 +28,7 @@
 #include <map>
 
 #include "GraphicsApi.h"
+#include "Id.h"
 #include "Matrix.h"
 #include "Path.h"
 #include "StringRef.h"
@@ -116,6 +117,12 @@ inline namespace v1 {
    * a big texture containing all the characters of the font in an
    * arbitrary order; thus, texture lookups on pixels other than the
    * current one may not give you the expected result.
+   *
+   * Compiling and linking shaders can take some time on some platforms. A
+   * directory can be set for a program binary cache with
+   * setBinaryCacheDirectory(). Then, the linked programs are saved in this
+   * directory and loaded back the next time a shader with the same sources
+   * is created, provided the driver is the same.
    */
   class GF_GRAPHICS_API Shader {
   public:
@@ -382,8 +389,64 @@ inline namespace v1 {
 
     static void bind(const Shader *shader);
 
+    /**
+     * @name Program binary cache
+     * @{
+     */
+
+    /**
+     * @brief Set the directory of the program binary cache
+     *
+     * When a directory is set and the platform supports it, the programs
+     * are saved in the directory after they are linked, and they are loaded
+     * from the directory instead of being compiled when a shader with the
+     * same sources is created. A binary is only loaded by the driver that
+     * created it.
+     *
+     * By default, there is no directory and the cache is disabled.
+     *
+     * @param directory The directory of the cache, or an empty path to disable the cache
+     * @sa hasBinaryCacheSupport()
+     */
+    static void setBinaryCacheDirectory(const Path& directory);
+
+    /**
+     * @brief Check if the program binary cache is supported
+     *
+     * The cache needs the `ARB_get_program_binary` extension with OpenGL
+     * 3.3 or the `OES_get_program_binary` extension with OpenGL ES 2.0, and
+     * at least one binary format.
+     *
+     * @returns True if the program binaries can be cached
+     */
+    static bool hasBinaryCacheSupport();
+
+    /**
+     * @brief Forget the shared programs of a context
+     *
+     * This function must be called before a context is destroyed. The
+     * shared programs are destroyed with the context, and the shaders that
+     * still use them do not try to delete them.
+     *
+     * This function is for internal use only.
+     *
+     * @param context The context that is going to be destroyed
+     */
+    static void releaseSharedPrograms(void *context);
+
+    /** @} */
+
   private:
     friend class RenderTarget;
+
+    enum Sharing {
+      Shared,
+    };
+
+    // the program is shared with the other shaders loaded with the same
+    // sources and this constructor, so the uniforms must be set before each use
+    Shader(const char *vertexShader, const char *fragmentShader, Sharing sharing);
+
     int getUniformLocation(StringRef name);
     int getAttributeLocation(StringRef name);
 
@@ -391,6 +454,7 @@ inline namespace v1 {
 
   private:
     unsigned m_program;
+    Id m_sharedKey;
 
     std::map<int, const BareTexture *> m_textures;
   };
@@ -299,6 +299,29 @@ inline namespace v1 {
      */
     VertexBuffer commitOutlineGeometry() const;
 
+    /**
+     * @brief Get the current geometry
+     *
+     * The vertices are in local coordinates.
+     *
+     * @return The vertices of the shape
+     */
+    const VertexArray& getGeometry() const noexcept {
+      return m_vertices;
+    }
+
+    /**
+     * @brief Get the current outline geometry
+     *
+     * The vertices are in local coordinates. The outline geometry is only
+     * relevant if the outline thickness is positive.
+     *
+     * @return The vertices of the outline of the shape
+     */
+    const VertexArray& getOutlineGeometry() const noexcept {
+      return m_outlineVertices;
+    }
+
     virtual void draw(RenderTarget& target, const RenderStates& states) override;
 
   protected:
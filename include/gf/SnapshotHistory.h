@@ -0,0 +1,202 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_SNAPSHOT_HISTORY_H
+#define GF_SNAPSHOT_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "Array2D.h"
+#include "CoreApi.h"
+#include "Span.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_serialization
+   * @brief A history of snapshots of a plain data state
+   *
+   * A snapshot history saves and restores the memory of some tracked
+   * objects: arrays (gf::Array2D, and the classes built on it like
+   * gf::SquareMap, gf::Heightmap or gf::TileLayer) and pools of plain
+   * objects (`std::vector`). It is meant for rollback, where the whole
+   * state of a simulation is saved at every tick.
+   *
+   * The memory of each object is cut in fixed-size pages. A snapshot is
+   * a table of pages that are shared with the previous snapshot when
+   * their content did not change. Saving only copies the pages that
+   * differ from the last snapshot, and restoring only writes the pages
+   * that differ from the current state.
+   *
+   * ~~~{.cc}
+   * gf::SnapshotHistory history(8);
+   * map.trackState(history); // gf::SquareMap
+   * history.track(bodies); // std::vector<Body>
+   *
+   * for (;;) {
+   *   simulate();
+   *   history.save();
+   *
+   *   if (mispredicted) {
+   *     history.restore(3); // back to 3 ticks ago
+   *   }
+   * }
+   * ~~~
+   *
+   * The tracked objects must be trivially copyable and they must outlive
+   * the history (or the history must be cleared). The size of an array
+   * must not change, while a pool may grow or shrink.
+   */
+  class GF_CORE_API SnapshotHistory {
+  public:
+    /**
+     * @brief The default size of a page
+     */
+    static constexpr std::size_t DefaultPageSize = 4096;
+
+    /**
+     * @brief Constructor
+     *
+     * @param capacity The maximum number of snapshots that are kept
+     * @param pageSize The size of a page in bytes
+     */
+    SnapshotHistory(std::size_t capacity, std::size_t pageSize = DefaultPageSize);
+
+    /**
+     * @brief Track an array
+     *
+     * @param array The array
+     */
+    template<typename T, typename I>
+    void track(Array2D<T, I>& array) {
+      static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+      addRegion(&array, [](void *object) {
+        auto array = static_cast<Array2D<T, I> *>(object);
+        return gf::span(reinterpret_cast<uint8_t *>(array->begin()), array->getDataSize() * sizeof(T));
+      }, nullptr);
+    }
+
+    /**
+     * @brief Track a pool of objects
+     *
+     * @param pool The pool
+     */
+    template<typename T>
+    void track(std::vector<T>& pool) {
+      static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+      addRegion(&pool, [](void *object) {
+        auto pool = static_cast<std::vector<T> *>(object);
+        return gf::span(reinterpret_cast<uint8_t *>(pool->data()), pool->size() * sizeof(T));
+      }, [](void *object, std::size_t size) {
+        static_cast<std::vector<T> *>(object)->resize(size / sizeof(T));
+      });
+    }
+
+    /**
+     * @brief Save a snapshot of the tracked objects
+     *
+     * If the history is full, the oldest snapshot is discarded.
+     *
+     * @returns The number of pages that have been copied
+     */
+    std::size_t save();
+
+    /**
+     * @brief Restore a snapshot in the tracked objects
+     *
+     * The snapshots that are more recent than the restored snapshot are
+     * discarded, so that the simulation can be saved again from there.
+     *
+     * @param back The number of snapshots to go back (0 is the last snapshot)
+     * @returns True if the snapshot exists and was restored
+     */
+    bool restore(std::size_t back = 0);
+
+    /**
+     * @brief Remove all the snapshots and all the tracked objects
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of snapshots
+     */
+    std::size_t getSnapshotCount() const {
+      return m_snapshots.size();
+    }
+
+    /**
+     * @brief Get the maximum number of snapshots
+     */
+    std::size_t getCapacity() const {
+      return m_capacity;
+    }
+
+    /**
+     * @brief Get the size of a page
+     */
+    std::size_t getPageSize() const {
+      return m_pageSize;
+    }
+
+  private:
+    using Access = Span<uint8_t> (*)(void *object);
+    using Resize = void (*)(void *object, std::size_t size);
+
+    struct Region {
+      void *object;
+      Access access;
+      Resize resize;
+    };
+
+    using Page = std::vector<uint8_t>;
+
+    struct RegionPages {
+      std::size_t size = 0;
+      std::vector<std::shared_ptr<Page>> pages;
+    };
+
+    using Snapshot = std::vector<RegionPages>;
+
+    void addRegion(void *object, Access access, Resize resize);
+    std::shared_ptr<Page> allocatePage();
+    void releaseSnapshot(Snapshot& snapshot);
+
+  private:
+    std::size_t m_capacity;
+    std::size_t m_pageSize;
+    std::vector<Region> m_regions;
+    std::deque<Snapshot> m_snapshots;
+    std::vector<std::shared_ptr<Page>> m_freePages;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_SNAPSHOT_HISTORY_H
@@ -24,6 +24,7 @@
 #include "SpatialTypes.h"
 
 #include "Spatial_DynamicTree.h"
+#include "Spatial_LooseQuadtree.h"
 #include "Spatial_Quadtree.h"
 #include "Spatial_RStarTree.h"
 #include "Spatial_SimpleSpatialIndex.h"
@@ -115,7 +115,7 @@ inline namespace v1 {
       }
     };
 
-    BlockAllocator<Node> m_nodes;
+    BlockAllocator<Node, MemoryTag::Spatial> m_nodes;
 
     std::size_t m_root;
   };
@@ -0,0 +1,176 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_SPATIAL_LOOSE_QUADTREE_H
+#define GF_SPATIAL_LOOSE_QUADTREE_H
+
+#include <cassert>
+#include <cstddef>
+
+#include "CoreApi.h"
+#include "Handle.h"
+#include "PoolAllocator.h"
+#include "Rect.h"
+#include "SpatialTypes.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_spatial
+   * @brief An implementation of loose quadtree
+   *
+   * In a loose quadtree, the bounds of a node are enlarged by half of
+   * their size in every direction. An object is stored in the deepest
+   * node whose cell contains its center and whose size is greater than the
+   * size of the object. So, contrary to gf::Quadtree, an object that
+   * straddles a split line goes down the tree like the others, only the
+   * big objects stay in the upper nodes.
+   *
+   * The entries of a node are stored inline in the node, up to 16 entries.
+   * When a leaf is full, it is subdivided. When it can not be subdivided,
+   * the additional entries are stored in overflow blocks chained to the
+   * node. When a subtree becomes sparse after removals, it is merged back
+   * into its root.
+   *
+   * Moving an object inside the loose bounds of its node does not modify
+   * the tree, which makes this structure well suited for many small
+   * moving objects.
+   *
+   * @sa gf::Quadtree
+   * @sa Thatcher Ulrich, *Loose Octrees*, Game Programming Gems (2000)
+   */
+  class GF_CORE_API LooseQuadtree {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param bounds The bounds of the world
+     */
+    LooseQuadtree(const RectF& bounds);
+
+    /**
+     * @brief Insert an object in the tree
+     *
+     * @param handle A handle that represents the object to insert
+     * @param bounds The bounds of the object
+     * @returns A spatial id
+     */
+    SpatialId insert(Handle handle, const RectF& bounds);
+
+    /**
+     * @brief Modify the bounds of an object
+     *
+     * @param id The spatial id of the object
+     * @param bounds The new bounds of the object
+     */
+    void modify(SpatialId id, RectF bounds);
+
+    /**
+     * @brief Query objects in the tree
+     *
+     * @param bounds The bounds of the query
+     * @param callback The callback to apply to found objects
+     * @param kind The kind of spatial query
+     * @returns The number of objects found
+     */
+    std::size_t query(const RectF& bounds, SpatialQueryCallback callback, SpatialQuery kind = SpatialQuery::Intersect);
+
+    /**
+     * @brief Remove an object from the tree
+     *
+     * @param id The spatial id of the object
+     */
+    void remove(SpatialId id);
+
+    /**
+     * @brief Remove all the objects from the tree
+     */
+    void clear();
+
+    /**
+     * @brief Get the handle associated to a spatial id
+     *
+     * @param id The spatial id of the object
+     */
+    Handle operator[](SpatialId id);
+
+  private:
+    static constexpr std::size_t Size = 16;
+    static constexpr std::size_t MaxDepth = 12;
+
+    struct Entry {
+      Handle handle;
+      RectF bounds;
+      std::size_t node;
+      std::size_t slot;
+    };
+
+    struct Overflow {
+      std::size_t entries[Size];
+      std::size_t next;
+    };
+
+    struct Node {
+      RectF bounds;
+      RectF looseBounds;
+      std::size_t parent;
+      std::size_t children[4];
+      std::size_t depth;
+      std::size_t total; // number of entries in the subtree
+      std::size_t count;
+      std::size_t entries[Size];
+      std::size_t overflow;
+
+      bool isLeaf() const {
+        return children[0] == NullIndex;
+      }
+    };
+
+    std::size_t allocateNode(const RectF& bounds, std::size_t parent, std::size_t depth);
+
+    std::size_t& getSlot(Node& node, std::size_t slot);
+    void pushEntry(std::size_t nodeIndex, std::size_t entryIndex);
+    void popEntry(std::size_t entryIndex);
+
+    void doInsert(std::size_t entryIndex);
+    void doRemove(std::size_t entryIndex);
+
+    std::size_t findChild(const Node& node, const RectF& bounds) const;
+    void subdivide(std::size_t nodeIndex);
+    void merge(std::size_t nodeIndex);
+    void collect(std::size_t nodeIndex, std::size_t targetIndex);
+
+  private:
+    RectF m_bounds;
+    PoolAllocator<Entry, 256, MemoryTag::Spatial> m_entries;
+    PoolAllocator<Node, 64, MemoryTag::Spatial> m_nodes;
+    PoolAllocator<Overflow, 64, MemoryTag::Spatial> m_overflows;
+    std::size_t m_root;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_SPATIAL_LOOSE_QUADTREE_H
@@ -24,9 +24,9 @@
 #include <cassert>
 #include <vector>
 
-#include "BlockAllocator.h"
 #include "CoreApi.h"
 #include "Handle.h"
+#include "PoolAllocator.h"
 #include "Rect.h"
 #include "SpatialTypes.h"
 
@@ -119,7 +119,7 @@ inline namespace v1 {
       std::size_t node;
     };
 
-    BlockAllocator<Entry> m_entries;
+    PoolAllocator<Entry, 256, MemoryTag::Spatial> m_entries;
 
     struct Node {
       RectF bounds;
@@ -132,7 +132,7 @@ inline namespace v1 {
       }
     };
 
-    BlockAllocator<Node> m_nodes;
+    PoolAllocator<Node, 256, MemoryTag::Spatial> m_nodes;
 
     std::size_t m_root;
   };
@@ -26,9 +26,9 @@
 
 #include <boost/container/static_vector.hpp>
 
-#include "BlockAllocator.h"
 #include "CoreApi.h"
 #include "Handle.h"
+#include "PoolAllocator.h"
 #include "Rect.h"
 #include "SpatialTypes.h"
 
@@ -148,7 +148,7 @@ inline namespace v1 {
       std::size_t node;
     };
 
-    BlockAllocator<Entry> m_entries;
+    PoolAllocator<Entry, 256, MemoryTag::Spatial> m_entries;
 
     struct Member {
       RectF bounds;
@@ -167,7 +167,7 @@ inline namespace v1 {
       boost::container::static_vector<Member, Size> members;
     };
 
-    BlockAllocator<Node> m_nodes;
+    PoolAllocator<Node, 256, MemoryTag::Spatial> m_nodes;
     std::size_t m_root;
   };
 
@@ -22,9 +22,14 @@
 #define GF_SPRITE_BATCH_H
 
 #include <cstddef>
+#include <cstdint>
 #include <array>
+#include <unordered_map>
+#include <vector>
 
 #include "GraphicsApi.h"
+#include "Id.h"
+#include "Rect.h"
 #include "RenderStates.h"
 #include "Vertex.h"
 
@@ -37,6 +42,17 @@ inline namespace v1 {
   class Sprite;
   class Texture;
 
+  /**
+   * @ingroup graphics_sprite
+   * @brief The order of the sprites in a sprite batch
+   *
+   * @sa gf::SpriteBatch
+   */
+  enum class SpriteSortMode {
+    Deferred, ///< The sprites are drawn in the order of submission
+    Depth,    ///< The sprites are sorted by depth, then by texture and render states
+  };
+
   /**
    * @ingroup graphics_sprite
    * @brief A sprite batch
@@ -57,6 +73,26 @@ inline namespace v1 {
    * batch.end();
    * ~~~
    *
+   * The sprites are only sent to the target in `end()`. The sprites that are
+   * entirely outside the view of the target at the time of `begin()` are
+   * discarded as soon as they are submitted.
+   *
+   * With gf::SpriteSortMode::Depth, each sprite has a depth and the sprites
+   * with a lower depth are drawn first, i.e. behind the others (painter's
+   * algorithm). The sprites with the same depth are grouped by texture and
+   * render states so that they can be drawn in the same call. The sort is
+   * a radix sort on compact records, not on the sprites themselves.
+   *
+   * ~~~{.cc}
+   * batch.begin(gf::SpriteSortMode::Depth);
+   *
+   * for (auto& entity : entities) {
+   *   batch.draw(entity.sprite, entity.position.y);
+   * }
+   *
+   * batch.end();
+   * ~~~
+   *
    * @sa gf::Sprite
    */
   class GF_GRAPHICS_API SpriteBatch {
@@ -70,8 +106,13 @@ inline namespace v1 {
 
     /**
      * @brief Begin the batch
+     *
+     * The view of the target is captured for culling, it must not change
+     * until `end()`.
+     *
+     * @param mode The order of the sprites
      */
-    void begin();
+    void begin(SpriteSortMode mode = SpriteSortMode::Deferred);
 
     /**
      * @brief Add a sprite to the batch
@@ -84,6 +125,17 @@ inline namespace v1 {
      */
     void draw(Sprite& sprite, const RenderStates& states = RenderStates());
 
+    /**
+     * @brief Add a sprite to the batch with a depth
+     *
+     * The depth is only used with gf::SpriteSortMode::Depth.
+     *
+     * @param sprite The sprite to draw
+     * @param depth The depth of the sprite
+     * @param states The render states
+     */
+    void draw(Sprite& sprite, float depth, const RenderStates& states = RenderStates());
+
     /**
      * @brief Add a raw texture to the batch
      *
@@ -111,11 +163,29 @@ inline namespace v1 {
 
     /**
      * @brief End the batch
+     *
+     * The sprites are sorted if needed and sent to the target.
      */
     void end();
 
+    /**
+     * @brief Get the number of sprites culled in the current batch
+     *
+     * @returns The number of sprites outside the view since `begin()`
+     */
+    std::size_t getCulledCount() const {
+      return m_culledCount;
+    }
+
   private:
-    void renderBatch();
+    struct SpriteRecord {
+      uint64_t key;
+      uint32_t sprite;
+      uint32_t states;
+    };
+
+    uint32_t findStates(const Texture& texture, const RenderStates& states);
+    void renderBatch(uint32_t states, std::size_t count);
 
   private:
     static constexpr std::size_t MaxSpriteCount = 1024;
@@ -123,8 +193,14 @@ inline namespace v1 {
     static constexpr std::size_t MaxVertexCount = MaxSpriteCount * VerticesPerSprite;
 
     RenderTarget& m_target;
-    RenderStates m_currentRenderStates;
-    std::size_t m_count;
+    SpriteSortMode m_mode;
+    RectF m_viewBounds;
+    std::size_t m_culledCount;
+    std::vector<RenderStates> m_states;
+    std::unordered_multimap<Id, uint32_t> m_statesIndex;
+    std::vector<Vertex> m_quads;
+    std::vector<SpriteRecord> m_records;
+    std::vector<SpriteRecord> m_sortBuffer;
     std::array<Vertex, MaxVertexCount> m_vertices;
   };
 
@@ -0,0 +1,161 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_SPSC_QUEUE_H
+#define GF_SPSC_QUEUE_H
+
+#include <cassert>
+#include <cstddef>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup core_system
+   * @brief A bounded lock-free queue for one producer and one consumer
+   *
+   * This queue is a ring buffer where exactly one thread pushes values and
+   * exactly one (other) thread polls them. Contrary to gf::Queue, it never
+   * takes a lock, and it never allocates after its construction. When the
+   * queue is full, push() fails and the producer has to try again later.
+   *
+   * The capacity is rounded up to the next power of two.
+   *
+   * @sa gf::Queue
+   */
+  template<typename T>
+  class SpscQueue {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity The minimum number of values the queue can hold
+     */
+    explicit SpscQueue(std::size_t capacity)
+    : m_head(0)
+    , m_tail(0)
+    {
+      std::size_t size = 2;
+
+      while (size < capacity + 1) {
+        size *= 2;
+      }
+
+      m_values.resize(size);
+      m_mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Get the capacity of the queue
+     */
+    std::size_t getCapacity() const {
+      return m_mask;
+    }
+
+    /**
+     * @brief Check if the queue is empty
+     *
+     * The result is only a hint if called from the producer thread.
+     */
+    bool isEmpty() const {
+      return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Push a value on the queue
+     *
+     * This function must only be called from the producer thread.
+     *
+     * @param value The value to push on the queue
+     * @returns False if the queue is full
+     */
+    bool push(const T& value) {
+      T copy(value);
+      return push(std::move(copy));
+    }
+
+    /**
+     * @brief Push a value on the queue
+     *
+     * This function must only be called from the producer thread. If the
+     * queue is full, the value is not moved.
+     *
+     * @param value The value to push on the queue
+     * @returns False if the queue is full
+     */
+    bool push(T&& value) {
+      std::size_t tail = m_tail.load(std::memory_order_relaxed);
+      std::size_t next = (tail + 1) & m_mask;
+
+      if (next == m_head.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      m_values[tail] = std::move(value);
+      m_tail.store(next, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @brief Poll a value from the queue, if possible
+     *
+     * This function must only be called from the consumer thread.
+     *
+     * @param value A reference for the result
+     * @return True if a value was poped from the queue
+     */
+    bool poll(T& value) {
+      std::size_t head = m_head.load(std::memory_order_relaxed);
+
+      if (head == m_tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      value = std::move(m_values[head]);
+      m_head.store((head + 1) & m_mask, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    static constexpr std::size_t CacheLineSize = 64;
+
+    // the indices are on their own cache line, to avoid false sharing between the producer and the consumer
+    std::atomic<std::size_t> m_head;
+    char m_headPadding[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> m_tail;
+    char m_tailPadding[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+    std::size_t m_mask;
+    std::vector<T> m_values;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_SPSC_QUEUE_H
@@ -23,7 +23,10 @@
 
 #include <cassert>
 #include <cstdarg>
+#include <cstddef>
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -65,6 +68,89 @@ inline namespace v1 {
    */
   GF_CORE_API std::string formatString(const char *fmt, va_list ap);
 
+  /**
+   * @ingroup core_strings
+   * @brief A reusable buffer to format strings without allocation
+   *
+   * The formatted string is written in a small inline buffer. If it does not
+   * fit, a buffer is allocated on the heap and kept for the next calls, so
+   * that a long-lived format buffer stops allocating after a few calls.
+   *
+   * The returned string is valid until the next call to format() or the
+   * destruction of the buffer. It is null-terminated.
+   *
+   * ~~~{.cc}
+   * gf::FormatBuffer buffer;
+   * gf::StringRef str = buffer.format("HP: %i/%i", hp, hpMax);
+   * ~~~
+   *
+   * @sa gf::formatString()
+   */
+  class GF_CORE_API FormatBuffer {
+  public:
+    /**
+     * @brief The size of the inline buffer
+     */
+    static constexpr std::size_t InlineSize = 256;
+
+    /**
+     * @brief Default constructor
+     */
+    FormatBuffer();
+
+    /**
+     * @brief Deleted copy constructor
+     */
+    FormatBuffer(const FormatBuffer&) = delete;
+
+    /**
+     * @brief Deleted copy assignment
+     */
+    FormatBuffer& operator=(const FormatBuffer&) = delete;
+
+    /**
+     * @brief Format a string like printf
+     *
+     * @param fmt The [format string](http://en.cppreference.com/w/cpp/io/c/fprintf)
+     * @returns A reference to the formatted string in the buffer
+     */
+    StringRef format(const char *fmt, ...) GF_FORMAT(2, 3);
+
+    /**
+     * @brief Format a string like vprintf
+     *
+     * @param fmt The [format string](http://en.cppreference.com/w/cpp/io/c/fprintf)
+     * @param ap The arguments of the format string
+     * @returns A reference to the formatted string in the buffer
+     */
+    StringRef format(const char *fmt, va_list ap);
+
+    /**
+     * @brief Get the last formatted string as a C string
+     *
+     * @returns A null-terminated string
+     */
+    const char *getData() const {
+      return m_data;
+    }
+
+    /**
+     * @brief Get the size of the last formatted string
+     *
+     * @returns The size of the string, without the null character
+     */
+    std::size_t getSize() const {
+      return m_size;
+    }
+
+  private:
+    char m_inline[InlineSize];
+    std::unique_ptr<char[]> m_heap;
+    char *m_data;
+    std::size_t m_capacity;
+    std::size_t m_size;
+  };
+
   /**
    * @ingroup core_strings
    * @brief Escape a string
@@ -78,6 +164,37 @@ inline namespace v1 {
    */
   GF_CORE_API std::string escapeString(StringRef str);
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  namespace details {
+
+    // the empty strings between consecutive separators are skipped
+    template<typename Allocator>
+    std::vector<StringRef, Allocator> splitString(StringRef str, StringRef separators, const Allocator& allocator) {
+      std::vector<StringRef, Allocator> out(allocator);
+      const char *begin = str.begin();
+
+      for (const char *it = str.begin(); it != str.end(); ++it) {
+        if (std::find(separators.begin(), separators.end(), *it) == separators.end()) {
+          continue;
+        }
+
+        if (it != begin) {
+          out.emplace_back(begin, it);
+        }
+
+        begin = it + 1;
+      }
+
+      if (begin != str.end()) {
+        out.emplace_back(begin, str.end());
+      }
+
+      return out;
+    }
+
+  }
+#endif
+
   /**
    * @ingroup core_strings
    * @brief Split a string in multiples paragraphs
@@ -89,6 +206,21 @@ inline namespace v1 {
    */
   GF_CORE_API std::vector<StringRef> splitInParagraphs(StringRef str);
 
+  /**
+   * @ingroup core_strings
+   * @brief Split a string in multiples paragraphs with an allocator
+   *
+   * The paragraphs are separated by '\\n'.
+   *
+   * @param str The input string
+   * @param allocator The allocator of the vector, e.g. a gf::FrameAllocator
+   * @returns A vector of strings containing the paragraphs
+   */
+  template<typename Allocator>
+  std::vector<StringRef, Allocator> splitInParagraphs(StringRef str, const Allocator& allocator) {
+    return details::splitString(str, "\n", allocator);
+  }
+
   /**
    * @ingroup core_strings
    * @brief Split a string in multiples words
@@ -100,6 +232,21 @@ inline namespace v1 {
    */
   GF_CORE_API std::vector<StringRef> splitInWords(StringRef str);
 
+  /**
+   * @ingroup core_strings
+   * @brief Split a string in multiples words with an allocator
+   *
+   * The words are separated by ' ' (space) or '\\t' (tabulation).
+   *
+   * @param str The input string
+   * @param allocator The allocator of the vector, e.g. a gf::FrameAllocator
+   * @returns A vector of strings containing the words
+   */
+  template<typename Allocator>
+  std::vector<StringRef, Allocator> splitInWords(StringRef str, const Allocator& allocator) {
+    return details::splitString(str, " \t", allocator);
+  }
+
 
   /**
    * @ingroup core_strings
@@ -23,12 +23,33 @@
 
 #include <string>
 
+#include "Flags.h"
 #include "NetApi.h"
 #include "Socket.h"
 #include "TcpSocket.h"
 
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup net_sockets
+   * @brief Hints for listener creation
+   */
+  enum class TcpListenerHints : uint32_t {
+    ReuseAddress  = 0x0001, ///< Can the address be bound again while old connections are still closing?
+    ReusePort     = 0x0002, ///< Can several listeners be bound on the same port? (not available everywhere)
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+
+template<>
+struct EnableBitmaskOperators<TcpListenerHints> {
+  static constexpr bool value = true;
+};
+
 inline namespace v1 {
 #endif
 
@@ -71,10 +92,17 @@ inline namespace v1 {
      * The service can be a port number (in a string) or a well-known name
      * (such as "http").
      *
+     * With the gf::TcpListenerHints::ReusePort hint, several listeners can
+     * be bound on the same port and the system balances the new connections
+     * between them. It is only available on systems that balance the
+     * connections of a shared port (`SO_REUSEPORT` on Linux,
+     * `SO_REUSEPORT_LB` on FreeBSD), see isReusePortSupported().
+     *
      * @param service The service associated to the listener
      * @param family The socket family of the listener
+     * @param hints The hints for the creation of the listener
      */
-    TcpListener(const std::string& service, SocketFamily family = SocketFamily::Unspec);
+    TcpListener(const std::string& service, SocketFamily family = SocketFamily::Unspec, Flags<TcpListenerHints> hints = None);
 
     /**
      * @brief Accept a new connection from a remote client
@@ -82,7 +110,8 @@ inline namespace v1 {
      * This member function blocks until a new connection arrives (unless the
      * socket was made non-blocking). Then a socket is created for the remote
      * client and returned. The returned socket can be used to communicate with
-     * the client.
+     * the client. If the listener is non-blocking and there is no pending
+     * connection, the returned socket is invalid.
      *
      * @returns A new socket representing the remote client
      */
@@ -103,6 +132,17 @@ inline namespace v1 {
      * @returns A new socket representing the remote client
      */
     TcpSocket accept(SocketAddress& address);
+
+    /**
+     * @brief Check if the system can share a port between listeners
+     *
+     * On some systems (e.g. macOS), a port can be shared but the connections
+     * are not balanced between the listeners. This function returns false on
+     * these systems.
+     *
+     * @returns True if gf::TcpListenerHints::ReusePort is supported
+     */
+    static bool isReusePortSupported();
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
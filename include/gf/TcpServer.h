@@ -0,0 +1,222 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#ifndef GF_TCP_SERVER_H
+#define GF_TCP_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NetApi.h"
+#include "Packet.h"
+#include "TcpListener.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  /**
+   * @ingroup net_sockets
+   * @brief The identifier of a connection in a gf::TcpServer
+   */
+  using TcpServerConnection = uint64_t;
+
+  /**
+   * @ingroup net_sockets
+   * @brief The type of a gf::TcpServerEvent
+   */
+  enum class TcpServerEventType {
+    Connected,    ///< A new client is connected
+    Received,     ///< A packet has been received from a client
+    Disconnected, ///< A client is disconnected
+  };
+
+  /**
+   * @ingroup net_sockets
+   * @brief An event from a gf::TcpServer
+   */
+  struct GF_NET_API TcpServerEvent {
+    TcpServerEventType type = TcpServerEventType::Connected; ///< The type of the event
+    TcpServerConnection connection = 0; ///< The connection of the event
+    Packet packet; ///< The received packet (only for TcpServerEventType::Received)
+  };
+
+  /**
+   * @ingroup net_sockets
+   * @brief Statistics of a worker of a gf::TcpServer
+   */
+  struct GF_NET_API TcpServerStats {
+    uint64_t accepted = 0;         ///< The number of accepted connections
+    uint64_t closed = 0;           ///< The number of closed connections
+    uint64_t packetsReceived = 0;  ///< The number of received packets
+    uint64_t packetsSent = 0;      ///< The number of packets completely sent to the clients
+    uint64_t bytesReceived = 0;    ///< The number of received bytes
+    uint64_t bytesSent = 0;        ///< The number of sent bytes
+  };
+
+  /**
+   * @ingroup net_sockets
+   * @brief The limits of the clients of a gf::TcpServer
+   *
+   * A client that exceeds one of the limits is disconnected.
+   */
+  struct GF_NET_API TcpServerLimits {
+    std::size_t maxPacketSize = 1024 * 1024; ///< The maximum size of a received packet
+    std::size_t maxPendingOutput = 4 * 1024 * 1024; ///< The maximum number of bytes waiting to be sent to a client
+  };
+
+  /**
+   * @ingroup net_sockets
+   * @brief A multi-threaded TCP server
+   *
+   * A gf::TcpServer spreads the connections of its clients over several
+   * worker threads. Each worker has its own event loop for the connections
+   * it owns. If the system balances the connections of a shared port (see
+   * gf::TcpListener::isReusePortSupported()), each worker has its own
+   * listener on the service. Otherwise, the workers share a single
+   * non-blocking listener and the first worker that wakes up accepts the
+   * new connection, so the connections are not guaranteed to be evenly
+   * spread.
+   *
+   * The workers communicate with the game logic through lock-free queues
+   * (see gf::SpscQueue). The game logic must run in a single thread: this
+   * thread polls the events with pollEvent() and answers with send().
+   *
+   * The packets are framed exactly like gf::TcpSocket::sendPacket() and
+   * gf::TcpSocket::recvPacket() so that the clients can use a simple
+   * gf::TcpSocket.
+   *
+   * The clients can not make the server allocate an unbounded amount of
+   * memory: a client that announces a packet larger than the limit, or
+   * that does not read its packets fast enough, is disconnected (see
+   * gf::TcpServerLimits).
+   *
+   * @sa gf::TcpListener, gf::TcpSocket, gf::SpscQueue
+   */
+  class GF_NET_API TcpServer {
+  public:
+    /**
+     * @brief Constructor
+     *
+     * The workers are started immediately.
+     *
+     * @param service The service associated to the server
+     * @param workerCount The number of workers, 0 for the number of cores
+     * @param family The socket family of the listeners
+     * @param limits The limits of the clients
+     */
+    TcpServer(const std::string& service, std::size_t workerCount = 0, SocketFamily family = SocketFamily::Unspec, const TcpServerLimits& limits = TcpServerLimits());
+
+    /**
+     * @brief Destructor
+     *
+     * The workers are stopped and all the connections are closed.
+     */
+    ~TcpServer();
+
+    TcpServer(const TcpServer&) = delete;
+    TcpServer& operator=(const TcpServer&) = delete;
+
+    /**
+     * @brief Check if the server is listening
+     */
+    explicit operator bool () const noexcept;
+
+    /**
+     * @brief Get the number of workers
+     */
+    std::size_t getWorkerCount() const {
+      return m_workers.size();
+    }
+
+    /**
+     * @brief Get the worker that owns a connection
+     *
+     * @param connection The connection
+     * @returns The index of the worker of the connection
+     */
+    static std::size_t getWorkerOf(TcpServerConnection connection) {
+      return static_cast<std::size_t>(connection >> 48);
+    }
+
+    /**
+     * @brief Poll an event from the workers, if possible
+     *
+     * The workers are polled in a round robin fashion so that no worker is
+     * starved.
+     *
+     * @param event A reference for the result
+     * @returns True if an event was polled
+     */
+    bool pollEvent(TcpServerEvent& event);
+
+    /**
+     * @brief Send a packet to a client
+     *
+     * The packet is transmitted to the worker that owns the connection, and
+     * sent as soon as possible.
+     *
+     * @param connection The connection of the client
+     * @param packet The packet to send
+     * @returns False if the queue of the worker is full, the call can be retried later
+     */
+    bool send(TcpServerConnection connection, Packet packet);
+
+    /**
+     * @brief Close the connection of a client
+     *
+     * A gf::TcpServerEventType::Disconnected event is generated when the
+     * connection is closed.
+     *
+     * @param connection The connection of the client
+     * @returns False if the queue of the worker is full, the call can be retried later
+     */
+    bool disconnect(TcpServerConnection connection);
+
+    /**
+     * @brief Get the statistics of a worker
+     *
+     * @param worker The index of the worker
+     */
+    TcpServerStats getStats(std::size_t worker) const;
+
+    /**
+     * @brief Get the statistics of all the workers
+     */
+    TcpServerStats getStats() const;
+
+  private:
+    struct Worker;
+
+    TcpListener m_sharedListener;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::size_t m_nextWorker;
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
+
+#endif // GF_TCP_SERVER_H
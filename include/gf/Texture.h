@@ -28,6 +28,7 @@
 
 #include "GraphicsApi.h"
 #include "GraphicsHandle.h"
+#include "MemoryStats.h"
 #include "Path.h"
 #include "Rect.h"
 #include "Span.h"
@@ -284,6 +285,7 @@ inline namespace v1 {
     bool m_smooth;
     bool m_repeated;
     bool m_mipmap;
+    MemoryReservation m_memory;
   };
 
 
@@ -36,6 +36,7 @@ namespace gf {
 inline namespace v1 {
 #endif
 
+  class SnapshotHistory;
   class Texture;
 
   /**
@@ -306,6 +307,16 @@ inline namespace v1 {
      */
     void clear();
 
+    /**
+     * @brief Track the tiles in a snapshot history
+     *
+     * The geometry is not part of the snapshot, it is computed again when
+     * the visible part of the layer changes.
+     *
+     * @param history The snapshot history
+     */
+    void trackState(SnapshotHistory& history);
+
     /** @} */
 
     /**
@@ -352,7 +363,8 @@ inline namespace v1 {
     };
 
   private:
-    void fillVertexArray(VertexArray& array, RectI rect) const;
+    static std::size_t computeVertexCapacity(RectI rect);
+    std::size_t fillVertices(Vertex *array, RectI rect) const;
     void updateGeometry();
 
   private:
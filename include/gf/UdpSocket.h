@@ -79,6 +79,19 @@ inline namespace v1 {
      */
     UdpSocket(const std::string& service, SocketFamily family = SocketFamily::Unspec);
 
+    /**
+     * @brief Full constructor
+     *
+     * It creates a UDP socket that is bound on a specific address and a
+     * specific port. For example, a socket bound on `"127.0.0.1"` can only be
+     * joined from the local host.
+     *
+     * @param hostname The bound address
+     * @param service The bound service, `"0"` to let the system choose the port
+     * @param family The prefered socket family
+     */
+    UdpSocket(const std::string& hostname, const std::string& service, SocketFamily family = SocketFamily::Unspec);
+
     /**
      * @brief Get a remote address for this socket
      *
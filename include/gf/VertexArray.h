@@ -29,6 +29,7 @@
 
 #include "Drawable.h"
 #include "GraphicsApi.h"
+#include "MemoryStats.h"
 #include "PrimitiveType.h"
 #include "Rect.h"
 #include "Vertex.h"
@@ -282,7 +283,7 @@ inline namespace v1 {
 
   private:
     PrimitiveType m_type;
-    std::vector<Vertex> m_vertices;
+    TrackedVector<Vertex, MemoryTag::Geometry> m_vertices;
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
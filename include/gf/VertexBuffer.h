@@ -23,9 +23,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "GraphicsApi.h"
 #include "GraphicsHandle.h"
+#include "MemoryStats.h"
 #include "PrimitiveType.h"
 
 namespace gf {
@@ -45,14 +47,41 @@ inline namespace v1 {
     static void del(int n, const unsigned* resources);
   };
 
+  /**
+   * @ingroup graphics_gpu
+   * @brief Trait for vertex array object
+   */
+  template<>
+  struct GF_GRAPHICS_API GraphicsTrait<GraphicsTag::VertexArray> {
+    static void gen(int n, unsigned* resources);
+    static void del(int n, const unsigned* resources);
+  };
+
+  /**
+   * @ingroup graphics_gpu
+   * @brief A hint about the usage of a vertex buffer
+   *
+   * The hint is given to the driver that can choose the best memory for the
+   * buffer.
+   *
+   * @sa gf::VertexBuffer
+   */
+  enum class VertexBufferUsage {
+    Static,   ///< The data is set once and drawn many times
+    Dynamic,  ///< The data is updated from time to time and drawn many times
+    Stream,   ///< The data is set once and drawn a few times
+  };
+
   /**
    * @ingroup graphics_gpu
    * @brief Data in the graphics memory
    *
    * A vertex buffer is a buffer that resides directly in the graphics memory.
    * The advantage is that the draw operations are faster than uploading data
-   * each time. The drawback is that the data must not change, i.e. data can
-   * be loaded only once.
+   * each time. The data can still be modified after the creation of the
+   * buffer: a range of vertices (or indices) can be updated in place, and the
+   * storage can be resized. A usage hint tells the driver how often the data
+   * is modified.
    *
    * In gf, a vertex buffer can be used directly. But the main usage is for
    * drawable entities that can upload the final geometry and give the
@@ -91,8 +120,9 @@ inline namespace v1 {
      * @param vertices Pointer to the vertices
      * @param count Number of vertices in the array
      * @param type Type of primitives to draw
+     * @param usage The usage hint of the buffer
      */
-    VertexBuffer(const Vertex *vertices, std::size_t count, PrimitiveType type);
+    VertexBuffer(const Vertex *vertices, std::size_t count, PrimitiveType type, VertexBufferUsage usage = VertexBufferUsage::Static);
 
     /**
      * @brief Load an array of vertices and their indices
@@ -101,8 +131,9 @@ inline namespace v1 {
      * @param indices Pointer to the indices
      * @param count Number of indices in the array
      * @param type Type of primitives to draw
+     * @param usage The usage hint of the buffer
      */
-    VertexBuffer(const Vertex *vertices, const uint16_t *indices, std::size_t count, PrimitiveType type);
+    VertexBuffer(const Vertex *vertices, const uint16_t *indices, std::size_t count, PrimitiveType type, VertexBufferUsage usage = VertexBufferUsage::Static);
 
     /**
      * @brief Load an array of custom vertices
@@ -111,8 +142,9 @@ inline namespace v1 {
      * @param size The size of one vertex
      * @param count Number of vertices in the array
      * @param type Type of primitives to draw
+     * @param usage The usage hint of the buffer
      */
-    VertexBuffer(const void *vertices, std::size_t size, std::size_t count, PrimitiveType type);
+    VertexBuffer(const void *vertices, std::size_t size, std::size_t count, PrimitiveType type, VertexBufferUsage usage = VertexBufferUsage::Static);
 
     /**
      * @brief Load an array of custom vertices and their indices
@@ -122,8 +154,9 @@ inline namespace v1 {
      * @param indices Pointer to the indices
      * @param count Number of indices in the array
      * @param type Type of primitives to draw
+     * @param usage The usage hint of the buffer
      */
-    VertexBuffer(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type);
+    VertexBuffer(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, VertexBufferUsage usage = VertexBufferUsage::Static);
 
     /**
      * @brief Check if there is an array buffer
@@ -178,6 +211,88 @@ inline namespace v1 {
       return m_type;
     }
 
+    /**
+     * @brief Get the usage hint of the buffer
+     *
+     * @returns The usage hint given in the constructor
+     */
+    VertexBufferUsage getUsage() const {
+      return m_usage;
+    }
+
+    /**
+     * @brief Get the number of vertices in the array buffer
+     *
+     * For a buffer without indices, it is the same as getCount().
+     *
+     * @returns The number of vertices in the buffer
+     */
+    std::size_t getVertexCount() const {
+      return m_vertexCount;
+    }
+
+    /**
+     * @brief Update a range of vertices
+     *
+     * The range must be inside the buffer. If the range covers the whole
+     * buffer, the previous storage is orphaned so that the update does not
+     * wait for the pending draw operations.
+     *
+     * @param offset The index of the first vertex to update
+     * @param vertices Pointer to the new vertices
+     * @param count Number of vertices to update
+     */
+    void update(std::size_t offset, const Vertex *vertices, std::size_t count);
+
+    /**
+     * @brief Update a range of custom vertices
+     *
+     * @param offset The index of the first vertex to update
+     * @param vertices Pointer to the new vertices, of the size of the buffer vertices
+     * @param count Number of vertices to update
+     *
+     * @sa getVertexSize()
+     */
+    void update(std::size_t offset, const void *vertices, std::size_t count);
+
+    /**
+     * @brief Update a range of indices
+     *
+     * The buffer must have an element array buffer and the range must be
+     * inside the buffer.
+     *
+     * @param offset The index of the first index to update
+     * @param indices Pointer to the new indices
+     * @param count Number of indices to update
+     */
+    void updateIndices(std::size_t offset, const uint16_t *indices, std::size_t count);
+
+    /**
+     * @brief Resize the array buffer
+     *
+     * The previous storage is orphaned and the content of the buffer is
+     * undefined until it is updated. For a buffer without indices, the count
+     * of the buffer is also changed.
+     *
+     * @param count The new number of vertices
+     *
+     * @sa update()
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Resize the element array buffer
+     *
+     * The buffer must have an element array buffer. The previous storage is
+     * orphaned and the content of the buffer is undefined until it is
+     * updated. The count of the buffer is changed.
+     *
+     * @param count The new number of indices
+     *
+     * @sa updateIndices()
+     */
+    void resizeIndices(std::size_t count);
+
     /**
      * @brief Binds a vertex buffer
      *
@@ -187,12 +302,88 @@ inline namespace v1 {
      */
     static void bind(const VertexBuffer *buffer);
 
+    /**
+     * @brief Check if vertex array objects are available
+     *
+     * Vertex array objects are always available with OpenGL 3.3 and they
+     * are available with the `OES_vertex_array_object` extension in
+     * OpenGL ES 2.0.
+     *
+     * This function is for internal use only.
+     *
+     * @returns True if vertex array objects can be used
+     */
+    static bool hasVertexArraySupport();
+
+    /**
+     * @brief Bind the vertex array object of an attribute layout
+     *
+     * The buffer keeps a vertex array object for each of the last
+     * attribute layouts and contexts it was drawn with. If there is no
+     * vertex array object for the layout in the current context, it is
+     * created with the buffers bound, and the caller must specify the
+     * attributes.
+     *
+     * This function is for internal use only.
+     *
+     * @param layout A key that identifies the attribute layout
+     * @returns True if the vertex array object has just been created
+     * @sa unbindVertexArray()
+     */
+    bool bindVertexArray(uint64_t layout) const;
+
+    /**
+     * @brief Bind the default vertex array object of the current context
+     *
+     * This function is for internal use only.
+     *
+     * @sa setDefaultVertexArray()
+     */
+    static void unbindVertexArray();
+
+    /**
+     * @brief Set the default vertex array object of the current context
+     *
+     * The default vertex array object is tracked per thread, as the
+     * current context. It must be set each time a context is made current
+     * on a thread.
+     *
+     * This function is for internal use only.
+     *
+     * @param name The default vertex array object, or 0 if none
+     */
+    static void setDefaultVertexArray(unsigned name);
+
+  private:
+    void updateMemory();
+
   private:
+    // a vertex array object is not shared between contexts, so it can only
+    // be used and deleted in the context where it was created
+    struct VertexArray {
+      VertexArray(uint64_t arrayLayout);
+      ~VertexArray();
+
+      VertexArray(const VertexArray&) = delete;
+      VertexArray& operator=(const VertexArray&) = delete;
+
+      VertexArray(VertexArray&& other) noexcept;
+      VertexArray& operator=(VertexArray&& other) noexcept;
+
+      uint64_t layout;
+      void *context;
+      unsigned name;
+    };
+
     GraphicsHandle<GraphicsTag::Buffer> m_vbo;
     GraphicsHandle<GraphicsTag::Buffer> m_ebo;
     std::size_t m_size;
     std::size_t m_count;
+    std::size_t m_vertexCount;
     PrimitiveType m_type;
+    VertexBufferUsage m_usage;
+    MemoryReservation m_memory;
+    mutable std::vector<VertexArray> m_arrays;
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
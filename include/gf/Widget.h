@@ -22,11 +22,16 @@
 #ifndef GF_WIDGET_H
 #define GF_WIDGET_H
 
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "GraphicsApi.h"
+#include "Matrix.h"
+#include "PrimitiveType.h"
 #include "Transformable.h"
 #include "Vector.h"
+#include "Vertex.h"
 
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -35,6 +40,93 @@ inline namespace v1 {
 
   struct RenderStates;
   class RenderTarget;
+  class BareTexture;
+  class VertexArray;
+  class Widget;
+
+  /**
+   * @ingroup graphics_widgets
+   * @brief A batch of widget geometries
+   *
+   * A widget batch gathers the geometries of many widgets in a single vertex
+   * stream. Consecutive geometries that share the same texture are drawn
+   * with a single draw call. The widgets that can not provide their geometry
+   * are drawn directly, in order.
+   *
+   * The batch is used by gf::WidgetContainer and is only rebuilt when a
+   * widget changes.
+   *
+   * @sa gf::Widget::batch(), gf::WidgetContainer
+   */
+  class GF_GRAPHICS_API WidgetBatch {
+  public:
+    /**
+     * @brief Remove all the geometries of the batch
+     */
+    void clear();
+
+    /**
+     * @brief Add a geometry to the batch
+     *
+     * The vertices are transformed and converted to triangles. Only
+     * triangle-based primitives (gf::PrimitiveType::Triangles,
+     * gf::PrimitiveType::TriangleStrip and gf::PrimitiveType::TriangleFan)
+     * are supported.
+     *
+     * @param vertices The vertices of the geometry
+     * @param count The number of vertices
+     * @param type The primitive type of the vertices
+     * @param texture The texture of the geometry (may be `nullptr`)
+     * @param transform The transform to apply to the vertices
+     * @returns True if the geometry has been added
+     */
+    bool addGeometry(const Vertex *vertices, std::size_t count, PrimitiveType type, const BareTexture *texture, const Matrix3f& transform);
+
+    /**
+     * @brief Add a geometry to the batch
+     *
+     * @param vertices The vertices of the geometry
+     * @param texture The texture of the geometry (may be `nullptr`)
+     * @param transform The transform to apply to the vertices
+     * @returns True if the geometry has been added
+     */
+    bool addGeometry(const VertexArray& vertices, const BareTexture *texture, const Matrix3f& transform);
+
+    /**
+     * @brief Add a widget that is drawn directly
+     *
+     * @param widget The widget
+     */
+    void addWidget(Widget& widget);
+
+    /**
+     * @brief Render the batch
+     *
+     * @param target The render target
+     * @param states The render states to use for drawing
+     */
+    void render(RenderTarget& target, const RenderStates& states);
+
+    /**
+     * @brief Get the number of draw commands in the batch
+     *
+     * @returns The number of draw commands
+     */
+    std::size_t getCommandCount() const noexcept {
+      return m_commands.size();
+    }
+
+  private:
+    struct Command {
+      const BareTexture *texture;
+      Widget *widget;
+      std::size_t first;
+      std::size_t count;
+    };
+
+    std::vector<Vertex> m_vertices;
+    std::vector<Command> m_commands;
+  };
 
   /**
    * @ingroup graphics_widgets
@@ -143,7 +235,45 @@ inline namespace v1 {
      */
     void triggerCallback();
 
+    /**
+     * @brief Add the geometry of the widget to a batch
+     *
+     * The default implementation adds the widget itself so that it is drawn
+     * directly with `draw()`. The predefined widgets override this function
+     * to add their geometry, so a widget derived from one of them that
+     * overrides `draw()` must also override this function, and call
+     * `Widget::batch()` to be drawn with its own `draw()`.
+     *
+     * @param batch The batch
+     * @sa gf::WidgetBatch
+     */
+    virtual void batch(WidgetBatch& batch);
+
+    /**
+     * @brief Get the version of the geometry
+     *
+     * The version changes each time the geometry of the widget changes, it is
+     * used by gf::WidgetContainer to know when a batch must be rebuilt.
+     *
+     * @returns The version of the geometry
+     */
+    uint32_t getGeometryVersion() const noexcept {
+      return m_geometryVersion;
+    }
+
   protected:
+    /**
+     * @brief Indicate that the geometry has changed
+     *
+     * Derived widgets must call this function each time their geometry is
+     * updated.
+     *
+     * @sa getGeometryVersion()
+     */
+    void invalidateGeometry() noexcept {
+      ++m_geometryVersion;
+    }
+
     /**
      * @brief Function called when the state changes
      */
@@ -159,6 +289,7 @@ inline namespace v1 {
   private:
     WidgetState m_state;
     std::function<void()> m_callback;
+    uint32_t m_geometryVersion;
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
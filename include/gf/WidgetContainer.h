@@ -24,16 +24,17 @@
 
 #include <vector>
 
+#include "BatchRecord.h"
 #include "GraphicsApi.h"
 #include "Ref.h"
 #include "RenderStates.h"
+#include "Widget.h"
 
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
 
-  class Widget;
   class RenderTarget;
 
   /**
@@ -54,6 +55,12 @@ inline namespace v1 {
      *
      * Widgets are rendered by the order they appears on the list.
      *
+     * The geometries of the widgets are gathered in a gf::WidgetBatch so
+     * that consecutive widgets with the same texture are drawn in a single
+     * draw call. The batch is kept between calls and is only rebuilt when a
+     * widget has changed (geometry, state or transform) or when the list of
+     * widgets has changed.
+     *
      * @param target The render target
      * @param states The render states to use for drawing
      * @sa gf::Entity::render()
@@ -111,10 +118,15 @@ inline namespace v1 {
 
     Widget& getCurrent();
 
+    bool isBatchOutdated() const;
+    void updateBatch();
+
   private:
     std::vector<Ref<Widget>> m_widgets;
     std::size_t m_selectedWidgetIndex;
     bool m_widgetIsSelected;
+    WidgetBatch m_batch;
+    BatchRecord m_batched;
   };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
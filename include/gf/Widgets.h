@@ -57,6 +57,8 @@ inline namespace v1 {
 
     void draw(RenderTarget &target, const RenderStates& states) override;
 
+    void batch(WidgetBatch& batch) override;
+
     bool contains(Vector2f coords) override;
 
 	  /**
@@ -262,7 +264,7 @@ inline namespace v1 {
   protected:
     void updateCurrentStateColors();
     void updateColors(Color4f textColor, Color4f outlineColor);
-    void updateGeometry();
+    virtual void updateGeometry();
 
     void onStateChanged() override;
 
@@ -304,6 +306,8 @@ inline namespace v1 {
 
     void draw(RenderTarget &target, const RenderStates& states) override;
 
+    void batch(WidgetBatch& batch) override;
+
     bool contains(Vector2f coords) override;
 
     /**
@@ -362,7 +366,7 @@ inline namespace v1 {
      */
     void setRadius(float radius) {
       m_radius = radius;
-      updateGeometry();
+      updateBackground();
     }
 
     /**
@@ -372,14 +376,17 @@ inline namespace v1 {
      */
     void setPadding(float padding) {
       m_padding = padding;
-      updateGeometry();
+      updateBackground();
     }
 
   protected:
-    void updateGeometry();
+    void updateGeometry() override;
 
     void onStateChanged() override;
 
+  private:
+    void updateBackground();
+
   private:
     gf::RoundedRectangleShape m_rect;
 
@@ -430,6 +437,8 @@ inline namespace v1 {
 
     void draw(RenderTarget &target, const RenderStates& states) override;
 
+    void batch(WidgetBatch& batch) override;
+
     bool contains(Vector2f coords) override;
 
     /**
@@ -544,6 +553,8 @@ inline namespace v1 {
 
     void draw(RenderTarget &target, const RenderStates& states) override;
 
+    void batch(WidgetBatch& batch) override;
+
     bool contains(Vector2f coords) override;
 
     /**
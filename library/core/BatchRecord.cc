@@ -0,0 +1,48 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/BatchRecord.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  void BatchRecord::clear() {
+    m_elements.clear();
+  }
+
+  void BatchRecord::add(uint32_t version, const Matrix3f& transform) {
+    m_elements.push_back({ version, transform });
+  }
+
+  bool BatchRecord::hasChanged(std::size_t index, uint32_t version, const Matrix3f& transform) const {
+    if (index >= m_elements.size()) {
+      return true;
+    }
+
+    const Element& element = m_elements[index];
+    return element.version != version || element.transform != transform;
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
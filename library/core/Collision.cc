@@ -22,6 +22,7 @@
 
 #include <cassert>
 
+#include <limits>
 #include <queue>
 
 #include <gf/Log.h>
@@ -483,6 +484,246 @@ inline namespace v1 {
     return collides(lhs, Transform(), rhs, Transform(), p);
   }
 
+  /*
+   * Time of impact
+   * Conservative advancement on the distance computed by GJK
+   */
+
+  static constexpr float ImpactTolerance = 0.01f;
+
+  namespace {
+
+    // a point or a convex polygon, with a radius
+    struct SweptCore {
+      const Polygon *polygon;
+      const Transform *transform;
+      Vector2f point;
+      float radius;
+
+      Vector2f getSupport(Vector2f direction, Vector2f offset) const {
+        if (polygon == nullptr) {
+          return point + offset;
+        }
+
+        return polygon->getSupport(direction, *transform) + offset;
+      }
+    };
+
+    SweptCore makeCore(const CircF& circle, const Transform& transform) {
+      return SweptCore{ nullptr, &transform, gf::transform(transform, circle.getCenter()), circle.getRadius() };
+    }
+
+    SweptCore makeCore(const Polygon& polygon, const Transform& transform) {
+      return SweptCore{ &polygon, &transform, gf::vec(0.0f, 0.0f), 0.0f };
+    }
+
+    Vector2f getSweptSupport(const SweptCore& lhs, Vector2f lhsOffset, const SweptCore& rhs, Vector2f rhsOffset, Vector2f direction) {
+      return lhs.getSupport(direction, lhsOffset) - rhs.getSupport(-direction, rhsOffset);
+    }
+
+    // closest point to the origin on the segment [a, b], the segment is reduced to the useful points
+    Vector2f getClosestOnSegment(Vector2f *v, unsigned& size) {
+      Vector2f ab = v[1] - v[0];
+      float length = gf::squareLength(ab);
+
+      if (length > 0.0f) {
+        float t = - gf::dot(v[0], ab) / length;
+
+        if (t > 0.0f && t < 1.0f) {
+          return v[0] + t * ab;
+        }
+
+        if (t >= 1.0f) {
+          v[0] = v[1];
+        }
+      }
+
+      size = 1;
+      return v[0];
+    }
+
+    // returns false if the origin is in the simplex
+    bool reduceSweptSimplex(Vector2f *v, unsigned& size, Vector2f& closest) {
+      if (size == 1) {
+        closest = v[0];
+        return true;
+      }
+
+      if (size == 2) {
+        closest = getClosestOnSegment(v, size);
+        return true;
+      }
+
+      assert(size == 3);
+
+      float c0 = gf::cross(v[1] - v[0], -v[0]);
+      float c1 = gf::cross(v[2] - v[1], -v[1]);
+      float c2 = gf::cross(v[0] - v[2], -v[2]);
+
+      if ((c0 >= 0.0f && c1 >= 0.0f && c2 >= 0.0f) || (c0 <= 0.0f && c1 <= 0.0f && c2 <= 0.0f)) {
+        return false;
+      }
+
+      // keep the closest edge of the triangle
+      float bestDistance = std::numeric_limits<float>::max();
+      Vector2f best[2];
+      unsigned bestSize = 0;
+
+      for (unsigned i = 0; i < 3; ++i) {
+        Vector2f edge[2] = { v[i], v[(i + 1) % 3] };
+        unsigned edgeSize = 2;
+        Vector2f point = getClosestOnSegment(edge, edgeSize);
+        float distance = gf::squareLength(point);
+
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best[0] = edge[0];
+          best[1] = edge[1];
+          bestSize = edgeSize;
+          closest = point;
+        }
+      }
+
+      v[0] = best[0];
+      v[1] = best[1];
+      size = bestSize;
+      return true;
+    }
+
+    // distance between the cores (without the radius), closest is the closest point of the Minkowski difference
+    float computeSweptDistance(const SweptCore& lhs, Vector2f lhsOffset, const SweptCore& rhs, Vector2f rhsOffset, Vector2f& closest) {
+      Vector2f v[3];
+      unsigned size = 1;
+      v[0] = getSweptSupport(lhs, lhsOffset, rhs, rhsOffset, gf::vec(1.0f, 0.0f));
+      closest = v[0];
+
+      for (unsigned i = 0; i < MaxIterations; ++i) {
+        float length = gf::squareLength(closest);
+
+        if (length < ImpactTolerance * ImpactTolerance) {
+          return 0.0f;
+        }
+
+        Vector2f w = getSweptSupport(lhs, lhsOffset, rhs, rhsOffset, -closest);
+
+        if (length - gf::dot(closest, w) <= 1e-5f * length) {
+          break; // no progress
+        }
+
+        v[size++] = w;
+
+        if (!reduceSweptSimplex(v, size, closest)) {
+          return 0.0f;
+        }
+      }
+
+      return gf::euclideanLength(closest);
+    }
+
+    bool computeSweptImpact(const SweptCore& lhs, Vector2f lhsMotion, const SweptCore& rhs, Vector2f rhsMotion, Impact& impact) {
+      Vector2f motion = lhsMotion - rhsMotion;
+      float radius = lhs.radius + rhs.radius;
+      float t = 0.0f;
+
+      for (unsigned i = 0; i < MaxIterations; ++i) {
+        Vector2f closest;
+        float distance = computeSweptDistance(lhs, t * lhsMotion, rhs, t * rhsMotion, closest);
+        Vector2f normal;
+
+        if (distance > 0.0f) {
+          normal = - closest / distance;
+        } else if (gf::squareLength(motion) > 0.0f) {
+          normal = gf::normalize(motion);
+        } else {
+          normal = gf::vec(0.0f, 0.0f);
+        }
+
+        float gap = distance - radius;
+
+        if (gap <= ImpactTolerance) {
+          impact.time = t;
+          impact.normal = normal;
+          return true;
+        }
+
+        float speed = gf::dot(motion, normal);
+
+        if (speed <= 0.0f) {
+          return false; // the distance can not decrease anymore
+        }
+
+        t += gap / speed;
+
+        if (t > 1.0f) {
+          return false;
+        }
+      }
+
+      Vector2f closest;
+      computeSweptDistance(lhs, t * lhsMotion, rhs, t * rhsMotion, closest);
+      impact.time = t;
+      impact.normal = gf::squareLength(closest) > 0.0f ? gf::normalize(-closest) : gf::vec(0.0f, 0.0f);
+      return true;
+    }
+
+  } // anonymous namespace
+
+  bool timeOfImpact(const CircF& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const CircF& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact) {
+    // analytic solution: |(rhsCenter - lhsCenter) - t * motion| = radius
+    Vector2f offset = gf::transform(rhsTrans, rhs.getCenter()) - gf::transform(lhsTrans, lhs.getCenter());
+    Vector2f motion = lhsMotion - rhsMotion;
+    float radius = lhs.getRadius() + rhs.getRadius();
+
+    float c = gf::squareLength(offset) - gf::square(radius);
+
+    if (c <= 0.0f) {
+      impact.time = 0.0f;
+      impact.normal = gf::squareLength(offset) > 0.0f ? gf::normalize(offset) : gf::vec(0.0f, 0.0f);
+      return true;
+    }
+
+    float a = gf::squareLength(motion);
+
+    if (a == 0.0f) {
+      return false;
+    }
+
+    float b = gf::dot(offset, motion);
+    float discriminant = b * b - a * c;
+
+    if (b <= 0.0f || discriminant < 0.0f) {
+      return false;
+    }
+
+    float t = (b - std::sqrt(discriminant)) / a;
+
+    if (t > 1.0f) {
+      return false;
+    }
+
+    impact.time = t;
+    impact.normal = gf::normalize(offset - t * motion);
+    return true;
+  }
+
+  bool timeOfImpact(const CircF& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const Polygon& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact) {
+    return computeSweptImpact(makeCore(lhs, lhsTrans), lhsMotion, makeCore(rhs, rhsTrans), rhsMotion, impact);
+  }
+
+  bool timeOfImpact(const Polygon& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const CircF& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact) {
+    return computeSweptImpact(makeCore(lhs, lhsTrans), lhsMotion, makeCore(rhs, rhsTrans), rhsMotion, impact);
+  }
+
+  bool timeOfImpact(const Polygon& lhs, const Transform& lhsTrans, Vector2f lhsMotion, const Polygon& rhs, const Transform& rhsTrans, Vector2f rhsMotion, Impact& impact) {
+    return computeSweptImpact(makeCore(lhs, lhsTrans), lhsMotion, makeCore(rhs, rhsTrans), rhsMotion, impact);
+  }
+
+  RectF computeSweptBounds(const RectF& bounds, Vector2f motion) {
+    RectF swept = bounds;
+    swept.extend(RectF::fromMinMax(bounds.min + motion, bounds.max + motion));
+    return swept;
+  }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
@@ -0,0 +1,463 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/CollisionWorld.h>
+
+#include <cassert>
+
+#include <algorithm>
+#include <utility>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    void removeIndex(std::vector<std::size_t>& indices, std::size_t index) {
+      indices.erase(std::remove(indices.begin(), indices.end(), index), indices.end());
+    }
+
+    bool isAxisAligned(const Transform& transform) {
+      return transform.rotation.sin == 0.0f && transform.rotation.cos > 0.0f;
+    }
+
+  }
+
+  CollisionWorld::CollisionWorld(float margin)
+  : m_margin(margin)
+  , m_sleepingEnabled(true)
+  , m_sleepDelay(milliseconds(500))
+  , m_narrowPhaseCount(0)
+  {
+  }
+
+  CollisionBodyId CollisionWorld::addCircle(Handle handle, const CircF& circle, const Transform& transform, CollisionBodyType type) {
+    Body body;
+    body.handle = handle;
+    body.type = type;
+    body.shape = ShapeType::Circle;
+    body.circle = circle;
+    body.transform = transform;
+    return addBody(std::move(body));
+  }
+
+  CollisionBodyId CollisionWorld::addRectangle(Handle handle, const RectF& rectangle, const Transform& transform, CollisionBodyType type) {
+    Body body;
+    body.handle = handle;
+    body.type = type;
+    body.shape = ShapeType::Rectangle;
+    body.rectangle = rectangle;
+
+    // used when the rectangle is rotated
+    Vector2f corners[4] = {
+      rectangle.getTopLeft(),
+      rectangle.getTopRight(),
+      rectangle.getBottomRight(),
+      rectangle.getBottomLeft()
+    };
+
+    body.polygon = Polygon(corners);
+    body.transform = transform;
+    return addBody(std::move(body));
+  }
+
+  CollisionBodyId CollisionWorld::addPolygon(Handle handle, const Polygon& polygon, const Transform& transform, CollisionBodyType type) {
+    Body body;
+    body.handle = handle;
+    body.type = type;
+    body.shape = ShapeType::Polygon;
+    body.polygon = polygon;
+    body.transform = transform;
+    return addBody(std::move(body));
+  }
+
+  CollisionBodyId CollisionWorld::addBody(Body body) {
+    std::size_t index = m_bodies.allocate();
+    Body& stored = m_bodies[index];
+    stored = std::move(body);
+    stored.fatBounds = computeBounds(stored).grow(m_margin);
+    stored.proxy = m_tree.insert(Handle(static_cast<Id>(index)), stored.fatBounds);
+
+    m_proxyMoves.push_back(index);
+    touchBody(index);
+    return static_cast<CollisionBodyId>(index);
+  }
+
+  void CollisionWorld::removeBody(CollisionBodyId id) {
+    std::size_t index = static_cast<std::size_t>(id);
+    Body& body = m_bodies[index];
+
+    // the fat bounds may have moved since the last update, so the pairs
+    // of the body are not necessarily found by a query in the tree
+
+    for (auto it = m_pairs.begin(); it != m_pairs.end(); ) {
+      std::size_t lhsIndex = static_cast<std::size_t>(it->first >> 32);
+      std::size_t rhsIndex = static_cast<std::size_t>(it->first & UINT64_C(0xFFFFFFFF));
+
+      if (lhsIndex != index && rhsIndex != index) {
+        ++it;
+        continue;
+      }
+
+      if (it->second.touching) {
+        m_pendingEvents.push_back({ CollisionEventType::End, static_cast<CollisionBodyId>(lhsIndex), static_cast<CollisionBodyId>(rhsIndex), m_bodies[lhsIndex].handle, m_bodies[rhsIndex].handle, it->second.penetration });
+      }
+
+      it = m_pairs.erase(it);
+    }
+
+    m_tree.remove(body.proxy);
+    removeIndex(m_movedBodies, index);
+    removeIndex(m_awakeBodies, index);
+    removeIndex(m_proxyMoves, index);
+    m_bodies.dispose(index);
+  }
+
+  void CollisionWorld::clear() {
+    m_bodies.clear();
+    m_tree.clear();
+    m_pairs.clear();
+    m_movedBodies.clear();
+    m_awakeBodies.clear();
+    m_proxyMoves.clear();
+    m_pendingEvents.clear();
+  }
+
+  void CollisionWorld::setTransform(CollisionBodyId id, const Transform& transform) {
+    std::size_t index = static_cast<std::size_t>(id);
+    Body& body = m_bodies[index];
+    body.transform = transform;
+
+    RectF bounds = computeBounds(body);
+
+    if (!body.fatBounds.contains(bounds)) {
+      body.fatBounds = bounds.grow(m_margin);
+      m_tree.modify(body.proxy, body.fatBounds);
+
+      if (std::find(m_proxyMoves.begin(), m_proxyMoves.end(), index) == m_proxyMoves.end()) {
+        m_proxyMoves.push_back(index);
+      }
+    }
+
+    touchBody(index);
+  }
+
+  const Transform& CollisionWorld::getTransform(CollisionBodyId id) const {
+    return m_bodies[static_cast<std::size_t>(id)].transform;
+  }
+
+  Handle CollisionWorld::getHandle(CollisionBodyId id) const {
+    return m_bodies[static_cast<std::size_t>(id)].handle;
+  }
+
+  RectF CollisionWorld::getBounds(CollisionBodyId id) const {
+    return computeBounds(m_bodies[static_cast<std::size_t>(id)]);
+  }
+
+  void CollisionWorld::wake(CollisionBodyId id) {
+    std::size_t index = static_cast<std::size_t>(id);
+    Body& body = m_bodies[index];
+
+    if (body.type == CollisionBodyType::Static) {
+      return;
+    }
+
+    body.stillTime = Time::zero();
+
+    if (!body.awake) {
+      body.awake = true;
+      m_awakeBodies.push_back(index);
+    }
+  }
+
+  bool CollisionWorld::isAwake(CollisionBodyId id) const {
+    return m_bodies[static_cast<std::size_t>(id)].awake;
+  }
+
+  void CollisionWorld::setSleepingEnabled(bool enabled) {
+    m_sleepingEnabled = enabled;
+
+    if (!enabled) {
+      return;
+    }
+
+    for (std::size_t index : m_awakeBodies) {
+      m_bodies[index].stillTime = Time::zero();
+    }
+  }
+
+  void CollisionWorld::update(Time time, CollisionEventCallback callback) {
+    // contacts of the bodies removed since the last update
+
+    for (auto& event : m_pendingEvents) {
+      callback(event);
+    }
+
+    m_pendingEvents.clear();
+
+    // broad phase: only the bodies that left their fat bounds can make new pairs
+
+    for (std::size_t index : m_proxyMoves) {
+      const Body& body = m_bodies[index];
+
+      m_tree.query(body.fatBounds, [this,index,&body](Handle handle) {
+        std::size_t other = static_cast<std::size_t>(handle.asId());
+
+        if (other == index) {
+          return;
+        }
+
+        if (body.type == CollisionBodyType::Static && m_bodies[other].type == CollisionBodyType::Static) {
+          return;
+        }
+
+        uint64_t key = makePairKey(std::min(index, other), std::max(index, other));
+
+        if (m_pairs.find(key) == m_pairs.end()) {
+          m_pairs.emplace(key, Pair{ false, true, Penetration{ gf::vec(0.0f, 0.0f), 0.0f } });
+        }
+      });
+    }
+
+    m_proxyMoves.clear();
+
+    // narrow phase: only the new pairs and the pairs where a body moved
+
+    m_narrowPhaseCount = 0;
+
+    for (auto it = m_pairs.begin(); it != m_pairs.end(); ) {
+      std::size_t lhsIndex = static_cast<std::size_t>(it->first >> 32);
+      std::size_t rhsIndex = static_cast<std::size_t>(it->first & UINT64_C(0xFFFFFFFF));
+      Pair& pair = it->second;
+
+      const Body& lhs = m_bodies[lhsIndex];
+      const Body& rhs = m_bodies[rhsIndex];
+
+      CollisionEvent event;
+      event.lhs = static_cast<CollisionBodyId>(lhsIndex);
+      event.rhs = static_cast<CollisionBodyId>(rhsIndex);
+      event.lhsHandle = lhs.handle;
+      event.rhsHandle = rhs.handle;
+
+      if (!lhs.fatBounds.intersects(rhs.fatBounds)) {
+        if (pair.touching) {
+          event.type = CollisionEventType::End;
+          event.penetration = pair.penetration;
+          callback(event);
+        }
+
+        it = m_pairs.erase(it);
+        continue;
+      }
+
+      if (pair.fresh || lhs.moved || rhs.moved) {
+        ++m_narrowPhaseCount;
+        pair.fresh = false;
+
+        Penetration p;
+        bool touching = collideBodies(lhs, rhs, p);
+
+        if (touching) {
+          event.type = pair.touching ? CollisionEventType::Persist : CollisionEventType::Begin;
+          event.penetration = p;
+          pair.penetration = p;
+          callback(event);
+        } else if (pair.touching) {
+          event.type = CollisionEventType::End;
+          event.penetration = pair.penetration;
+          callback(event);
+        }
+
+        pair.touching = touching;
+      } else if (pair.touching && (lhs.awake || rhs.awake)) {
+        event.type = CollisionEventType::Persist;
+        event.penetration = pair.penetration;
+        callback(event);
+      }
+
+      ++it;
+    }
+
+    // sleeping
+
+    for (std::size_t index : m_movedBodies) {
+      m_bodies[index].moved = false;
+    }
+
+    m_movedBodies.clear();
+
+    if (!m_sleepingEnabled) {
+      return;
+    }
+
+    std::size_t awake = 0;
+
+    for (std::size_t index : m_awakeBodies) {
+      Body& body = m_bodies[index];
+      body.stillTime += time;
+
+      if (body.stillTime >= m_sleepDelay) {
+        body.awake = false;
+      } else {
+        m_awakeBodies[awake++] = index;
+      }
+    }
+
+    m_awakeBodies.resize(awake);
+  }
+
+  bool CollisionWorld::cast(CollisionBodyId id, Vector2f motion, CollisionHit& hit) {
+    std::size_t index = static_cast<std::size_t>(id);
+    const Body& body = m_bodies[index];
+    bool found = false;
+
+    m_tree.query(computeSweptBounds(computeBounds(body), motion), [&](Handle handle) {
+      std::size_t other = static_cast<std::size_t>(handle.asId());
+
+      if (other == index) {
+        return;
+      }
+
+      const Body& otherBody = m_bodies[other];
+      Impact impact;
+
+      if (!castBodies(body, motion, otherBody, impact)) {
+        return;
+      }
+
+      if (!found || impact.time < hit.impact.time) {
+        hit.body = static_cast<CollisionBodyId>(other);
+        hit.handle = otherBody.handle;
+        hit.impact = impact;
+        found = true;
+      }
+    });
+
+    return found;
+  }
+
+  std::size_t CollisionWorld::query(const RectF& bounds, std::function<void(CollisionBodyId)> callback) {
+    return m_tree.query(bounds, [&callback](Handle handle) {
+      callback(static_cast<CollisionBodyId>(handle.asId()));
+    });
+  }
+
+  void CollisionWorld::touchBody(std::size_t index) {
+    Body& body = m_bodies[index];
+
+    if (!body.moved) {
+      body.moved = true;
+      m_movedBodies.push_back(index);
+    }
+
+    wake(static_cast<CollisionBodyId>(index));
+  }
+
+  RectF CollisionWorld::computeBounds(const Body& body) {
+    switch (body.shape) {
+      case ShapeType::Circle: {
+        Vector2f center = gf::transform(body.transform, body.circle.center);
+        Vector2f extent(body.circle.radius, body.circle.radius);
+        return RectF::fromMinMax(center - extent, center + extent);
+      }
+
+      case ShapeType::Rectangle:
+        if (isAxisAligned(body.transform)) {
+          Vector2f offset = body.transform.translation.offset;
+          return RectF::fromMinMax(body.rectangle.min + offset, body.rectangle.max + offset);
+        }
+        break;
+
+      case ShapeType::Polygon:
+        break;
+    }
+
+    RectF bounds = RectF::empty();
+
+    for (std::size_t i = 0; i < body.polygon.getPointCount(); ++i) {
+      bounds.extend(gf::transform(body.transform, body.polygon.getPoint(i)));
+    }
+
+    return bounds;
+  }
+
+  bool CollisionWorld::collideBodies(const Body& lhs, const Body& rhs, Penetration& p) {
+    // axis aligned rectangles use the specialized tests
+
+    bool lhsAligned = lhs.shape == ShapeType::Rectangle && isAxisAligned(lhs.transform);
+    bool rhsAligned = rhs.shape == ShapeType::Rectangle && isAxisAligned(rhs.transform);
+
+    if (lhsAligned && (rhsAligned || rhs.shape == ShapeType::Circle)) {
+      RectF lhsRect = computeBounds(lhs);
+
+      if (rhsAligned) {
+        return collides(lhsRect, computeBounds(rhs), p);
+      }
+
+      CircF rhsCircle(gf::transform(rhs.transform, rhs.circle.center), rhs.circle.radius);
+      return collides(lhsRect, rhsCircle, p);
+    }
+
+    if (rhsAligned && lhs.shape == ShapeType::Circle) {
+      CircF lhsCircle(gf::transform(lhs.transform, lhs.circle.center), lhs.circle.radius);
+      return collides(lhsCircle, computeBounds(rhs), p);
+    }
+
+    // general case, a rectangle is seen as a polygon
+
+    if (lhs.shape == ShapeType::Circle) {
+      if (rhs.shape == ShapeType::Circle) {
+        return collides(lhs.circle, lhs.transform, rhs.circle, rhs.transform, p);
+      }
+
+      return collides(lhs.circle, lhs.transform, rhs.polygon, rhs.transform, p);
+    }
+
+    if (rhs.shape == ShapeType::Circle) {
+      return collides(lhs.polygon, lhs.transform, rhs.circle, rhs.transform, p);
+    }
+
+    return collides(lhs.polygon, lhs.transform, rhs.polygon, rhs.transform, p);
+  }
+
+  bool CollisionWorld::castBodies(const Body& lhs, Vector2f motion, const Body& rhs, Impact& impact) {
+    Vector2f still(0.0f, 0.0f);
+
+    if (lhs.shape == ShapeType::Circle) {
+      if (rhs.shape == ShapeType::Circle) {
+        return timeOfImpact(lhs.circle, lhs.transform, motion, rhs.circle, rhs.transform, still, impact);
+      }
+
+      return timeOfImpact(lhs.circle, lhs.transform, motion, rhs.polygon, rhs.transform, still, impact);
+    }
+
+    if (rhs.shape == ShapeType::Circle) {
+      return timeOfImpact(lhs.polygon, lhs.transform, motion, rhs.circle, rhs.transform, still, impact);
+    }
+
+    return timeOfImpact(lhs.polygon, lhs.transform, motion, rhs.polygon, rhs.transform, still, impact);
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
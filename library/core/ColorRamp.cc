@@ -20,11 +20,41 @@
  */
 #include <gf/ColorRamp.h>
 
+#include <gf/Image.h>
+
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
 
+  BakedColorRamp::BakedColorRamp()
+  : m_min(0.0f)
+  , m_scale(0.0f)
+  {
+  }
+
+  BakedColorRamp::BakedColorRamp(float min, float max, std::vector<Color4u> colors)
+  : m_min(min)
+  , m_scale(0.0f)
+  , m_colors(std::move(colors))
+  {
+    assert(min <= max);
+
+    if (min < max && m_colors.size() > 1) {
+      m_scale = static_cast<float>(m_colors.size() - 1) / (max - min);
+    }
+  }
+
+  Image BakedColorRamp::copyToImage() const {
+    Image image(Vector2i(static_cast<int>(m_colors.size()), 1));
+
+    for (std::size_t i = 0; i < m_colors.size(); ++i) {
+      image.setPixel({ static_cast<int>(i), 0 }, m_colors[i]);
+    }
+
+    return image;
+  }
+
 // MSVC does not like extern template
 #ifndef _MSC_VER
   template struct ColorRampBase<float>;
@@ -0,0 +1,140 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/FrameArena.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  constexpr std::size_t FrameArena::DefaultChunkSize;
+
+  FrameArena::FrameArena(std::size_t chunkSize)
+  : m_chunkSize(chunkSize)
+  , m_current(0)
+  , m_offset(0)
+  , m_heapAllocationCount(0)
+  {
+    assert(chunkSize > 0);
+  }
+
+  void *FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    if (m_chunks.empty()) {
+      addChunk(0, std::max(m_chunkSize, size + alignment));
+    }
+
+    for (;;) {
+      Chunk& chunk = m_chunks[m_current];
+
+      auto base = reinterpret_cast<uintptr_t>(chunk.data.get());
+      auto aligned = static_cast<std::size_t>(((base + m_offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - base);
+
+      if (aligned + size <= chunk.size) {
+        m_offset = aligned + size;
+        return chunk.data.get() + aligned;
+      }
+
+      // go to the next chunk, the remaining space of this one is lost until the next reset
+
+      ++m_current;
+      m_offset = 0;
+
+      if (m_current == m_chunks.size() || m_chunks[m_current].size < size + alignment) {
+        addChunk(m_current, std::max(m_chunkSize, size + alignment));
+      }
+    }
+  }
+
+  void FrameArena::deallocate(void *ptr, std::size_t size) {
+    if (m_chunks.empty() || ptr == nullptr) {
+      return;
+    }
+
+    unsigned char *data = m_chunks[m_current].data.get();
+    auto bytes = static_cast<unsigned char *>(ptr);
+
+    if (bytes + size == data + m_offset) {
+      m_offset = static_cast<std::size_t>(bytes - data);
+    }
+  }
+
+  void FrameArena::rewind(Marker marker) {
+    assert(marker.chunk < m_chunks.size() || (marker.chunk == 0 && marker.offset == 0));
+    m_current = marker.chunk;
+    m_offset = marker.offset;
+  }
+
+  void FrameArena::reset() {
+    if (m_chunks.size() > 1) {
+      std::size_t capacity = getCapacity();
+      m_chunks.clear();
+      addChunk(0, capacity);
+    }
+
+    m_current = 0;
+    m_offset = 0;
+  }
+
+  std::size_t FrameArena::getUsedSize() const {
+    std::size_t used = m_offset;
+
+    for (std::size_t i = 0; i < m_current; ++i) {
+      used += m_chunks[i].size;
+    }
+
+    return used;
+  }
+
+  std::size_t FrameArena::getCapacity() const {
+    std::size_t capacity = 0;
+
+    for (auto& chunk : m_chunks) {
+      capacity += chunk.size;
+    }
+
+    return capacity;
+  }
+
+  FrameArena& FrameArena::getThreadLocal() {
+    thread_local FrameArena arena;
+    return arena;
+  }
+
+  void FrameArena::addChunk(std::size_t index, std::size_t size) {
+    assert(index <= m_chunks.size());
+
+    Chunk chunk;
+    chunk.data.reset(new unsigned char[size]);
+    chunk.size = size;
+    m_chunks.insert(m_chunks.begin() + index, std::move(chunk));
+
+    ++m_heapAllocationCount;
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
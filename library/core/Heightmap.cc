@@ -20,9 +20,15 @@
  */
 #include <gf/Heightmap.h>
 
+#include <cassert>
+#include <cmath>
 #include <algorithm>
+#include <functional>
+#include <vector>
 
+#include <gf/Array2DOps.h>
 #include <gf/Color.h>
+#include <gf/SnapshotHistory.h>
 #include <gf/VectorOps.h>
 #include <gf/Unused.h>
 
@@ -31,8 +37,17 @@ namespace gf {
 inline namespace v1 {
 #endif
 
+  namespace {
+
+    std::size_t computeHeightmapMemory(Vector2i size) {
+      return static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height) * sizeof(double);
+    }
+
+  }
+
   Heightmap::Heightmap(Vector2i size)
   : m_data(size, 0.0)
+  , m_memory(MemoryTag::Heightmaps, computeHeightmapMemory(size))
   {
 
   }
@@ -60,9 +75,9 @@ inline namespace v1 {
       factor = (max - min) / (currMax - currMin);
     }
 
-    for (auto& value : m_data) {
-      value = min + (value - currMin) * factor;
-    }
+    mapArray(m_data, [min, currMin, factor](double value) {
+      return min + (value - currMin) * factor;
+    });
   }
 
   void Heightmap::addHill(Vector2d center, double radius, double height) {
@@ -134,21 +149,21 @@ inline namespace v1 {
   }
 
   void Heightmap::addValue(double value) {
-    for (auto& currentValue : m_data) {
-      currentValue += value;
-    }
+    mapArray(m_data, [value](double currentValue) {
+      return currentValue + value;
+    });
   }
 
   void Heightmap::scale(double value) {
-    for (auto& currentValue : m_data) {
-      currentValue *= value;
-    }
+    mapArray(m_data, [value](double currentValue) {
+      return currentValue * value;
+    });
   }
 
   void Heightmap::clamp(double min, double max) {
-    for (auto& value : m_data) {
-      value = gf::clamp(value, min, max);
-    }
+    mapArray(m_data, [min, max](double value) {
+      return gf::clamp(value, min, max);
+    });
   }
 
   double Heightmap::getSlope(Vector2i position) const {
@@ -170,6 +185,7 @@ inline namespace v1 {
   void Heightmap::thermalErosion(unsigned iterations, double talus, double fraction) {
     double d[3][3];
 
+    MemoryReservation scratch(MemoryTag::Heightmaps, computeHeightmapMemory(m_data.getSize()));
     Array2D<double, int> material(m_data.getSize());
 
     for (unsigned k = 0; k < iterations; ++k) {
@@ -220,6 +236,8 @@ inline namespace v1 {
   }
 
   void Heightmap::hydraulicErosion(unsigned iterations, double rainAmount, double solubility, double evaporation, double capacity) {
+    MemoryReservation scratch(MemoryTag::Heightmaps, computeHeightmapMemory(m_data.getSize()) * 4);
+
     Array2D<double, int> waterMap(m_data.getSize(), 0.0);
     Array2D<double, int> waterDiff(m_data.getSize(), 0.0);
 
@@ -231,9 +249,9 @@ inline namespace v1 {
     for (unsigned k = 0; k < iterations; ++k) {
 
       // 1. appearance of new water
-      for (auto& water : waterMap) {
-        water += rainAmount;
-      }
+      mapArray(waterMap, [rainAmount](double water) {
+        return water + rainAmount;
+      });
 
       // 2. water erosion of the terrain
       for (auto pos : waterMap.getPositionRange()) {
@@ -292,13 +310,8 @@ inline namespace v1 {
         }
       }
 
-      for (auto pos : waterMap.getPositionRange()) {
-        waterMap(pos) += waterDiff(pos);
-      }
-
-      for (auto pos : materialMap.getPositionRange()) {
-        materialMap(pos) += materialDiff(pos);
-      }
+      zipArrays(waterMap, waterDiff, std::plus<double>());
+      zipArrays(materialMap, materialDiff, std::plus<double>());
 
       // 4. evaporation of water
       for (auto pos : waterMap.getPositionRange()) {
@@ -317,6 +330,7 @@ inline namespace v1 {
   }
 
   void Heightmap::fastErosion(unsigned iterations, double talus, double fraction) {
+    MemoryReservation scratch(MemoryTag::Heightmaps, computeHeightmapMemory(m_data.getSize()));
     Array2D<double, int> material(m_data.getSize());
 
     for (unsigned k = 0; k < iterations; ++k) {
@@ -348,9 +362,7 @@ inline namespace v1 {
       }
 
       // add material map to the map
-      for (auto position : m_data.getPositionRange()) {
-        m_data(position) += material(position);
-      }
+      zipArrays(m_data, material, std::plus<double>());
     }
   }
 
@@ -390,23 +402,28 @@ inline namespace v1 {
     }
 
     Heightmap out(area.getSize());
-
-    for (int j = area.min.y; j < area.max.y; ++j) {
-      for (int i = area.min.x; i < area.max.x; ++i) {
-        out.m_data({ i - area.min.x, j - area.min.y }) = m_data({ i, j });
-      }
-    }
-
+    copyRegion(m_data, area, out.m_data, { 0, 0 });
     return out;
   }
 
-  Image Heightmap::copyToGrayscaleImage() const {
-    Image image(m_data.getSize());
-
-    for (auto pos : m_data.getPositionRange()) {
-      uint8_t value = static_cast<uint8_t>(m_data(pos) * 255);
-      image.setPixel(pos, { value, value, value, 0xFF });
-    }
+  Image Heightmap::copyToGrayscaleImage(Array2DExecution execution) const {
+    Vector2i size = m_data.getSize();
+    Image image(size);
+    uint8_t *pixels = image.getPixelsPtr();
+    const double *data = m_data.begin();
+    auto cols = static_cast<std::size_t>(size.width);
+
+    details::forEachArrayBlock(size.height, details::computeArrayBlockCount(size, execution), [pixels, data, cols](int begin, int end, std::size_t) {
+      std::size_t first = static_cast<std::size_t>(begin) * cols;
+      std::size_t last = static_cast<std::size_t>(end) * cols;
+
+      for (std::size_t i = first; i < last; ++i) {
+        uint8_t value = static_cast<uint8_t>(data[i] * 255);
+        uint8_t *pixel = pixels + i * 4;
+        pixel[0] = pixel[1] = pixel[2] = value;
+        pixel[3] = 0xFF;
+      }
+    });
 
     return image;
   }
@@ -421,98 +438,124 @@ inline namespace v1 {
       return (value - waterLevel) / (1.0 - waterLevel) * 0.5 + 0.5;
     }
 
-  } // anonymous namespace
-
-  Image Heightmap::copyToColoredImage(const ColorRampD& ramp, double waterLevel, Render render) const {
-    Image image(m_data.getSize());
-
-    for (auto pos : m_data.getPositionRange()) {
-      double value = valueWithWaterLevel(m_data(pos), waterLevel);
-      Color4d color = ramp.computeColor(value);
-      image.setPixel(pos, ColorD::toRgba32(color));
+    void colorizeHeightmapRow(const double *row, std::size_t cols, const BakedColorRamp& ramp, double waterLevel, uint8_t *pixels) {
+      for (std::size_t col = 0; col < cols; ++col) {
+        Color4u color = ramp.computeColor(static_cast<float>(valueWithWaterLevel(row[col], waterLevel)));
+        uint8_t *pixel = pixels + col * 4;
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        pixel[3] = color.a;
+      }
     }
 
-    if (render == Render::Shaded) {
-      static constexpr Vector3d Light = { -1, -1, 0 };
-
-      for (auto pos : m_data.getPositionRange()) {
-        if (m_data(pos) < waterLevel) {
-          continue;
-        }
+    /*
+     * The normal of a point is the average of the normals of the triangles
+     * made with its neighbors. The normal of each triangle is (gx, gy, 1)
+     * where gx and gy are finite differences of the heights, so the average
+     * normal is a difference between the west and east neighbors (and the
+     * north and south neighbors), where a missing neighbor is replaced by
+     * the point itself.
+     */
+    void computeHeightmapRowSlopes(const double *north, const double *row, const double *south, std::size_t cols, float *dx, float *dy) {
+      assert(cols > 0);
+
+      double factorY = (north != row ? 1.0 : 0.0) + (south != row ? 1.0 : 0.0);
+      factorY = factorY > 0.0 ? 1.0 / factorY : 0.0;
+
+      for (std::size_t col = 0; col < cols; ++col) {
+        dy[col] = static_cast<float>((north[col] - south[col]) * factorY);
+      }
 
-        double x = pos.col;
-        double y = pos.row;
+      if (cols == 1) {
+        dx[0] = 0.0f;
+        return;
+      }
 
-        // compute the normal vector
-        Vector3d normal(0, 0, 0);
-        unsigned count = 0;
+      dx[0] = static_cast<float>(row[0] - row[1]);
 
-        Vector3d p{x, y, m_data(pos)};
+      for (std::size_t col = 1; col < cols - 1; ++col) {
+        dx[col] = static_cast<float>((row[col - 1] - row[col + 1]) * 0.5);
+      }
 
-        if (pos.col > 0 && pos.row > 0) {
-          Vector3d pn{x    , y - 1, m_data({ pos.col    , pos.row - 1 })};
-          Vector3d pw{x - 1, y    , m_data({ pos.col - 1, pos.row     })};
+      dx[cols - 1] = static_cast<float>(row[cols - 2] - row[cols - 1]);
+    }
 
-          Vector3d v3 = cross(p - pw, p - pn);
-          assert(v3.z > 0);
+    void shadeHeightmapRow(const double *row, const float *dx, const float *dy, std::size_t cols, double waterLevel, uint8_t *pixels) {
+      static constexpr float DarkColor[4] = { 0x33, 0x11, 0x33, 0xFF };
+      static constexpr float LightColor[4] = { 0xFF, 0xFF, 0xCC, 0xFF };
 
-          normal += v3;
-          count += 1;
+      for (std::size_t col = 0; col < cols; ++col) {
+        if (row[col] < waterLevel) {
+          continue;
         }
 
-        if (pos.col > 0 && pos.row < m_data.getRows() - 1) {
-          Vector3d pw{x - 1, y    , m_data({ pos.col - 1, pos.row     })};
-          Vector3d ps{x    , y + 1, m_data({ pos.col    , pos.row + 1 })};
+        // light is (-1, -1, 0) and the normal is (dx, dy, 1) normalized
+        float d = -(dx[col] + dy[col]) / std::sqrt(dx[col] * dx[col] + dy[col] * dy[col] + 1.0f);
+        d = gf::clamp(0.5f + 35.0f * d, 0.0f, 1.0f);
 
-          Vector3d v3 = cross(p - ps, p - pw);
-          assert(v3.z > 0);
+        // lerp towards the dark color in the shadow and towards the light color in the light
+        const float *target = d < 0.5f ? DarkColor : LightColor;
+        float weight = d < 0.5f ? (1.0f - 2.0f * d) * 0.7f : (2.0f * d - 1.0f) * 0.3f;
+        uint8_t *pixel = pixels + col * 4;
 
-          normal += v3;
-          count += 1;
+        for (std::size_t k = 0; k < 4; ++k) {
+          float value = pixel[k] + (target[k] - pixel[k]) * weight;
+          pixel[k] = static_cast<uint8_t>(value + 0.5f);
         }
+      }
+    }
 
-        if (pos.col < m_data.getCols() - 1 && pos.row > 0) {
-          Vector3d pe{x + 1, y    , m_data({ pos.col + 1, pos.row     })};
-          Vector3d pn{x    , y - 1, m_data({ pos.col    , pos.row - 1 })};
+  } // anonymous namespace
 
-          Vector3d v3 = cross(p - pn, p - pe);
-          assert(v3.z > 0);
+  Image Heightmap::copyToColoredImage(const ColorRampD& ramp, double waterLevel, Render render, Array2DExecution execution) const {
+    return copyToColoredImage(ramp.bake(), waterLevel, render, execution);
+  }
 
-          normal += v3;
-          count += 1;
-        }
+  Image Heightmap::copyToColoredImage(const BakedColorRamp& ramp, double waterLevel, Render render, Array2DExecution execution) const {
+    Vector2i size = m_data.getSize();
+    Image image(size);
 
-        if (pos.col < m_data.getCols() - 1 && pos.row < m_data.getRows() - 1) {
-          Vector3d pe{x + 1, y    , m_data({ pos.col + 1, pos.row     })};
-          Vector3d ps{x    , y + 1, m_data({ pos.col    , pos.row + 1 })};
+    if (size.width == 0 || size.height == 0) {
+      return image;
+    }
 
-          Vector3d v3 = cross(p - pe, p - ps);
-          assert(v3.z > 0);
+    uint8_t *pixels = image.getPixelsPtr();
+    const double *data = m_data.begin();
+    auto cols = static_cast<std::size_t>(size.width);
+    int rows = size.height;
 
-          normal += v3;
-          count += 1;
-        }
+    details::forEachArrayBlock(rows, details::computeArrayBlockCount(size, execution), [&ramp, waterLevel, render, pixels, data, cols, rows](int begin, int end, std::size_t) {
+      std::vector<float> dx;
+      std::vector<float> dy;
 
-        normal = gf::normalize(normal / count);
-        double d = gf::dot(Light, normal);
-        d = gf::clamp(0.5 + 35 * d, 0.0, 1.0);
+      if (render == Render::Shaded) {
+        dx.resize(cols);
+        dy.resize(cols);
+      }
 
-        Color4u pixel = image.getPixel(pos);
+      for (int y = begin; y < end; ++y) {
+        const double *row = data + static_cast<std::size_t>(y) * cols;
+        uint8_t *rowPixels = pixels + static_cast<std::size_t>(y) * cols * 4;
 
-        Color4u lo = gf::lerp(pixel, Color4u(0x33, 0x11, 0x33, 0xFF), 0.7);
-        Color4u hi = gf::lerp(pixel, Color4u(0xFF, 0xFF, 0xCC, 0xFF), 0.3);
+        colorizeHeightmapRow(row, cols, ramp, waterLevel, rowPixels);
 
-        if (d < 0.5) {
-          image.setPixel(pos, gf::lerp(lo, pixel, 2 * d));
-        } else {
-          image.setPixel(pos, gf::lerp(pixel, hi, 2 * d - 1));
+        if (render == Render::Shaded) {
+          const double *north = y > 0 ? row - cols : row;
+          const double *south = y < rows - 1 ? row + cols : row;
+          computeHeightmapRowSlopes(north, row, south, cols, dx.data(), dy.data());
+          shadeHeightmapRow(row, dx.data(), dy.data(), cols, waterLevel, rowPixels);
         }
       }
-    }
+    });
 
     return image;
   }
 
+  void Heightmap::trackState(SnapshotHistory& history) {
+    history.track(m_data);
+  }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
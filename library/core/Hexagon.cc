@@ -20,6 +20,9 @@
  */
 #include <gf/Hexagon.h>
 
+#include <cassert>
+#include <cstdlib>
+
 #include <gf/VectorOps.h>
 
 namespace gf {
@@ -105,21 +108,137 @@ inline namespace v1 {
     return center;
   }
 
+  namespace {
+
+    // unit corners, in the same order as the angles 0, 60, 120... (minus 30 for pointy hexagons)
+
+    constexpr Vector2f PointyCorners[6] = {
+      {  Sqrt3 / 2, -0.5f },
+      {  Sqrt3 / 2,  0.5f },
+      {  0.0f,       1.0f },
+      { -Sqrt3 / 2,  0.5f },
+      { -Sqrt3 / 2, -0.5f },
+      {  0.0f,      -1.0f },
+    };
+
+    constexpr Vector2f FlatCorners[6] = {
+      {  1.0f,  0.0f      },
+      {  0.5f,  Sqrt3 / 2 },
+      { -0.5f,  Sqrt3 / 2 },
+      { -1.0f,  0.0f      },
+      { -0.5f, -Sqrt3 / 2 },
+      {  0.5f, -Sqrt3 / 2 },
+    };
+
+    // see https://www.redblobgames.com/grids/hexagons/#neighbors-axial
+
+    constexpr Vector2i AxialDirections[6] = {
+      {  1,  0 },
+      {  1, -1 },
+      {  0, -1 },
+      { -1,  0 },
+      { -1,  1 },
+      {  0,  1 },
+    };
+
+  }
+
   std::vector<Vector2f> HexagonHelper::computeCorners(Vector2i coords, float radius) const {
     std::vector<Vector2f> corners(6);
+    computeCorners(coords, radius, corners);
+    return corners;
+  }
+
+  void HexagonHelper::computeCorners(Vector2i coords, float radius, Span<Vector2f> corners) const noexcept {
+    assert(corners.getSize() >= 6);
     Vector2f center = computeCenter(coords, radius);
+    const Vector2f *unitCorners = (m_axis == MapCellAxis::X) ? PointyCorners : FlatCorners;
+
+    for (std::size_t i = 0; i < 6; ++i) {
+      corners[i] = center + radius * unitCorners[i];
+    }
+  }
+
+  // see https://www.redblobgames.com/grids/hexagons/#conversions-offset
 
-    for (unsigned i = 0; i < corners.size(); ++i) {
-      float angle = i * Pi3;
-      if (m_axis == MapCellAxis::X) {
-        angle -= Pi6;
-      }
+  Vector2i HexagonHelper::convertOffsetToAxial(Vector2i coords) const noexcept {
+    Vector2i axial = coords;
 
-      corners[i].x = center.x + radius * std::cos(angle);
-      corners[i].y = center.y + radius * std::sin(angle);
+    switch (m_axis) {
+      case MapCellAxis::X:
+        switch (m_index) {
+          case MapCellIndex::Odd:
+            axial.x = coords.x - (coords.y - (coords.y & 1)) / 2;
+            break;
+          case MapCellIndex::Even:
+            axial.x = coords.x - (coords.y + (coords.y & 1)) / 2;
+            break;
+        }
+        break;
+
+      case MapCellAxis::Y:
+        switch (m_index) {
+          case MapCellIndex::Odd:
+            axial.y = coords.y - (coords.x - (coords.x & 1)) / 2;
+            break;
+          case MapCellIndex::Even:
+            axial.y = coords.y - (coords.x + (coords.x & 1)) / 2;
+            break;
+        }
+        break;
     }
 
-    return corners;
+    return axial;
+  }
+
+  Vector2i HexagonHelper::convertAxialToOffset(Vector2i coords) const noexcept {
+    Vector2i offset = coords;
+
+    switch (m_axis) {
+      case MapCellAxis::X:
+        switch (m_index) {
+          case MapCellIndex::Odd:
+            offset.x = coords.x + (coords.y - (coords.y & 1)) / 2;
+            break;
+          case MapCellIndex::Even:
+            offset.x = coords.x + (coords.y + (coords.y & 1)) / 2;
+            break;
+        }
+        break;
+
+      case MapCellAxis::Y:
+        switch (m_index) {
+          case MapCellIndex::Odd:
+            offset.y = coords.y + (coords.x - (coords.x & 1)) / 2;
+            break;
+          case MapCellIndex::Even:
+            offset.y = coords.y + (coords.x + (coords.x & 1)) / 2;
+            break;
+        }
+        break;
+    }
+
+    return offset;
+  }
+
+  int HexagonHelper::computeDistance(Vector2i origin, Vector2i target) const noexcept {
+    Vector2i d = convertOffsetToAxial(target) - convertOffsetToAxial(origin);
+    return (std::abs(d.x) + std::abs(d.y) + std::abs(d.x + d.y)) / 2;
+  }
+
+  std::array<Vector2i, 6> HexagonHelper::computeNeighbors(Vector2i coords) const noexcept {
+    std::array<Vector2i, 6> neighbors;
+    Vector2i axial = convertOffsetToAxial(coords);
+
+    for (std::size_t i = 0; i < 6; ++i) {
+      neighbors[i] = convertAxialToOffset(axial + AxialDirections[i]);
+    }
+
+    return neighbors;
+  }
+
+  Span<const Vector2i> HexagonHelper::getAxialDirections() noexcept {
+    return AxialDirections;
   }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
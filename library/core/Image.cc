@@ -285,6 +285,14 @@ inline namespace v1 {
     return m_pixels.data();
   }
 
+  uint8_t* Image::getPixelsPtr() {
+    if (m_pixels.empty()) {
+      return nullptr;
+    }
+
+    return m_pixels.data();
+  }
+
   void Image::flipHorizontally() {
     if (m_pixels.empty()) {
       return;
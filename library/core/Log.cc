@@ -28,6 +28,8 @@
 #include <chrono>
 #include <utility>
 
+#include <gf/StringUtils.h>
+
 #include "config.h"
 
 namespace gf {
@@ -92,8 +94,10 @@ inline namespace v1 {
     std::size_t size = std::strftime(buffer, BufferSize, "%F %T", std::localtime(&integerPart));
     std::snprintf(buffer + size, BufferSize - size, ".%06" PRIi64, fractionalPart);
 
-    std::fprintf(stderr, "[%s][%s] ", buffer, getStringFromLevel(level));
-    std::vfprintf(stderr, fmt, ap);
+    // a single write, so that lines from different threads are not mixed
+    FormatBuffer message;
+    message.format(fmt, ap);
+    std::fprintf(stderr, "[%s][%s] %s", buffer, getStringFromLevel(level), message.getData());
   }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
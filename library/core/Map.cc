@@ -20,10 +20,13 @@
  */
 #include <gf/Map.h>
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
+#include <gf/Array2DOps.h>
 #include <gf/Geometry.h>
+#include <gf/SnapshotHistory.h>
 #include <gf/VectorOps.h>
 
 #include <boost/heap/binomial_heap.hpp>
@@ -52,9 +55,7 @@ inline namespace v1 {
   }
 
   void SquareMap::reset(Flags<CellProperty> flags) {
-    for (auto& cell : m_cells) {
-      cell = flags;
-    }
+    std::fill(m_cells.begin(), m_cells.end(), flags);
   }
 
   void SquareMap::setTransparent(Vector2i pos, bool transparent) {
@@ -90,15 +91,17 @@ inline namespace v1 {
    */
 
   void SquareMap::clearFieldOfVision() {
-    for (auto& cell : m_cells) {
+    mapArray(m_cells, [](Flags<CellProperty> cell) {
       cell.reset(CellProperty::Visible);
-    }
+      return cell;
+    });
   }
 
   void SquareMap::clearExplored() {
-    for (auto& cell : m_cells) {
+    mapArray(m_cells, [](Flags<CellProperty> cell) {
       cell.reset(CellProperty::Explored);
-    }
+      return cell;
+    });
   }
 
   namespace {
@@ -486,6 +489,352 @@ inline namespace v1 {
     return { };
   }
 
+  void SquareMap::trackState(SnapshotHistory& history) {
+    history.track(m_cells);
+  }
+
+
+  /*
+   * HexagonMap
+   */
+
+  HexagonMap::HexagonMap(Vector2i size, MapCellAxis axis, MapCellIndex index)
+  : m_helper(axis, index)
+  , m_cells(size, None)
+  , m_generation(0)
+  {
+
+  }
+
+  Vector2i HexagonMap::getSize() const {
+    return m_cells.getSize();
+  }
+
+  PositionRange<int> HexagonMap::getRange() const {
+    return m_cells.getPositionRange();
+  }
+
+  void HexagonMap::setCell(Vector2i pos, Flags<CellProperty> flags) {
+    m_cells(pos) = flags;
+  }
+
+  void HexagonMap::reset(Flags<CellProperty> flags) {
+    std::fill(m_cells.begin(), m_cells.end(), flags);
+  }
+
+  void HexagonMap::setTransparent(Vector2i pos, bool transparent) {
+    if (transparent) {
+      m_cells(pos).set(CellProperty::Transparent);
+    } else {
+      m_cells(pos).reset(CellProperty::Transparent);
+    }
+  }
+
+  bool HexagonMap::isTransparent(Vector2i pos) const {
+    return m_cells(pos).test(CellProperty::Transparent);
+  }
+
+  void HexagonMap::setWalkable(Vector2i pos, bool walkable) {
+    if (walkable) {
+      m_cells(pos).set(CellProperty::Walkable);
+    } else {
+      m_cells(pos).reset(CellProperty::Walkable);
+    }
+  }
+
+  bool HexagonMap::isWalkable(Vector2i pos) const {
+    return m_cells(pos).test(CellProperty::Walkable);
+  }
+
+  void HexagonMap::setEmpty(Vector2i pos) {
+    m_cells(pos) = EmptyCell;
+  }
+
+  /*
+   * HexagonMap FoV
+   */
+
+  void HexagonMap::clearFieldOfVision() {
+    mapArray(m_cells, [](Flags<CellProperty> cell) {
+      cell.reset(CellProperty::Visible);
+      return cell;
+    });
+  }
+
+  void HexagonMap::clearExplored() {
+    mapArray(m_cells, [](Flags<CellProperty> cell) {
+      cell.reset(CellProperty::Explored);
+      return cell;
+    });
+  }
+
+  namespace {
+
+    constexpr double HexagonShadowEpsilon = 1e-9;
+
+    using HexagonShadows = std::vector<std::pair<double, double>>;
+
+    // shadows are angular intervals in [0, 1), an angle is the position on a ring divided by the size of the ring
+
+    bool isHexagonShadowCovering(const HexagonShadows& shadows, double lo, double hi) {
+      if (lo < 0.0) {
+        return isHexagonShadowCovering(shadows, lo + 1.0, 1.0) && isHexagonShadowCovering(shadows, 0.0, hi);
+      }
+
+      for (auto& shadow : shadows) {
+        if (shadow.first <= lo + HexagonShadowEpsilon && hi - HexagonShadowEpsilon <= shadow.second) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void addHexagonShadow(HexagonShadows& shadows, double lo, double hi) {
+      if (lo < 0.0) {
+        addHexagonShadow(shadows, lo + 1.0, 1.0);
+        addHexagonShadow(shadows, 0.0, hi);
+        return;
+      }
+
+      auto it = std::lower_bound(shadows.begin(), shadows.end(), std::make_pair(lo, hi));
+      it = shadows.insert(it, std::make_pair(lo, hi));
+
+      if (it != shadows.begin()) {
+        --it;
+      }
+
+      // merge the overlapping shadows
+      while (std::next(it) != shadows.end()) {
+        auto next = std::next(it);
+
+        if (next->first <= it->second + HexagonShadowEpsilon) {
+          it->second = std::max(it->second, next->second);
+          shadows.erase(next);
+        } else if (it->first > hi) {
+          break;
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    bool isHexagonShadowComplete(const HexagonShadows& shadows) {
+      return shadows.size() == 1 && shadows.front().first <= HexagonShadowEpsilon && shadows.front().second >= 1.0 - HexagonShadowEpsilon;
+    }
+
+    void computeHexagonFov(Array2D<Flags<CellProperty>, int>& cells, const HexagonHelper& helper, HexagonShadows& shadows, Vector2i pos, int maxRadius, FieldOfVisionLimit limit, Flags<CellProperty> modification) {
+      cells(pos) |= modification;
+      shadows.clear();
+
+      Vector2i origin = helper.convertOffsetToAxial(pos);
+      Span<const Vector2i> directions = HexagonHelper::getAxialDirections();
+
+      for (int radius = 1; maxRadius <= 0 || radius <= maxRadius; ++radius) {
+        bool inside = false;
+        double ringSize = 6.0 * radius;
+        Vector2i axial = origin + directions[4] * radius;
+
+        for (int side = 0; side < 6; ++side) {
+          for (int step = 0; step < radius; ++step) {
+            Vector2i curr = helper.convertAxialToOffset(axial);
+            axial += directions[side];
+
+            if (!cells.isValid(curr)) {
+              continue;
+            }
+
+            inside = true;
+
+            double index = side * radius + step;
+            double lo = (index - 0.5) / ringSize;
+            double hi = (index + 0.5) / ringSize;
+
+            if (cells(curr).test(CellProperty::Transparent)) {
+              double center = index / ringSize;
+
+              if (!isHexagonShadowCovering(shadows, center - HexagonShadowEpsilon, center + HexagonShadowEpsilon)) {
+                cells(curr) |= modification;
+              }
+            } else {
+              if (limit == FieldOfVisionLimit::Included && !isHexagonShadowCovering(shadows, lo, hi)) {
+                cells(curr) |= modification;
+              }
+
+              addHexagonShadow(shadows, lo, hi);
+            }
+          }
+        }
+
+        // the map is convex so if a ring is outside the map, the following rings are outside too
+        if (!inside || isHexagonShadowComplete(shadows)) {
+          break;
+        }
+      }
+    }
+
+  } // anonymous namespace
+
+  void HexagonMap::computeFieldOfVision(Vector2i pos, int maxRadius, FieldOfVisionLimit limit) {
+    computeHexagonFov(m_cells, m_helper, m_shadows, pos, maxRadius, limit, CellProperty::Visible | CellProperty::Explored);
+  }
+
+  void HexagonMap::computeLocalFieldOfVision(Vector2i pos, int maxRadius, FieldOfVisionLimit limit) {
+    computeHexagonFov(m_cells, m_helper, m_shadows, pos, maxRadius, limit, CellProperty::Visible);
+  }
+
+  bool HexagonMap::isInFieldOfVision(Vector2i pos) const {
+    return m_cells(pos).test(CellProperty::Visible);
+  }
+
+  bool HexagonMap::isExplored(Vector2i pos) const {
+    return m_cells(pos).test(CellProperty::Explored);
+  }
+
+  /*
+   * HexagonMap Route
+   */
+
+  void HexagonMap::prepareSearch() {
+    if (m_nodes.getSize() != m_cells.getSize()) {
+      m_nodes = Array2D<RouteNode, int>(m_cells.getSize(), RouteNode{ 0.0f, { -1, -1 }, 0, false });
+      m_generation = 0;
+    }
+
+    ++m_generation;
+
+    // the nodes with an old generation are considered as not visited
+    if (m_generation == 0) {
+      for (auto& node : m_nodes) {
+        node.generation = 0;
+      }
+
+      m_generation = 1;
+    }
+  }
+
+  std::vector<Vector2i> HexagonMap::computeRoute(Vector2i origin, Vector2i target, Route algorithm) {
+    assert(m_cells.isValid(origin));
+    assert(m_cells.isValid(target));
+
+    prepareSearch();
+    m_heap.clear();
+
+    auto getNode = [this](Vector2i position) -> RouteNode& {
+      RouteNode& node = m_nodes(position);
+
+      if (node.generation != m_generation) {
+        node.distance = std::numeric_limits<float>::infinity();
+        node.previous = { -1, -1 };
+        node.generation = m_generation;
+        node.closed = false;
+      }
+
+      return node;
+    };
+
+    auto heuristic = [this,target,algorithm](Vector2i position) {
+      if (algorithm == Route::Dijkstra) {
+        return 0.0f;
+      }
+
+      return static_cast<float>(m_helper.computeDistance(position, target));
+    };
+
+    auto compare = [](const std::pair<float, Vector2i>& lhs, const std::pair<float, Vector2i>& rhs) {
+      return lhs.first > rhs.first;
+    };
+
+    getNode(origin).distance = 0.0f;
+    m_heap.emplace_back(heuristic(origin), origin);
+
+    while (!m_heap.empty()) {
+      std::pop_heap(m_heap.begin(), m_heap.end(), compare);
+      Vector2i position = m_heap.back().second;
+      m_heap.pop_back();
+
+      RouteNode& node = getNode(position);
+
+      if (node.closed) {
+        continue; // outdated entry in the heap
+      }
+
+      node.closed = true;
+
+      if (position == target) {
+        break;
+      }
+
+      for (auto neighbor : m_helper.computeNeighbors(position)) {
+        if (!m_cells.isValid(neighbor) || !m_cells(neighbor).test(CellProperty::Walkable)) {
+          continue;
+        }
+
+        RouteNode& next = getNode(neighbor);
+
+        if (next.closed) {
+          continue;
+        }
+
+        float newDistance = node.distance + 1.0f;
+
+        if (newDistance < next.distance) {
+          next.distance = newDistance;
+          next.previous = position;
+          m_heap.emplace_back(newDistance + heuristic(neighbor), neighbor);
+          std::push_heap(m_heap.begin(), m_heap.end(), compare);
+        }
+      }
+    }
+
+    if (!getNode(target).closed) {
+      return {};
+    }
+
+    std::vector<Vector2i> route;
+    Vector2i curr = target;
+
+    while (curr != origin) {
+      route.push_back(curr);
+      curr = m_nodes(curr).previous;
+    }
+
+    route.push_back(origin);
+    std::reverse(route.begin(), route.end());
+
+    return route;
+  }
+
+  Array2D<Vector2i, int> HexagonMap::computeFlowField(Vector2i target) {
+    assert(m_cells.isValid(target));
+
+    Array2D<Vector2i, int> field(m_cells.getSize(), { -1, -1 });
+    field(target) = target;
+
+    // all the steps have the same cost, so a breadth-first search is enough
+    m_queue.clear();
+    m_queue.push_back(target);
+
+    for (std::size_t i = 0; i < m_queue.size(); ++i) {
+      Vector2i position = m_queue[i];
+
+      for (auto neighbor : m_helper.computeNeighbors(position)) {
+        if (!m_cells.isValid(neighbor) || !m_cells(neighbor).test(CellProperty::Walkable)) {
+          continue;
+        }
+
+        if (field(neighbor) != Vector2i(-1, -1)) {
+          continue;
+        }
+
+        field(neighbor) = position;
+        m_queue.push_back(neighbor);
+      }
+    }
+
+    return field;
+  }
+
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
@@ -0,0 +1,194 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/MemoryStats.h>
+
+#include <cassert>
+
+#include <atomic>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    struct MemoryCounter {
+      std::atomic<std::size_t> liveBytes;
+      std::atomic<std::size_t> peakBytes;
+      std::atomic<uint64_t> allocationCount;
+      std::atomic<uint64_t> deallocationCount;
+    };
+
+    // zero-initialized before any dynamic initialization
+    MemoryCounter g_memoryCounters[MemoryTagCount];
+
+    MemoryCounter& getMemoryCounter(MemoryTag tag) {
+      auto index = static_cast<std::size_t>(tag);
+      assert(index < MemoryTagCount);
+      return g_memoryCounters[index];
+    }
+
+  }
+
+  void MemoryStats::recordAllocation(MemoryTag tag, std::size_t size) {
+    MemoryCounter& counter = getMemoryCounter(tag);
+    counter.allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    std::size_t live = counter.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    std::size_t peak = counter.peakBytes.load(std::memory_order_relaxed);
+
+    while (peak < live && !counter.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+      // peak has been updated, try again
+    }
+  }
+
+  void MemoryStats::recordDeallocation(MemoryTag tag, std::size_t size) {
+    MemoryCounter& counter = getMemoryCounter(tag);
+    counter.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+    counter.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+  }
+
+  MemoryUsage MemoryStats::getUsage(MemoryTag tag) {
+    MemoryCounter& counter = getMemoryCounter(tag);
+
+    MemoryUsage usage;
+    usage.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+    usage.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+    usage.allocationCount = counter.allocationCount.load(std::memory_order_relaxed);
+    usage.deallocationCount = counter.deallocationCount.load(std::memory_order_relaxed);
+    return usage;
+  }
+
+  MemoryUsage MemoryStats::getTotalUsage() {
+    MemoryUsage total;
+
+    for (std::size_t i = 0; i < MemoryTagCount; ++i) {
+      MemoryUsage usage = getUsage(static_cast<MemoryTag>(i));
+      total.liveBytes += usage.liveBytes;
+      total.peakBytes += usage.peakBytes;
+      total.allocationCount += usage.allocationCount;
+      total.deallocationCount += usage.deallocationCount;
+    }
+
+    return total;
+  }
+
+  void MemoryStats::resetPeaks() {
+    for (auto& counter : g_memoryCounters) {
+      counter.peakBytes.store(counter.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+  }
+
+  const char *MemoryStats::getTagName(MemoryTag tag) {
+    switch (tag) {
+      case MemoryTag::General:
+        return "General";
+      case MemoryTag::Images:
+        return "Images";
+      case MemoryTag::Fonts:
+        return "Fonts";
+      case MemoryTag::Heightmaps:
+        return "Heightmaps";
+      case MemoryTag::Spatial:
+        return "Spatial";
+      case MemoryTag::Geometry:
+        return "Geometry";
+      case MemoryTag::GpuTextures:
+        return "GPU textures";
+      case MemoryTag::GpuBuffers:
+        return "GPU buffers";
+    }
+
+    assert(false);
+    return "?";
+  }
+
+  /*
+   * MemoryReservation
+   */
+
+  MemoryReservation::MemoryReservation(MemoryTag tag, std::size_t size)
+  : m_tag(tag)
+  , m_size(size)
+  {
+    if (m_size > 0) {
+      MemoryStats::recordAllocation(m_tag, m_size);
+    }
+  }
+
+  MemoryReservation::MemoryReservation(const MemoryReservation& other)
+  : MemoryReservation(other.m_tag, other.m_size)
+  {
+  }
+
+  MemoryReservation::MemoryReservation(MemoryReservation&& other) noexcept
+  : m_tag(other.m_tag)
+  , m_size(other.m_size)
+  {
+    other.m_size = 0;
+  }
+
+  MemoryReservation& MemoryReservation::operator=(const MemoryReservation& other) {
+    if (this != &other) {
+      resize(0);
+      m_tag = other.m_tag;
+      resize(other.m_size);
+    }
+
+    return *this;
+  }
+
+  MemoryReservation& MemoryReservation::operator=(MemoryReservation&& other) noexcept {
+    if (this != &other) {
+      resize(0);
+      m_tag = other.m_tag;
+      m_size = other.m_size;
+      other.m_size = 0;
+    }
+
+    return *this;
+  }
+
+  MemoryReservation::~MemoryReservation() {
+    resize(0);
+  }
+
+  void MemoryReservation::resize(std::size_t size) {
+    if (size == m_size) {
+      return;
+    }
+
+    if (m_size > 0) {
+      MemoryStats::recordDeallocation(m_tag, m_size);
+    }
+
+    m_size = size;
+
+    if (m_size > 0) {
+      MemoryStats::recordAllocation(m_tag, m_size);
+    }
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
@@ -0,0 +1,166 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/SnapshotHistory.h>
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include <gf/Log.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  SnapshotHistory::SnapshotHistory(std::size_t capacity, std::size_t pageSize)
+  : m_capacity(std::max(capacity, std::size_t(1)))
+  , m_pageSize(std::max(pageSize, std::size_t(1)))
+  {
+  }
+
+  std::size_t SnapshotHistory::save() {
+    Snapshot snapshot(m_regions.size());
+    const Snapshot *last = m_snapshots.empty() ? nullptr : &m_snapshots.back();
+    std::size_t copied = 0;
+
+    for (std::size_t r = 0; r < m_regions.size(); ++r) {
+      const Region& region = m_regions[r];
+      Span<uint8_t> memory = region.access(region.object);
+
+      RegionPages& current = snapshot[r];
+      current.size = memory.getSize();
+
+      std::size_t pageCount = (current.size + m_pageSize - 1) / m_pageSize;
+      current.pages.reserve(pageCount);
+
+      const RegionPages *previous = (last != nullptr && r < last->size()) ? &(*last)[r] : nullptr;
+
+      for (std::size_t i = 0; i < pageCount; ++i) {
+        std::size_t offset = i * m_pageSize;
+        std::size_t count = std::min(m_pageSize, current.size - offset);
+
+        if (previous != nullptr && i < previous->pages.size()) {
+          std::size_t previousCount = std::min(m_pageSize, previous->size - offset);
+          const std::shared_ptr<Page>& page = previous->pages[i];
+
+          if (previousCount == count && std::memcmp(page->data(), memory.getData() + offset, count) == 0) {
+            current.pages.push_back(page);
+            continue;
+          }
+        }
+
+        std::shared_ptr<Page> page = allocatePage();
+        std::memcpy(page->data(), memory.getData() + offset, count);
+        current.pages.push_back(std::move(page));
+        ++copied;
+      }
+    }
+
+    m_snapshots.push_back(std::move(snapshot));
+
+    if (m_snapshots.size() > m_capacity) {
+      releaseSnapshot(m_snapshots.front());
+      m_snapshots.pop_front();
+    }
+
+    return copied;
+  }
+
+  bool SnapshotHistory::restore(std::size_t back) {
+    if (back >= m_snapshots.size()) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < back; ++i) {
+      releaseSnapshot(m_snapshots.back());
+      m_snapshots.pop_back();
+    }
+
+    const Snapshot& snapshot = m_snapshots.back();
+    bool restored = true;
+
+    for (std::size_t r = 0; r < m_regions.size() && r < snapshot.size(); ++r) {
+      const Region& region = m_regions[r];
+      const RegionPages& saved = snapshot[r];
+      Span<uint8_t> memory = region.access(region.object);
+
+      if (memory.getSize() != saved.size) {
+        if (region.resize == nullptr) {
+          Log::error("The size of a tracked array has changed since the snapshot.\n");
+          restored = false;
+          continue;
+        }
+
+        region.resize(region.object, saved.size);
+        memory = region.access(region.object);
+        assert(memory.getSize() == saved.size);
+      }
+
+      for (std::size_t i = 0; i < saved.pages.size(); ++i) {
+        std::size_t offset = i * m_pageSize;
+        std::size_t count = std::min(m_pageSize, saved.size - offset);
+        const Page& page = *saved.pages[i];
+
+        if (std::memcmp(memory.getData() + offset, page.data(), count) != 0) {
+          std::memcpy(memory.getData() + offset, page.data(), count);
+        }
+      }
+    }
+
+    return restored;
+  }
+
+  void SnapshotHistory::clear() {
+    m_regions.clear();
+    m_snapshots.clear();
+    m_freePages.clear();
+  }
+
+  void SnapshotHistory::addRegion(void *object, Access access, Resize resize) {
+    m_regions.push_back({ object, access, resize });
+  }
+
+  std::shared_ptr<SnapshotHistory::Page> SnapshotHistory::allocatePage() {
+    if (m_freePages.empty()) {
+      return std::make_shared<Page>(m_pageSize);
+    }
+
+    std::shared_ptr<Page> page = std::move(m_freePages.back());
+    m_freePages.pop_back();
+    return page;
+  }
+
+  void SnapshotHistory::releaseSnapshot(Snapshot& snapshot) {
+    // the pages that are not shared with another snapshot can be reused
+    for (auto& region : snapshot) {
+      for (auto& page : region.pages) {
+        if (page.use_count() == 1) {
+          m_freePages.push_back(std::move(page));
+        }
+      }
+    }
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
@@ -0,0 +1,409 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/Spatial_LooseQuadtree.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    // the object fits in the loose bounds of a cell if its center is in the cell and it is not bigger than the cell
+    bool fitsInLooseCell(const RectF& cell, const RectF& bounds) {
+      Vector2f center = bounds.getCenter();
+      Vector2f size = bounds.getSize();
+      Vector2f cellSize = cell.getSize();
+
+      return cell.min.x <= center.x && center.x <= cell.max.x
+          && cell.min.y <= center.y && center.y <= cell.max.y
+          && size.x <= cellSize.x && size.y <= cellSize.y;
+    }
+
+    RectF computeLooseChildBounds(const RectF& bounds, std::size_t child) {
+      Vector2f center = bounds.getCenter();
+      Vector2f min = bounds.min;
+      Vector2f max = center;
+
+      if ((child & 1) != 0) {
+        min.x = center.x;
+        max.x = bounds.max.x;
+      }
+
+      if ((child & 2) != 0) {
+        min.y = center.y;
+        max.y = bounds.max.y;
+      }
+
+      return RectF::fromMinMax(min, max);
+    }
+
+  }
+
+  LooseQuadtree::LooseQuadtree(const RectF& bounds)
+  : m_bounds(bounds)
+  , m_root(NullIndex)
+  {
+    m_root = allocateNode(bounds, NullIndex, 0);
+  }
+
+  SpatialId LooseQuadtree::insert(Handle handle, const RectF& bounds) {
+    std::size_t index = m_entries.allocate();
+    Entry& entry = m_entries[index];
+    entry.handle = handle;
+    entry.bounds = bounds;
+
+    doInsert(index);
+    return static_cast<SpatialId>(index);
+  }
+
+  void LooseQuadtree::modify(SpatialId id, RectF bounds) {
+    std::size_t index = static_cast<std::size_t>(id);
+    Entry& entry = m_entries[index];
+
+    // the object stays in the loose bounds of its node, nothing to change in the tree
+    if (entry.node != m_root && fitsInLooseCell(m_nodes[entry.node].bounds, bounds)) {
+      entry.bounds = bounds;
+      return;
+    }
+
+    doRemove(index);
+    entry.bounds = bounds;
+    doInsert(index);
+  }
+
+  std::size_t LooseQuadtree::query(const RectF& bounds, SpatialQueryCallback callback, SpatialQuery kind) {
+    std::size_t stack[4 * (MaxDepth + 1)];
+    std::size_t top = 0;
+    std::size_t found = 0;
+
+    stack[top++] = m_root;
+
+    while (top > 0) {
+      std::size_t nodeIndex = stack[--top];
+      const Node& node = m_nodes[nodeIndex];
+
+      // objects outside the world are kept in the root, so the root is always visited
+      if (nodeIndex != m_root && !node.looseBounds.intersects(bounds)) {
+        continue;
+      }
+
+      std::size_t remaining = node.count;
+      const std::size_t *slots = node.entries;
+      std::size_t next = node.overflow;
+
+      while (remaining > 0) {
+        std::size_t n = remaining < Size ? remaining : Size;
+
+        for (std::size_t i = 0; i < n; ++i) {
+          const Entry& entry = m_entries[slots[i]];
+
+          switch (kind) {
+            case SpatialQuery::Contain:
+              if (bounds.contains(entry.bounds)) {
+                callback(entry.handle);
+                ++found;
+              }
+              break;
+
+            case SpatialQuery::Intersect:
+              if (bounds.intersects(entry.bounds)) {
+                callback(entry.handle);
+                ++found;
+              }
+              break;
+          }
+        }
+
+        remaining -= n;
+
+        if (remaining > 0) {
+          const Overflow& overflow = m_overflows[next];
+          slots = overflow.entries;
+          next = overflow.next;
+        }
+      }
+
+      if (!node.isLeaf()) {
+        for (auto childIndex : node.children) {
+          assert(top < 4 * (MaxDepth + 1));
+          stack[top++] = childIndex;
+        }
+      }
+    }
+
+    return found;
+  }
+
+  void LooseQuadtree::remove(SpatialId id) {
+    std::size_t index = static_cast<std::size_t>(id);
+    doRemove(index);
+    m_entries.dispose(index);
+  }
+
+  void LooseQuadtree::clear() {
+    m_entries.clear();
+    m_nodes.clear();
+    m_overflows.clear();
+    m_root = allocateNode(m_bounds, NullIndex, 0);
+  }
+
+  Handle LooseQuadtree::operator[](SpatialId id) {
+    std::size_t index = static_cast<std::size_t>(id);
+    return m_entries[index].handle;
+  }
+
+  std::size_t LooseQuadtree::allocateNode(const RectF& bounds, std::size_t parent, std::size_t depth) {
+    std::size_t index = m_nodes.allocate();
+
+    Node& node = m_nodes[index];
+    node.bounds = bounds;
+    Vector2f half = bounds.getSize() / 2;
+    node.looseBounds = RectF::fromMinMax(bounds.min - half, bounds.max + half);
+    node.parent = parent;
+    node.children[0] = NullIndex;
+    node.children[1] = NullIndex;
+    node.children[2] = NullIndex;
+    node.children[3] = NullIndex;
+    node.depth = depth;
+    node.total = 0;
+    node.count = 0;
+    node.overflow = NullIndex;
+
+    return index;
+  }
+
+  std::size_t& LooseQuadtree::getSlot(Node& node, std::size_t slot) {
+    if (slot < Size) {
+      return node.entries[slot];
+    }
+
+    std::size_t block = node.overflow;
+
+    for (std::size_t i = slot / Size - 1; i > 0; --i) {
+      block = m_overflows[block].next;
+    }
+
+    return m_overflows[block].entries[slot % Size];
+  }
+
+  void LooseQuadtree::pushEntry(std::size_t nodeIndex, std::size_t entryIndex) {
+    Node& node = m_nodes[nodeIndex];
+    std::size_t slot = node.count;
+
+    if (slot >= Size && slot % Size == 0) {
+      // add a block at the end of the overflow chain
+      std::size_t block = m_overflows.allocate();
+      m_overflows[block].next = NullIndex;
+
+      if (node.overflow == NullIndex) {
+        node.overflow = block;
+      } else {
+        std::size_t last = node.overflow;
+
+        while (m_overflows[last].next != NullIndex) {
+          last = m_overflows[last].next;
+        }
+
+        m_overflows[last].next = block;
+      }
+    }
+
+    getSlot(node, slot) = entryIndex;
+    node.count++;
+
+    Entry& entry = m_entries[entryIndex];
+    entry.node = nodeIndex;
+    entry.slot = slot;
+  }
+
+  void LooseQuadtree::popEntry(std::size_t entryIndex) {
+    Entry& entry = m_entries[entryIndex];
+    Node& node = m_nodes[entry.node];
+    assert(node.count > 0);
+    std::size_t last = node.count - 1;
+
+    if (entry.slot != last) {
+      std::size_t moved = getSlot(node, last);
+      getSlot(node, entry.slot) = moved;
+      m_entries[moved].slot = entry.slot;
+    }
+
+    node.count--;
+
+    if (last >= Size && last % Size == 0) {
+      // remove the block at the end of the overflow chain
+      std::size_t previous = NullIndex;
+      std::size_t block = node.overflow;
+
+      while (m_overflows[block].next != NullIndex) {
+        previous = block;
+        block = m_overflows[block].next;
+      }
+
+      if (previous == NullIndex) {
+        node.overflow = NullIndex;
+      } else {
+        m_overflows[previous].next = NullIndex;
+      }
+
+      m_overflows.dispose(block);
+    }
+  }
+
+  std::size_t LooseQuadtree::findChild(const Node& node, const RectF& bounds) const {
+    if (node.depth == MaxDepth) {
+      return NullIndex;
+    }
+
+    Vector2f center = bounds.getCenter();
+
+    if (!node.bounds.contains(center)) {
+      return NullIndex;
+    }
+
+    Vector2f size = bounds.getSize();
+    Vector2f childSize = node.bounds.getSize() / 2;
+
+    if (size.x > childSize.x || size.y > childSize.y) {
+      return NullIndex;
+    }
+
+    Vector2f middle = node.bounds.getCenter();
+    return (center.x < middle.x ? 0 : 1) + (center.y < middle.y ? 0 : 2);
+  }
+
+  void LooseQuadtree::doInsert(std::size_t entryIndex) {
+    const RectF& bounds = m_entries[entryIndex].bounds;
+    std::size_t nodeIndex = m_root;
+
+    for (;;) {
+      Node& node = m_nodes[nodeIndex];
+      node.total++;
+
+      std::size_t child = findChild(node, bounds);
+
+      if (child == NullIndex) {
+        pushEntry(nodeIndex, entryIndex);
+        return;
+      }
+
+      if (node.isLeaf()) {
+        if (node.count < Size) {
+          pushEntry(nodeIndex, entryIndex);
+          return;
+        }
+
+        subdivide(nodeIndex);
+      }
+
+      nodeIndex = m_nodes[nodeIndex].children[child];
+    }
+  }
+
+  void LooseQuadtree::doRemove(std::size_t entryIndex) {
+    std::size_t nodeIndex = m_entries[entryIndex].node;
+    popEntry(entryIndex);
+
+    // find the highest subtree that became sparse enough to be merged
+    std::size_t mergeIndex = NullIndex;
+
+    while (nodeIndex != NullIndex) {
+      Node& node = m_nodes[nodeIndex];
+      assert(node.total > 0);
+      node.total--;
+
+      if (!node.isLeaf() && node.total <= Size / 2) {
+        mergeIndex = nodeIndex;
+      }
+
+      nodeIndex = node.parent;
+    }
+
+    if (mergeIndex != NullIndex) {
+      merge(mergeIndex);
+    }
+  }
+
+  void LooseQuadtree::subdivide(std::size_t nodeIndex) {
+    assert(m_nodes[nodeIndex].isLeaf());
+
+    for (std::size_t i = 0; i < 4; ++i) {
+      std::size_t childIndex = allocateNode(computeLooseChildBounds(m_nodes[nodeIndex].bounds, i), nodeIndex, m_nodes[nodeIndex].depth + 1);
+      m_nodes[nodeIndex].children[i] = childIndex;
+    }
+
+    Node& node = m_nodes[nodeIndex];
+
+    // push the entries down, in reverse order so that the swapped entries are already processed
+    for (std::size_t slot = node.count; slot > 0; --slot) {
+      std::size_t entryIndex = getSlot(node, slot - 1);
+      std::size_t child = findChild(node, m_entries[entryIndex].bounds);
+
+      if (child == NullIndex) {
+        continue;
+      }
+
+      popEntry(entryIndex);
+      pushEntry(node.children[child], entryIndex);
+      m_nodes[node.children[child]].total++;
+    }
+  }
+
+  void LooseQuadtree::merge(std::size_t nodeIndex) {
+    Node& node = m_nodes[nodeIndex];
+
+    for (auto& childIndex : node.children) {
+      collect(childIndex, nodeIndex);
+      childIndex = NullIndex;
+    }
+
+    assert(node.count == node.total);
+  }
+
+  void LooseQuadtree::collect(std::size_t nodeIndex, std::size_t targetIndex) {
+    Node& node = m_nodes[nodeIndex];
+
+    if (!node.isLeaf()) {
+      for (auto childIndex : node.children) {
+        collect(childIndex, targetIndex);
+      }
+    }
+
+    for (std::size_t slot = 0; slot < node.count; ++slot) {
+      pushEntry(targetIndex, getSlot(node, slot));
+    }
+
+    std::size_t block = node.overflow;
+
+    while (block != NullIndex) {
+      std::size_t next = m_overflows[block].next;
+      m_overflows.dispose(block);
+      block = next;
+    }
+
+    m_nodes.dispose(nodeIndex);
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
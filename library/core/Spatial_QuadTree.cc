@@ -195,7 +195,7 @@ inline namespace v1 {
     assert(it != node.entries.end());
     node.entries.erase(it);
 
-    if (node.entries.empty()) {
+    if (node.entries.empty() && node.parent != Null) {
       sanitize(node.parent);
     }
   }
@@ -250,7 +250,7 @@ inline namespace v1 {
       for (auto childIndex : node.children) {
         Node& child = m_nodes[childIndex];
 
-        if (!child.entries.empty()) {
+        if (!child.isLeaf() || !child.entries.empty()) {
           return;
         }
       }
@@ -22,13 +22,11 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 
 #include <algorithm>
 #include <memory>
 
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/classification.hpp>
-
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
@@ -97,24 +95,58 @@ inline namespace v1 {
   }
 
   std::string formatString(const char *fmt, va_list ap) {
+    FormatBuffer buffer;
+    StringRef ref = buffer.format(fmt, ap);
+    return std::string(ref.getData(), ref.getSize());
+  }
+
+  constexpr std::size_t FormatBuffer::InlineSize;
+
+  FormatBuffer::FormatBuffer()
+  : m_data(m_inline)
+  , m_capacity(InlineSize)
+  , m_size(0)
+  {
+    m_inline[0] = '\0';
+  }
+
+  StringRef FormatBuffer::format(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    StringRef res = format(fmt, ap);
+    va_end(ap);
+    return res;
+  }
+
+  StringRef FormatBuffer::format(const char *fmt, va_list ap) {
+    m_size = 0;
+    m_data[0] = '\0';
+
     if (fmt == nullptr) {
-      return "";
+      return StringRef(m_data, m_size);
     }
 
     va_list test;
     va_copy(test, ap);
+    int size = std::vsnprintf(m_data, m_capacity, fmt, test);
+    va_end(test);
 
-    int size = std::vsnprintf(nullptr, 0, fmt, test);
-    assert(size >= 0);
-
-    ++size; // for '\0'
+    if (size < 0) {
+      m_data[0] = '\0';
+      return StringRef(m_data, m_size);
+    }
 
-    auto buffer = std::make_unique<char[]>(size);
-    std::vsnprintf(buffer.get(), size, fmt, ap);
+    auto required = static_cast<std::size_t>(size) + 1; // for '\0'
 
-    va_end(test);
+    if (required > m_capacity) {
+      m_heap = std::make_unique<char[]>(required);
+      m_data = m_heap.get();
+      m_capacity = required;
+      std::vsnprintf(m_data, m_capacity, fmt, ap);
+    }
 
-    return std::string(buffer.get());
+    m_size = static_cast<std::size_t>(size);
+    return StringRef(m_data, m_size);
   }
 
   std::string escapeString(StringRef str) {
@@ -144,21 +176,11 @@ inline namespace v1 {
   }
 
   std::vector<StringRef> splitInParagraphs(StringRef str) {
-    std::vector<StringRef> out;
-    boost::algorithm::split(out, str, boost::is_any_of("\n"), boost::algorithm::token_compress_on);
-    out.erase(std::remove_if(out.begin(), out.end(), [](StringRef s) {
-      return s.isEmpty();
-    }), out.end());
-    return out;
+    return splitInParagraphs(str, std::allocator<StringRef>());
   }
 
   std::vector<StringRef> splitInWords(StringRef str) {
-    std::vector<StringRef> out;
-    boost::algorithm::split(out, str, boost::is_any_of(U" \t"), boost::algorithm::token_compress_on);
-    out.erase(std::remove_if(out.begin(), out.end(), [](StringRef s) {
-      return s.isEmpty();
-    }), out.end());
-    return out;
+    return splitInWords(str, std::allocator<StringRef>());
   }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -28,15 +28,18 @@
 #include "Activity.cc"
 #include "Array2D.cc"
 #include "AssetManager.cc"
+#include "BatchRecord.cc"
 #include "Circ.cc"
 #include "Clock.cc"
 #include "Collision.cc"
+#include "CollisionWorld.cc"
 #include "Color.cc"
 #include "ColorRamp.cc"
 #include "Dice.cc"
 #include "Direction.cc"
 #include "Easings.cc"
 #include "Flags.cc"
+#include "FrameArena.cc"
 #include "Geometry.cc"
 #include "Heightmap.cc"
 #include "Hexagon.cc"
@@ -45,6 +48,7 @@
 #include "Map.cc"
 #include "Math.cc"
 #include "Matrix.cc"
+#include "MemoryStats.cc"
 #include "MessageManager.cc"
 #include "Model.cc"
 #include "ModelContainer.cc"
@@ -64,7 +68,9 @@
 #include "Serialization.cc"
 #include "SerializationOps.cc"
 #include "Sleep.cc"
+#include "SnapshotHistory.cc"
 #include "Spatial_DynamicTree.cc"
+#include "Spatial_LooseQuadtree.cc"
 #include "Spatial_QuadTree.cc"
 #include "Spatial_RStarTree.cc"
 #include "Spatial_SimpleSpatialIndex.cc"
@@ -24,13 +24,22 @@
 #include <stdexcept>
 
 #include <gf/Controls.h>
+#include <gf/Event.h>
 
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
 
-  struct Event;
+  namespace {
+
+    // incremented each time the controls of an action change, so that the containers know when to update their routes
+    uint64_t& getBindingsGeneration() {
+      static uint64_t generation = 1;
+      return generation;
+    }
+
+  }
 
   Action::Action(std::string name)
   : m_name(std::move(name))
@@ -93,6 +102,13 @@ inline namespace v1 {
 
   void Action::addControl(Control& control) {
     m_controls.push_back(control);
+    ++getBindingsGeneration();
+  }
+
+  void Action::clearControls() {
+    m_controls.clear();
+    m_ownedControls.clear();
+    ++getBindingsGeneration();
   }
 
   void Action::processEvent(const Event& event) {
@@ -123,8 +139,15 @@ inline namespace v1 {
 
   // ActionContainer
 
+  ActionContainer::ActionContainer()
+  : m_routesGeneration(0)
+  {
+
+  }
+
   void ActionContainer::addAction(Action& action) {
     m_actions.push_back(action);
+    m_routesGeneration = 0;
   }
 
   bool ActionContainer::hasAction(const std::string& name) const {
@@ -159,9 +182,72 @@ inline namespace v1 {
     return *it;
   }
 
+  namespace {
+
+    std::size_t computeEventRoutes(const Event& event, ControlRoute (&routes)[2]) {
+      switch (event.type) {
+        case EventType::KeyPressed:
+        case EventType::KeyReleased:
+          routes[0] = { ControlRouteKind::Keycode, 0, static_cast<int32_t>(event.key.keycode) };
+          routes[1] = { ControlRouteKind::Scancode, 0, static_cast<int32_t>(event.key.scancode) };
+          return 2;
+
+        case EventType::MouseButtonPressed:
+        case EventType::MouseButtonReleased:
+          routes[0] = { ControlRouteKind::MouseButton, 0, static_cast<int32_t>(event.mouseButton.button) };
+          return 1;
+
+        case EventType::GamepadButtonPressed:
+        case EventType::GamepadButtonReleased:
+          routes[0] = { ControlRouteKind::GamepadButton, static_cast<int32_t>(event.gamepadButton.id), static_cast<int32_t>(event.gamepadButton.button) };
+          routes[1] = { ControlRouteKind::GamepadButton, static_cast<int32_t>(AnyGamepad), static_cast<int32_t>(event.gamepadButton.button) };
+          return 2;
+
+        case EventType::GamepadAxisMoved:
+          routes[0] = { ControlRouteKind::GamepadAxis, static_cast<int32_t>(event.gamepadAxis.id), static_cast<int32_t>(event.gamepadAxis.axis) };
+          routes[1] = { ControlRouteKind::GamepadAxis, static_cast<int32_t>(AnyGamepad), static_cast<int32_t>(event.gamepadAxis.axis) };
+          return 2;
+
+        case EventType::Closed:
+          routes[0] = { ControlRouteKind::Close, 0, 0 };
+          return 1;
+
+        default:
+          break;
+      }
+
+      return 0;
+    }
+
+  }
+
   void ActionContainer::processEvent(const Event& event) {
-    for (Action& action : m_actions) {
-      action.processEvent(event);
+    if (m_routesGeneration != getBindingsGeneration()) {
+      updateRoutes();
+    }
+
+    ControlRoute routes[2];
+    std::size_t count = computeEventRoutes(event, routes);
+
+    // the gamepad event of gf::AnyGamepad must not be routed twice
+    if (count == 2 && routes[0] == routes[1]) {
+      count = 1;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      auto it = m_routes.find(routes[i]);
+
+      if (it == m_routes.end()) {
+        continue;
+      }
+
+      for (Control& control : it->second) {
+        control.processEvent(event);
+      }
+    }
+
+    for (Control& control : m_unroutedControls) {
+      control.processEvent(event);
     }
   }
 
@@ -171,6 +257,31 @@ inline namespace v1 {
     }
   }
 
+  void ActionContainer::updateRoutes() {
+    m_routes.clear();
+    m_unroutedControls.clear();
+
+    for (Action& action : m_actions) {
+      for (Control& control : action.m_controls) {
+        ControlRoute route;
+
+        if (control.getRoute(route)) {
+          m_routes[route].push_back(control);
+        } else {
+          m_unroutedControls.push_back(control);
+        }
+      }
+    }
+
+    m_routesGeneration = getBindingsGeneration();
+  }
+
+  std::size_t ActionContainer::RouteHash::operator()(const ControlRoute& route) const noexcept {
+    uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(route.id) ^ static_cast<uint32_t>(route.kind) << 24) << 32 | static_cast<uint32_t>(route.code);
+    // Fibonacci hashing, as std::hash is the identity for integers on some platforms
+    return static_cast<std::size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> 16);
+  }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
@@ -27,6 +27,7 @@
 #include <limits>
 
 #include <gf/Font.h>
+#include <gf/FrameArena.h>
 #include <gf/StringUtils.h>
 #include <gf/VectorOps.h>
 
@@ -105,13 +106,13 @@ inline namespace v1 {
   namespace {
 
     struct ParagraphLine {
-      std::vector<StringRef> words;
+      FrameVector<StringRef> words;
       float indent = 0.0f;
       float spacing = 0.0f;
     };
 
     struct Paragraph {
-      std::vector<ParagraphLine> lines;
+      FrameVector<ParagraphLine> lines;
     };
 
     float getWordWidth(StringRef word, unsigned characterSize, Font& font) {
@@ -132,12 +133,12 @@ inline namespace v1 {
       return width;
     }
 
-    std::vector<Paragraph> makeParagraphs(const std::string& str, float spaceWidth, float paragraphWidth, Alignment align, unsigned characterSize, Font& font) {
-      std::vector<StringRef> paragraphs = splitInParagraphs(str);
-      std::vector<Paragraph> out;
+    FrameVector<Paragraph> makeParagraphs(const std::string& str, float spaceWidth, float paragraphWidth, Alignment align, unsigned characterSize, Font& font) {
+      FrameVector<StringRef> paragraphs = splitInParagraphs(str, FrameAllocator<StringRef>());
+      FrameVector<Paragraph> out;
 
       for (auto simpleParagraph : paragraphs) {
-        std::vector<StringRef> words = splitInWords(simpleParagraph);
+        FrameVector<StringRef> words = splitInWords(simpleParagraph, FrameAllocator<StringRef>());
 
         Paragraph paragraph;
 
@@ -278,14 +279,15 @@ inline namespace v1 {
     spaceWidth += additionalSpace;
     float lineHeight = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
 
-    std::vector<Paragraph> paragraphs = makeParagraphs(m_string, spaceWidth, m_paragraphWidth, m_align, m_characterSize, *m_font);
+    FrameArenaScope scope;
+    FrameVector<Paragraph> paragraphs = makeParagraphs(m_string, spaceWidth, m_paragraphWidth, m_align, m_characterSize, *m_font);
 
     Vector2f position(0.0f, 0.0f);
 
     Vector2f min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
     Vector2f max(0.0f, 0.0f);
 
-    for (auto paragraph : paragraphs) {
+    for (const auto& paragraph : paragraphs) {
 //       std::printf("Paragraph with %zu lines\n", paragraph.lines.size());
 
       for (const auto& line : paragraph.lines) {
@@ -23,18 +23,21 @@
 #include <cassert>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 
+#include <algorithm>
 #include <memory>
 
 #include <gf/Color.h>
 #include <gf/ConsoleChar.h>
+#include <gf/FrameArena.h>
 #include <gf/Image.h>
 #include <gf/Log.h>
 #include <gf/RenderTarget.h>
 #include <gf/StringUtils.h>
 #include <gf/Unused.h>
 #include <gf/VectorOps.h>
-#include <gf/VertexArray.h>
+#include <gf/Vertex.h>
 
 
 namespace gf {
@@ -50,15 +53,6 @@ inline namespace v1 {
 
   namespace {
 
-    struct ConsoleLine {
-      std::vector<StringRef> words;
-      int indent;
-    };
-
-    struct ConsoleParagraph {
-      std::vector<ConsoleLine> lines;
-    };
-
     bool isColorControl(char32_t c) {
       switch (c) {
         case ConsoleColorControl1:
@@ -88,240 +82,356 @@ inline namespace v1 {
       return width;
     }
 
-    // adaptation of the algorithm in gf::Text
+    // adaptation of the algorithm in gf::Text, on views of the message
 
-    std::vector<ConsoleParagraph> makeParagraphs(const std::string& message, ConsoleAlignment alignment, int paragraphWidth) {
-      auto paragraphs = splitInParagraphs(message);
-      std::vector<ConsoleParagraph> out;
+    bool isConsoleWordSeparator(char c) {
+      return c == ' ' || c == '\t';
+    }
 
-      for (auto simpleParagraph : paragraphs) {
-        auto words = splitInWords(simpleParagraph);
+    // take the next non-empty paragraph of the message
+    bool takeConsoleParagraph(StringRef& message, StringRef& paragraph) {
+      const char *current = message.begin();
+      const char *end = message.end();
 
-        ConsoleParagraph paragraph;
+      while (current != end && *current == '\n') {
+        ++current;
+      }
 
-        ConsoleLine currentLine;
-        int currentWidth = 0;
+      if (current == end) {
+        message = StringRef(end, end);
+        return false;
+      }
 
-        for (auto word : words) {
-          int wordWidth = getWordWidth(word);
+      const char *first = current;
 
-          if (!currentLine.words.empty() && currentWidth + 1 + wordWidth > paragraphWidth) {
-            switch (alignment) {
-              case ConsoleAlignment::Left:
-                currentLine.indent = 0;
-                break;
+      while (current != end && *current != '\n') {
+        ++current;
+      }
 
-              case ConsoleAlignment::Right:
-                currentLine.indent = paragraphWidth - currentWidth;
-                break;
+      paragraph = StringRef(first, current);
+      message = StringRef(current, end);
+      return true;
+    }
 
-              case ConsoleAlignment::Center:
-                currentLine.indent = (paragraphWidth - currentWidth) / 2;
-                break;
-            }
+    // take the next word of the text
+    bool takeConsoleWord(StringRef& text, StringRef& word) {
+      const char *current = text.begin();
+      const char *end = text.end();
 
-            paragraph.lines.push_back(std::move(currentLine));
-            currentLine.words.clear();
-          }
+      while (current != end && isConsoleWordSeparator(*current)) {
+        ++current;
+      }
 
-          if (currentLine.words.empty()) {
-            currentWidth = wordWidth;
-          } else {
-            currentWidth += 1 + wordWidth;
-          }
+      if (current == end) {
+        text = StringRef(end, end);
+        return false;
+      }
 
-          currentLine.words.push_back(word);
-        }
+      const char *first = current;
+
+      while (current != end && !isConsoleWordSeparator(*current)) {
+        ++current;
+      }
 
-        // add the last line
-        if (!currentLine.words.empty()) {
-          switch (alignment) {
-            case ConsoleAlignment::Left:
-              currentLine.indent = 0;
-              break;
+      word = StringRef(first, current);
+      text = StringRef(current, end);
+      return true;
+    }
 
-            case ConsoleAlignment::Right:
-              currentLine.indent = paragraphWidth - currentWidth;
-              break;
+    struct ConsoleLine {
+      StringRef words;
+      int indent;
+    };
 
-            case ConsoleAlignment::Center:
-              currentLine.indent = (paragraphWidth - currentWidth) / 2;
-              break;
-          }
+    // take the next line of the paragraph, that fits in the paragraph width
+    bool takeConsoleLine(StringRef& paragraph, ConsoleAlignment alignment, int paragraphWidth, ConsoleLine& line) {
+      StringRef word;
+
+      if (!takeConsoleWord(paragraph, word)) {
+        return false;
+      }
+
+      const char *first = word.begin();
+      const char *last = word.end();
+      int currentWidth = getWordWidth(word);
+
+      StringRef remaining = paragraph;
+
+      while (takeConsoleWord(remaining, word)) {
+        int wordWidth = getWordWidth(word);
 
-          paragraph.lines.push_back(std::move(currentLine));
+        if (currentWidth + 1 + wordWidth > paragraphWidth) {
+          break;
         }
 
-        out.push_back(std::move(paragraph));
-        paragraph.lines.clear();
+        currentWidth += 1 + wordWidth;
+        last = word.end();
+        paragraph = remaining;
+      }
+
+      line.words = StringRef(first, last);
+
+      switch (alignment) {
+        case ConsoleAlignment::Left:
+          line.indent = 0;
+          break;
+
+        case ConsoleAlignment::Right:
+          line.indent = paragraphWidth - currentWidth;
+          break;
+
+        case ConsoleAlignment::Center:
+          line.indent = (paragraphWidth - currentWidth) / 2;
+          break;
       }
 
-      return out;
+      return true;
     }
 
-  } // anonymous namespace
+    /*
+     * 8-bit colors and row kernels
+     *
+     * The kernels work on the raw channels of a row of cells, with integer
+     * arithmetic and without branches on the cell, so that the compiler can
+     * vectorize them.
+     */
 
+    static_assert(sizeof(Color4u) == 4 * sizeof(uint8_t), "Color4u must be packed");
 
-  /*
-   * Console
-   */
+    uint8_t packConsoleChannel(float value) {
+      return static_cast<uint8_t>(gf::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
 
-  Console::Console(const ConsoleFont& font, Vector2i size)
-  : m_font(&font)
-  , m_data(size)
-  , m_background(Color::Black)
-  , m_foreground(Color::White)
-  , m_effect(ConsoleEffect::None)
-  , m_alignment(ConsoleAlignment::Left)
-  , m_fadingAmount(1.0f)
-  , m_fadingColor(Color::Black)
-  {
-    clear();
-  }
+    Color4u packConsoleColor(const Color4f& color) {
+      return Color4u(packConsoleChannel(color.r), packConsoleChannel(color.g), packConsoleChannel(color.b), packConsoleChannel(color.a));
+    }
 
-  void Console::clear() {
-    for (auto& cell : m_data) {
-      cell.bg = m_background;
-      cell.fg = m_foreground;
-      cell.c = ' ';
+    Color4f unpackConsoleColor(Color4u color) {
+      return Color4f(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
     }
-  }
 
-  Color4f Console::computeColor(ConsoleEffect effect, const Color4f& existing, const Color4f& current) {
-    Color4f result;
+    // alpha in [0, 256]
+    unsigned packConsoleAlpha(float alpha) {
+      return static_cast<unsigned>(gf::clamp(alpha, 0.0f, 1.0f) * 256.0f + 0.5f);
+    }
 
-    if (effect.isDefault()) {
-      effect = m_effect;
+    unsigned divideBy255(unsigned value) {
+      return (value + 127) / 255;
     }
 
-    switch (effect.getKind()) {
-      case ConsoleEffect::None:
-        return existing;
+    // Stride is 0 for a single source color, 4 for a source row
+    template<std::size_t Stride, typename Operation>
+    void blendConsoleRow(Color4u *row, const Color4u *colors, std::size_t count, Operation op) {
+      uint8_t *dst = reinterpret_cast<uint8_t *>(row);
+      const uint8_t *src = reinterpret_cast<const uint8_t *>(colors);
 
-      case ConsoleEffect::Set:
-        return current;
+      for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t k = 0; k < 4; ++k) {
+          dst[i * 4 + k] = static_cast<uint8_t>(op(dst[i * 4 + k], src[i * Stride + k], k));
+        }
+      }
+    }
 
-      case ConsoleEffect::Multiply:
-        return existing * current;
+    void lerpConsoleRow(Color4u *row, const Color4u *colors, std::size_t count, unsigned alpha) {
+      blendConsoleRow<4>(row, colors, count, [alpha](unsigned b, unsigned c, std::size_t) {
+        return (b * (256 - alpha) + c * alpha + 128) >> 8;
+      });
+    }
 
-      case ConsoleEffect::Lighten:
-        return gf::max(existing, current);
+    void applyConsoleEffect(ConsoleEffect effect, Color4u *row, std::size_t count, Color4u color) {
+      switch (effect.getKind()) {
+        case ConsoleEffect::None:
+          break;
 
-      case ConsoleEffect::Darken:
-        return gf::min(existing, current);
+        case ConsoleEffect::Set:
+          std::fill_n(row, count, color);
+          break;
 
-      case ConsoleEffect::Screen:
-        return 1.0f - (1.0f - existing) * (1.0f - current);
+        case ConsoleEffect::Multiply:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t) {
+            return divideBy255(b * c);
+          });
+          break;
 
-      case ConsoleEffect::ColorDodge:
-        for (std::size_t i = 0; i < 3; ++i) {
-          if (existing[i] != 1.0f) {
-            result[i] = current[i] / (1.0f - existing[i]);
-          } else {
-            result[i] = 1.0f;
-          }
-        }
+        case ConsoleEffect::Lighten:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t) {
+            return std::max(b, c);
+          });
+          break;
 
-        return gf::clamp(result, 0.0f, 1.0f);
+        case ConsoleEffect::Darken:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t) {
+            return std::min(b, c);
+          });
+          break;
 
-      case ConsoleEffect::ColorBurn:
-        for (std::size_t i = 0; i < 3; ++i) {
-          if (existing[i] != 0.0f) {
-            result[i] = (1.0f - current[i]) / existing[i];
-          } else {
-            result[i] = 0.0f;
-          }
-        }
+        case ConsoleEffect::Screen:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t) {
+            return 255 - divideBy255((255 - b) * (255 - c));
+          });
+          break;
 
-        return gf::clamp(result, 0.0f, 1.0f);
+        case ConsoleEffect::ColorDodge:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t k) {
+            if (k == 3) {
+              return b;
+            }
+
+            return b == 255 ? 255u : std::min(255u, (c * 255) / (255 - b));
+          });
+          break;
 
-      case ConsoleEffect::Add:
-        return gf::clamp(existing + current, 0.0f, 1.0f);
+        case ConsoleEffect::ColorBurn:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t k) {
+            if (k == 3) {
+              return b;
+            }
 
-      case ConsoleEffect::AddAlpha:
-        return gf::clamp(existing + effect.getAlpha() * current, 0.0f, 1.0f);
+            return b == 0 ? 0u : std::min(255u, ((255 - c) * 255) / b);
+          });
+          break;
 
-      case ConsoleEffect::Burn:
-        return gf::clamp(existing + current - Color::White, 0.0f, 1.0f);
+        case ConsoleEffect::Add:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t) {
+            return std::min(255u, b + c);
+          });
+          break;
 
-      case ConsoleEffect::Overlay:
-        for (std::size_t i = 0; i < 3; ++i) {
-          if (current[i] < 0.5f) {
-            result[i] = 2 * current[i] * existing[i];
-          } else {
-            result[i] = 1.0f - 2 * (1.0f - current[i]) * (1.0f - existing[i]);
-          }
+        case ConsoleEffect::AddAlpha: {
+          unsigned alpha = packConsoleAlpha(effect.getAlpha());
+          blendConsoleRow<0>(row, &color, count, [alpha](unsigned b, unsigned c, std::size_t) {
+            return std::min(255u, b + ((c * alpha + 128) >> 8));
+          });
+          break;
         }
 
-        return gf::clamp(result, 0.0f, 1.0f);
+        case ConsoleEffect::Burn:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t) {
+            return std::max(255u, b + c) - 255u;
+          });
+          break;
+
+        case ConsoleEffect::Overlay:
+          blendConsoleRow<0>(row, &color, count, [](unsigned b, unsigned c, std::size_t k) {
+            if (k == 3) {
+              return b;
+            }
+
+            if (c < 128) {
+              return std::min(255u, divideBy255(2 * c * b));
+            }
 
-      case ConsoleEffect::Alpha:
-        return gf::lerp(existing, current, effect.getAlpha());
+            return 255u - std::min(255u, divideBy255(2 * (255 - c) * (255 - b)));
+          });
+          break;
+
+        case ConsoleEffect::Alpha: {
+          unsigned alpha = packConsoleAlpha(effect.getAlpha());
+          blendConsoleRow<0>(row, &color, count, [alpha](unsigned b, unsigned c, std::size_t) {
+            return (b * (256 - alpha) + c * alpha + 128) >> 8;
+          });
+          break;
+        }
 
-      case ConsoleEffect::Default:
-        assert(false);
-        break;
+        case ConsoleEffect::Default:
+          assert(false);
+          break;
+      }
     }
 
-    return Color::Black;
+  } // anonymous namespace
+
+
+  /*
+   * Console
+   */
+
+  Console::Console(const ConsoleFont& font, Vector2i size)
+  : m_font(&font)
+  , m_chars(size)
+  , m_foregrounds(size)
+  , m_backgrounds(size)
+  , m_background(Color::Black)
+  , m_foreground(Color::White)
+  , m_effect(ConsoleEffect::None)
+  , m_alignment(ConsoleAlignment::Left)
+  , m_fadingAmount(1.0f)
+  , m_fadingColor(Color::Black)
+  {
+    clear();
+  }
+
+  void Console::clear() {
+    std::fill(m_backgrounds.begin(), m_backgrounds.end(), packConsoleColor(m_background));
+    std::fill(m_foregrounds.begin(), m_foregrounds.end(), packConsoleColor(m_foreground));
+    std::fill(m_chars.begin(), m_chars.end(), ' ');
   }
 
   void Console::setCharBackground(Vector2i position, const Color4f& color, ConsoleEffect effect) {
-    if (!m_data.isValid(position)) {
+    if (!m_chars.isValid(position)) {
       return;
     }
 
-    m_data(position).bg = computeColor(effect, m_data(position).bg, color);
+    if (effect.isDefault()) {
+      effect = m_effect;
+    }
+
+    applyConsoleEffect(effect, &m_backgrounds(position), 1, packConsoleColor(color));
   }
 
-  const Color4f& Console::getCharBackground(Vector2i position) const {
-    assert(m_data.isValid(position));
-    return m_data(position).bg;
+  Color4f Console::getCharBackground(Vector2i position) const {
+    assert(m_backgrounds.isValid(position));
+    return unpackConsoleColor(m_backgrounds(position));
   }
 
   void Console::setCharForeground(Vector2i position, const Color4f& color) {
-    if (!m_data.isValid(position)) {
+    if (!m_foregrounds.isValid(position)) {
       return;
     }
 
-    m_data(position).fg = color;
+    m_foregrounds(position) = packConsoleColor(color);
   }
 
-  const Color4f& Console::getCharForeground(Vector2i position) const {
-    assert(m_data.isValid(position));
-    return m_data(position).fg;
+  Color4f Console::getCharForeground(Vector2i position) const {
+    assert(m_foregrounds.isValid(position));
+    return unpackConsoleColor(m_foregrounds(position));
   }
 
   void Console::setChar(Vector2i position, char16_t c) {
-    if (!m_data.isValid(position)) {
+    if (!m_chars.isValid(position)) {
       return;
     }
 
-    m_data(position).c = c;
+    m_chars(position) = c;
   }
 
   char16_t Console::getChar(Vector2i position) const {
-    assert(m_data.isValid(position));
-    return m_data(position).c;
+    assert(m_chars.isValid(position));
+    return m_chars(position);
   }
 
   void Console::putChar(Vector2i position, char16_t c, ConsoleEffect effect) {
-    if (!m_data.isValid(position)) {
+    if (!m_chars.isValid(position)) {
       return;
     }
 
-    Cell& cell = m_data(position);
-    cell.fg = m_foreground;
-    cell.bg = computeColor(effect, m_data(position).bg, m_background);
-    cell.c = c;
+    if (effect.isDefault()) {
+      effect = m_effect;
+    }
+
+    m_foregrounds(position) = packConsoleColor(m_foreground);
+    applyConsoleEffect(effect, &m_backgrounds(position), 1, packConsoleColor(m_background));
+    m_chars(position) = c;
   }
 
   void Console::putChar(Vector2i position, char16_t c, const Color4f& foreground, const Color4f& background) {
-    if (!m_data.isValid(position)) {
+    if (!m_chars.isValid(position)) {
       return;
     }
 
-    m_data(position) = { foreground, background, c };
+    m_foregrounds(position) = packConsoleColor(foreground);
+    m_backgrounds(position) = packConsoleColor(background);
+    m_chars(position) = c;
   }
 
   int Console::putWord(Vector2i position, ConsoleEffect effect, StringRef message, const Color4f& foreground, const Color4f& background) {
@@ -380,9 +490,9 @@ inline namespace v1 {
     return width;
   }
 
-  int Console::printInternal(const RectI& rect, ConsoleEffect effect, ConsoleAlignment alignment, const std::string& message, Flags<PrintOption> flags) {
+  int Console::printInternal(const RectI& rect, ConsoleEffect effect, ConsoleAlignment alignment, StringRef message, Flags<PrintOption> flags) {
     // checks
-    Vector2i consoleSize = m_data.getSize();
+    Vector2i consoleSize = m_chars.getSize();
 
     if (rect.min.x < 0 || rect.min.y < 0 || rect.max.x > consoleSize.width || rect.max.y > consoleSize.height) {
       Log::warning("Position of console text is outside the console\n");
@@ -413,35 +523,42 @@ inline namespace v1 {
         }
       }
 
-      auto paragraphs = makeParagraphs(message, alignment, paragraphWidth);
       Vector2i position = rect.getPosition();
+      bool countOnly = flags.test(PrintOption::CountOnly);
 
-      for (const auto& paragraph : paragraphs) {
-        if (flags.test(PrintOption::CountOnly)) {
-          lineCount += paragraph.lines.size();
-        } else {
-          for (const auto& line : paragraph.lines) {
-            if (rect.min.y + lineCount >= rect.max.y) {
-              break;
-            }
+      StringRef remaining = message;
+      StringRef paragraph;
+      ConsoleLine line;
 
-            Vector2i localPosition = position;
-            localPosition.x += line.indent;
-            auto wordCount = line.words.size();
+      while (takeConsoleParagraph(remaining, paragraph)) {
+        while (takeConsoleLine(paragraph, alignment, paragraphWidth, line)) {
+          if (countOnly) {
+            ++lineCount;
+            continue;
+          }
 
-            for (auto word : line.words) {
-              localPosition.x += putWord(localPosition, effect, word, currentForeground, currentBackground);
-              wordCount--;
+          if (rect.min.y + lineCount >= rect.max.y) {
+            break;
+          }
+
+          Vector2i localPosition = position;
+          localPosition.x += line.indent;
 
-              if (wordCount > 0) {
-                putChar(localPosition, ' ', effect);
-                ++localPosition.x;
-              }
+          StringRef word;
+          bool first = true;
+
+          while (takeConsoleWord(line.words, word)) {
+            if (!first) {
+              putChar(localPosition, ' ', effect);
+              ++localPosition.x;
             }
 
-            ++lineCount;
-            ++position.y;
+            localPosition.x += putWord(localPosition, effect, word, currentForeground, currentBackground);
+            first = false;
           }
+
+          ++lineCount;
+          ++position.y;
         }
       }
 
@@ -477,7 +594,8 @@ inline namespace v1 {
   void Console::print(Vector2i position, const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
-    auto message = formatString(fmt, ap);
+    FormatBuffer buffer;
+    StringRef message = buffer.format(fmt, ap);
     va_end(ap);
 
     printInternal(RectI::fromPositionSize(position, { 0, 0 }), m_effect, m_alignment, message);
@@ -486,7 +604,8 @@ inline namespace v1 {
   void Console::print(Vector2i position, ConsoleEffect effect, ConsoleAlignment alignment, const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
-    auto message = formatString(fmt, ap);
+    FormatBuffer buffer;
+    StringRef message = buffer.format(fmt, ap);
     va_end(ap);
 
     printInternal(RectI::fromPositionSize(position, { 0, 0 }), effect, alignment, message);
@@ -495,31 +614,31 @@ inline namespace v1 {
   int Console::printRect(const RectI& rect, const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
-    auto message = formatString(fmt, ap);
+    FormatBuffer buffer;
+    StringRef message = buffer.format(fmt, ap);
     va_end(ap);
 
-    printInternal(rect, m_effect, m_alignment, message, PrintOption::Split);
-    return 0;
+    return printInternal(rect, m_effect, m_alignment, message, PrintOption::Split);
   }
 
   int Console::printRect(const RectI& rect, ConsoleEffect effect, ConsoleAlignment alignment, const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
-    auto message = formatString(fmt, ap);
+    FormatBuffer buffer;
+    StringRef message = buffer.format(fmt, ap);
     va_end(ap);
 
-    printInternal(rect, effect, alignment, message, PrintOption::Split);
-    return 0;
+    return printInternal(rect, effect, alignment, message, PrintOption::Split);
   }
 
   int Console::getHeight(const RectI& rect, const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
-    auto message = formatString(fmt, ap);
+    FormatBuffer buffer;
+    StringRef message = buffer.format(fmt, ap);
     va_end(ap);
 
-    printInternal(rect, m_effect, m_alignment, message, gf::Console::PrintOption::Split | gf::Console::PrintOption::CountOnly);
-    return 0;
+    return printInternal(rect, m_effect, m_alignment, message, gf::Console::PrintOption::Split | gf::Console::PrintOption::CountOnly);
   }
 
   void Console::setColorControl(ConsoleColorControl ctrl, const Color4f& foreground, const Color4f& background) {
@@ -530,19 +649,25 @@ inline namespace v1 {
   }
 
   void Console::drawRectangle(const RectI& rect, PrintAction action, ConsoleEffect effect) {
-    Vector2i position;
+    Vector2i min = gf::max(rect.min, Vector2i(0, 0));
+    Vector2i max = gf::min(rect.max, m_chars.getSize());
 
-    for (position.x = rect.min.x; position.x < rect.max.x; ++position.x) {
-      for (position.y = rect.min.y; position.y < rect.max.y; ++position.y) {
-        if (!m_data.isValid(position)) {
-          continue;
-        }
+    if (min.x >= max.x || min.y >= max.y) {
+      return;
+    }
+
+    if (effect.isDefault()) {
+      effect = m_effect;
+    }
 
-        setCharBackground(position, m_background, effect);
+    auto count = static_cast<std::size_t>(max.x - min.x);
+    Color4u background = packConsoleColor(m_background);
 
-        if (action == PrintAction::Clear) {
-          setChar(position, ' ');
-        }
+    for (int y = min.y; y < max.y; ++y) {
+      applyConsoleEffect(effect, &m_backgrounds({ min.x, y }), count, background);
+
+      if (action == PrintAction::Clear) {
+        std::fill_n(&m_chars({ min.x, y }), count, ' ');
       }
     }
   }
@@ -585,11 +710,12 @@ inline namespace v1 {
 
     va_list ap;
     va_start(ap, title);
-    auto message = formatString(title, ap);
+    FormatBuffer buffer;
+    buffer.format(title, ap);
     va_end(ap);
 
     std::swap(m_background, m_foreground);
-    print({ xWest + 1, yNorth }, ConsoleEffect::Set, ConsoleAlignment::Left, " %s ", message.c_str());
+    print({ xWest + 1, yNorth }, ConsoleEffect::Set, ConsoleAlignment::Left, " %s ", buffer.getData());
     std::swap(m_background, m_foreground);
   }
 
@@ -656,22 +782,42 @@ inline namespace v1 {
 
     // blit
 
-    Vector2i offset;
+    auto count = static_cast<std::size_t>(size.width);
+    unsigned foreground = packConsoleAlpha(foregroundAlpha);
+    unsigned background = packConsoleAlpha(backgroundAlpha);
 
-    for (offset.y = 0; offset.y < size.height; ++offset.y) {
-      for (offset.x = 0; offset.x < size.width; ++offset.x) {
-        assert(con.m_data.isValid(target + offset));
-        assert(m_data.isValid(origin + offset));
+    // when the console is blitted onto itself, the rows are traversed so
+    // that a source row is read before it is overwritten, and a row that is
+    // both a source and a destination is copied before it is blended
+    bool onItself = (&con == this);
+    bool bottomUp = onItself && target.y > origin.y;
+    bool sameRows = onItself && target.y == origin.y;
 
-        auto& targetCell = con.m_data(target + offset);
-        auto& originCell = m_data(origin + offset);
+    FrameArenaScope scope;
+    FrameVector<Color4u> sourceColors;
 
-        targetCell.bg = gf::lerp(targetCell.bg, originCell.bg, backgroundAlpha);
-        targetCell.fg = gf::lerp(targetCell.fg, originCell.fg, foregroundAlpha);
-        targetCell.c = originCell.c;
+    for (int i = 0; i < size.height; ++i) {
+      int y = bottomUp ? size.height - 1 - i : i;
+      Vector2i from(origin.x, origin.y + y);
+      Vector2i to(target.x, target.y + y);
+
+      assert(m_chars.isValid(from) && m_chars.isValid(from + Vector2i(size.width - 1, 0)));
+      assert(con.m_chars.isValid(to) && con.m_chars.isValid(to + Vector2i(size.width - 1, 0)));
+
+      const Color4u *backgrounds = &m_backgrounds(from);
+      const Color4u *foregrounds = &m_foregrounds(from);
+
+      if (sameRows) {
+        sourceColors.assign(backgrounds, backgrounds + count);
+        sourceColors.insert(sourceColors.end(), foregrounds, foregrounds + count);
+        backgrounds = sourceColors.data();
+        foregrounds = sourceColors.data() + count;
       }
-    }
 
+      lerpConsoleRow(&con.m_backgrounds(to), backgrounds, count, background);
+      lerpConsoleRow(&con.m_foregrounds(to), foregrounds, count, foreground);
+      std::memmove(&con.m_chars(to), &m_chars(from), count * sizeof(char16_t));
+    }
   }
 
   void Console::draw(RenderTarget& target, const RenderStates& states) {
@@ -679,26 +825,27 @@ inline namespace v1 {
       return;
     }
 
-    auto consoleSize = m_data.getSize();
+    auto consoleSize = m_chars.getSize();
+    auto vertexCount = static_cast<std::size_t>(consoleSize.width) * static_cast<std::size_t>(consoleSize.height) * 6;
 
-    VertexArray backgroundVertices(PrimitiveType::Triangles);
-    backgroundVertices.reserve(static_cast<std::size_t>(consoleSize.width) * static_cast<std::size_t>(consoleSize.height) * 6);
+    FrameArenaScope scope;
 
-    VertexArray foregroundVertices(PrimitiveType::Triangles);
-    foregroundVertices.reserve(static_cast<std::size_t>(consoleSize.width) * static_cast<std::size_t>(consoleSize.height) * 6);
+    FrameVector<Vertex> backgroundVertices;
+    backgroundVertices.reserve(vertexCount);
+
+    FrameVector<Vertex> foregroundVertices;
+    foregroundVertices.reserve(vertexCount);
 
     Color4f color;
     auto characterSize = m_font->getCharacterSize();
 
-    for (auto position : m_data.getPositionRange()) {
-      const auto& data = m_data(position);
-
+    for (auto position : m_chars.getPositionRange()) {
       Vertex vertices[4];
 
-      if (m_fadingAmount == 1.0f) {
-        color = data.bg;
-      } else {
-        color = gf::lerp(m_fadingColor, data.bg, m_fadingAmount);
+      color = unpackConsoleColor(m_backgrounds(position));
+
+      if (m_fadingAmount != 1.0f) {
+        color = gf::lerp(m_fadingColor, color, m_fadingAmount);
       }
 
       vertices[0].color = vertices[1].color = vertices[2].color = vertices[3].color = color;
@@ -710,46 +857,46 @@ inline namespace v1 {
       vertices[2].position = rect.getBottomLeft();
       vertices[3].position = rect.getBottomRight();
 
-      backgroundVertices.append(vertices[0]);
-      backgroundVertices.append(vertices[1]);
-      backgroundVertices.append(vertices[2]);
+      backgroundVertices.push_back(vertices[0]);
+      backgroundVertices.push_back(vertices[1]);
+      backgroundVertices.push_back(vertices[2]);
+
+      backgroundVertices.push_back(vertices[2]);
+      backgroundVertices.push_back(vertices[1]);
+      backgroundVertices.push_back(vertices[3]);
 
-      backgroundVertices.append(vertices[2]);
-      backgroundVertices.append(vertices[1]);
-      backgroundVertices.append(vertices[3]);
+      color = unpackConsoleColor(m_foregrounds(position));
 
-      if (m_fadingAmount == 1.0f) {
-        color = data.fg;
-      } else {
-        color = gf::lerp(m_fadingColor, data.fg, m_fadingAmount);
+      if (m_fadingAmount != 1.0f) {
+        color = gf::lerp(m_fadingColor, color, m_fadingAmount);
       }
 
       vertices[0].color = vertices[1].color = vertices[2].color = vertices[3].color = color;
 
       // same positions
 
-      RectF textureRect = m_font->getTextureRect(data.c);
+      RectF textureRect = m_font->getTextureRect(m_chars(position));
       vertices[0].texCoords = textureRect.getTopLeft();
       vertices[1].texCoords = textureRect.getTopRight();
       vertices[2].texCoords = textureRect.getBottomLeft();
       vertices[3].texCoords = textureRect.getBottomRight();
 
-      foregroundVertices.append(vertices[0]);
-      foregroundVertices.append(vertices[1]);
-      foregroundVertices.append(vertices[2]);
+      foregroundVertices.push_back(vertices[0]);
+      foregroundVertices.push_back(vertices[1]);
+      foregroundVertices.push_back(vertices[2]);
 
-      foregroundVertices.append(vertices[2]);
-      foregroundVertices.append(vertices[1]);
-      foregroundVertices.append(vertices[3]);
+      foregroundVertices.push_back(vertices[2]);
+      foregroundVertices.push_back(vertices[1]);
+      foregroundVertices.push_back(vertices[3]);
     }
 
     RenderStates localStates = states;
 
     localStates.transform *= getTransform();
-    target.draw(backgroundVertices, localStates);
+    target.draw(backgroundVertices.data(), backgroundVertices.size(), PrimitiveType::Triangles, localStates);
 
     localStates.texture[0] = m_font->getTexture();
-    target.draw(foregroundVertices, localStates);
+    target.draw(foregroundVertices.data(), foregroundVertices.size(), PrimitiveType::Triangles, localStates);
   }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
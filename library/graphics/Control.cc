@@ -20,6 +20,8 @@
  */
 #include <gf/Control.h>
 
+#include <gf/Unused.h>
+
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
@@ -27,6 +29,11 @@ inline namespace v1 {
 
   Control::~Control() = default;
 
+  bool Control::getRoute(ControlRoute& route) const {
+    gf::unused(route);
+    return false;
+  }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
@@ -50,6 +50,11 @@ inline namespace v1 {
     }
   }
 
+  bool KeycodeKeyControl::getRoute(ControlRoute& route) const {
+    route = { ControlRouteKind::Keycode, 0, static_cast<int32_t>(m_code) };
+    return true;
+  }
+
   // scancode key control
 
   ScancodeKeyControl::ScancodeKeyControl(Scancode code)
@@ -71,6 +76,11 @@ inline namespace v1 {
     }
   }
 
+  bool ScancodeKeyControl::getRoute(ControlRoute& route) const {
+    route = { ControlRouteKind::Scancode, 0, static_cast<int32_t>(m_code) };
+    return true;
+  }
+
   // mouse button control
 
   MouseButtonControl::MouseButtonControl(MouseButton button)
@@ -92,6 +102,11 @@ inline namespace v1 {
     }
   }
 
+  bool MouseButtonControl::getRoute(ControlRoute& route) const {
+    route = { ControlRouteKind::MouseButton, 0, static_cast<int32_t>(m_button) };
+    return true;
+  }
+
   // gamepad button control
 
   GamepadButtonControl::GamepadButtonControl(GamepadId id, GamepadButton button)
@@ -114,6 +129,11 @@ inline namespace v1 {
     }
   }
 
+  bool GamepadButtonControl::getRoute(ControlRoute& route) const {
+    route = { ControlRouteKind::GamepadButton, static_cast<int32_t>(m_id), static_cast<int32_t>(m_button) };
+    return true;
+  }
+
   // gamepad axis control
 
   GamepadAxisControl::GamepadAxisControl(GamepadId id, GamepadAxis axis, GamepadAxisDirection dir)
@@ -159,6 +179,11 @@ inline namespace v1 {
     }
   }
 
+  bool GamepadAxisControl::getRoute(ControlRoute& route) const {
+    route = { ControlRouteKind::GamepadAxis, static_cast<int32_t>(m_id), static_cast<int32_t>(m_axis) };
+    return true;
+  }
+
 
   // close control
 
@@ -172,6 +197,11 @@ inline namespace v1 {
     }
   }
 
+  bool CloseControl::getRoute(ControlRoute& route) const {
+    route = { ControlRouteKind::Close, 0, 0 };
+    return true;
+  }
+
 
   // konami control
 
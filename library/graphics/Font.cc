@@ -31,6 +31,7 @@
 #include FT_FREETYPE_H
 #include FT_STROKER_H
 
+#include <gf/FrameArena.h>
 #include <gf/Stream.h>
 #include <gf/Log.h>
 #include <gf/Unused.h>
@@ -426,7 +427,8 @@ inline namespace v1 {
 
     auto size = rect.getSize();
 
-    std::vector<uint8_t> paddedBuffer(static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height), 0);
+    FrameArenaScope scope;
+    FrameVector<uint8_t> paddedBuffer(static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height), 0);
     const uint8_t *sourceBuffer = bglyph->bitmap.buffer;
 
     for (int y = Padding; y < size.height - Padding; ++y) {
@@ -0,0 +1,356 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/GpuNoises.h>
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <gf/Image.h>
+#include <gf/Log.h>
+#include <gf/Math.h>
+#include <gf/Noises.h>
+#include <gf/RenderTarget.h>
+#include <gf/Vertex.h>
+#include <gf/VectorOps.h>
+#include <gf/View.h>
+
+#include "generated/default.vert.h"
+#include "generated/gradient_noise.frag.h"
+#include "generated/simplex_noise.frag.h"
+#include "generated/worley_noise.frag.h"
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    constexpr int GpuNoiseLatticeSize = 256;
+    constexpr int GpuNoiseMaxOctaves = 16;
+    constexpr std::size_t GpuNoiseMaxCells = 1024;
+    constexpr std::size_t GpuNoiseMaxCoeffs = 4;
+    constexpr int GpuNoiseCellsPerRow = 256;
+
+    // 16 bits per coordinate in [-2, 2], see decodeVector() in the shaders
+    void encodeGpuNoiseVector(Vector2d vec, uint8_t *texel) {
+      for (std::size_t i = 0; i < 2; ++i) {
+        assert(-2.0 <= vec[i] && vec[i] <= 2.0);
+        double normalized = (gf::clamp(vec[i], -2.0, 2.0) + 2.0) / 4.0;
+        auto quantized = static_cast<unsigned>(std::lround(normalized * 65535.0));
+        texel[2 * i] = static_cast<uint8_t>(quantized >> 8);
+        texel[2 * i + 1] = static_cast<uint8_t>(quantized & 0xFF);
+      }
+    }
+
+    template<typename Noise>
+    Texture createGpuNoiseLattice(const Noise& noise) {
+      std::vector<uint8_t> data(GpuNoiseLatticeSize * GpuNoiseLatticeSize * 4);
+
+      for (int j = 0; j < GpuNoiseLatticeSize; ++j) {
+        for (int i = 0; i < GpuNoiseLatticeSize; ++i) {
+          auto gradient = noise.getGradient(static_cast<uint8_t>(i), static_cast<uint8_t>(j));
+          encodeGpuNoiseVector(gradient, &data[(j * GpuNoiseLatticeSize + i) * 4]);
+        }
+      }
+
+      Texture texture(Image({ GpuNoiseLatticeSize, GpuNoiseLatticeSize }, data.data()));
+      texture.setSmooth(false);
+      texture.setRepeated(true);
+      return texture;
+    }
+
+    int getGpuNoiseStep(Step<double> step) {
+      if (step == gf::linearStep<double>) {
+        return 0;
+      }
+
+      if (step == gf::cubicStep<double>) {
+        return 1;
+      }
+
+      if (step == gf::quinticStep<double>) {
+        return 2;
+      }
+
+      if (step == gf::cosineStep<double>) {
+        return 3;
+      }
+
+      Log::error("Unsupported step for a GPU noise.\n");
+      throw std::runtime_error("Unsupported step for a GPU noise.");
+    }
+
+    int getGpuNoiseDistance(Distance2<double> distance) {
+      if (distance == gf::manhattanDistance<double, 2>) {
+        return 0;
+      }
+
+      if (distance == gf::squareDistance<double, 2>) {
+        return 1;
+      }
+
+      if (distance == gf::euclideanDistance<double, 2>) {
+        return 2;
+      }
+
+      if (distance == gf::chebyshevDistance<double, 2>) {
+        return 3;
+      }
+
+      if (distance == gf::naturalDistance<double, 2>) {
+        return 4;
+      }
+
+      Log::error("Unsupported distance for a GPU noise.\n");
+      throw std::runtime_error("Unsupported distance for a GPU noise.");
+    }
+
+  }
+
+  /*
+   * GpuNoise2D
+   */
+
+  GpuNoise2D::GpuNoise2D()
+  : m_min(-1.0f)
+  , m_max(1.0f)
+  , m_encoding(GpuNoiseEncoding::Grayscale)
+  {
+  }
+
+  GpuNoise2D::~GpuNoise2D() = default;
+
+  void GpuNoise2D::setValueRange(float min, float max) {
+    assert(min < max);
+    m_min = min;
+    m_max = max;
+  }
+
+  void GpuNoise2D::render(RenderTarget& target, const RectF& area) {
+    Shader& shader = getShader();
+    Octaves octaves = getOctaves();
+
+    shader.setUniform("u_scale", octaves.scale);
+    shader.setUniform("u_octaves", octaves.count);
+    shader.setUniform("u_lacunarity", octaves.lacunarity);
+    shader.setUniform("u_persistence", octaves.persistence);
+    shader.setUniform("u_dimension", octaves.dimension);
+    shader.setUniform("u_valueRange", Vector2f(m_min, m_max));
+    shader.setUniform("u_encoding", m_encoding == GpuNoiseEncoding::Packed ? 1 : 0);
+
+    Vector2f size = target.getSize();
+    Vector2f pixel = area.getSize() / size;
+
+    // the center of pixel (i, j) gets the noise at area.min + (i, j) * pixel
+    Vertex vertices[4];
+    vertices[0].position = { 0.0f, 0.0f };
+    vertices[1].position = { size.width, 0.0f };
+    vertices[2].position = { 0.0f, size.height };
+    vertices[3].position = size;
+
+    for (auto& vertex : vertices) {
+      vertex.texCoords = area.min + vertex.position * pixel - pixel / 2;
+    }
+
+    View previousView = target.getView();
+    target.setView(View(RectF::fromPositionSize({ 0.0f, 0.0f }, size)));
+
+    RenderStates states;
+    states.mode = BlendNone;
+    states.shader = &shader;
+    target.draw(vertices, 4, PrimitiveType::TriangleStrip, states);
+
+    target.setView(previousView);
+  }
+
+  Heightmap GpuNoise2D::decode(const Image& image) const {
+    Vector2i size = image.getSize();
+    Heightmap heightmap(size);
+
+    double range = static_cast<double>(m_max) - static_cast<double>(m_min);
+
+    for (int y = 0; y < size.height; ++y) {
+      for (int x = 0; x < size.width; ++x) {
+        Color4u pixel = image.getPixel({ x, y });
+        double normalized = 0.0;
+
+        switch (m_encoding) {
+          case GpuNoiseEncoding::Grayscale:
+            normalized = pixel.r / 255.0;
+            break;
+          case GpuNoiseEncoding::Packed:
+            normalized = (pixel.r * 256 + pixel.g) / 65535.0;
+            break;
+        }
+
+        heightmap.setValue({ x, y }, m_min + normalized * range);
+      }
+    }
+
+    return heightmap;
+  }
+
+  GpuNoise2D::Octaves GpuNoise2D::getOctaves() const {
+    return Octaves();
+  }
+
+  /*
+   * GpuGradientNoise2D
+   */
+
+  GpuGradientNoise2D::GpuGradientNoise2D(const GradientNoise2D& noise)
+  : m_shader(default_vert, gradient_noise_frag)
+  , m_lattice(createGpuNoiseLattice(noise))
+  {
+    m_shader.setUniform("u_lattice", m_lattice);
+    m_shader.setUniform("u_step", getGpuNoiseStep(noise.getStep()));
+  }
+
+  Shader& GpuGradientNoise2D::getShader() {
+    return m_shader;
+  }
+
+  /*
+   * GpuSimplexNoise2D
+   */
+
+  GpuSimplexNoise2D::GpuSimplexNoise2D(const SimplexNoise2D& noise)
+  : m_shader(default_vert, simplex_noise_frag)
+  , m_lattice(createGpuNoiseLattice(noise))
+  {
+    m_shader.setUniform("u_lattice", m_lattice);
+  }
+
+  Shader& GpuSimplexNoise2D::getShader() {
+    return m_shader;
+  }
+
+  /*
+   * GpuWorleyNoise2D
+   */
+
+  GpuWorleyNoise2D::GpuWorleyNoise2D(const WorleyNoise2D& noise)
+  : m_shader(default_vert, worley_noise_frag)
+  {
+    const auto& cells = noise.getCells();
+    const auto& coeffs = noise.getCoefficients();
+
+    if (cells.size() > GpuNoiseMaxCells || coeffs.size() > GpuNoiseMaxCoeffs) {
+      Log::error("Too many points or coefficients for a GPU Worley noise: %zu, %zu\n", cells.size(), coeffs.size());
+      throw std::runtime_error("Too many points or coefficients for a GPU Worley noise");
+    }
+
+    int count = static_cast<int>(cells.size());
+    Vector2i size(std::max(std::min(count, GpuNoiseCellsPerRow), 1), std::max((count + GpuNoiseCellsPerRow - 1) / GpuNoiseCellsPerRow, 1));
+    std::vector<uint8_t> data(static_cast<std::size_t>(size.width * size.height) * 4, 0);
+
+    for (int i = 0; i < count; ++i) {
+      encodeGpuNoiseVector(cells[i], &data[i * 4]);
+    }
+
+    m_cells = Texture(Image(size, data.data()));
+    m_cells.setSmooth(false);
+
+    Vector4f coefficients(0.0f, 0.0f, 0.0f, 0.0f);
+
+    for (std::size_t i = 0; i < coeffs.size(); ++i) {
+      coefficients[i] = static_cast<float>(coeffs[i]);
+    }
+
+    m_shader.setUniform("u_cells", m_cells);
+    m_shader.setUniform("u_cellsSize", Vector2f(size));
+    m_shader.setUniform("u_cellCount", count);
+    m_shader.setUniform("u_coeffs", coefficients);
+    m_shader.setUniform("u_distance", getGpuNoiseDistance(noise.getDistance()));
+  }
+
+  Shader& GpuWorleyNoise2D::getShader() {
+    return m_shader;
+  }
+
+  /*
+   * GpuFractalNoise2D
+   */
+
+  GpuFractalNoise2D::GpuFractalNoise2D(GpuNoise2D& noise, double scale, std::size_t octaves, double lacunarity, double persistence, double dimension)
+  : m_noise(noise)
+  {
+    if (getOctavesOf(noise).count != 1) {
+      Log::error("The basic noise of a GPU fractal noise can not be fractal.\n");
+      throw std::runtime_error("The basic noise of a GPU fractal noise can not be fractal.");
+    }
+
+    if (octaves > GpuNoiseMaxOctaves) {
+      Log::warning("Too many octaves for a GPU fractal noise: %zu, only %i are computed\n", octaves, GpuNoiseMaxOctaves);
+      octaves = GpuNoiseMaxOctaves;
+    }
+
+    m_octaves.scale = static_cast<float>(scale);
+    m_octaves.count = static_cast<int>(octaves);
+    m_octaves.lacunarity = static_cast<float>(lacunarity);
+    m_octaves.persistence = static_cast<float>(persistence);
+    m_octaves.dimension = static_cast<float>(dimension);
+  }
+
+  GpuFractalNoise2D::GpuFractalNoise2D(GpuNoise2D& noise, const FractalNoise2D& fractal)
+  : GpuFractalNoise2D(noise, fractal.getScale(), fractal.getOctaves(), fractal.getLacunarity(), fractal.getPersistence(), fractal.getDimension())
+  {
+  }
+
+  Shader& GpuFractalNoise2D::getShader() {
+    return getShaderOf(m_noise);
+  }
+
+  GpuNoise2D::Octaves GpuFractalNoise2D::getOctaves() const {
+    return m_octaves;
+  }
+
+  /*
+   * GpuPerlinNoise2D
+   */
+
+  GpuPerlinNoise2D::GpuPerlinNoise2D(const PerlinNoise2D& noise)
+  : m_gradient(noise.getGradientNoise())
+  {
+    const FractalNoise2D& fractal = noise.getFractalNoise();
+    m_octaves.scale = static_cast<float>(fractal.getScale());
+    m_octaves.count = static_cast<int>(std::min(fractal.getOctaves(), static_cast<std::size_t>(GpuNoiseMaxOctaves)));
+    m_octaves.lacunarity = static_cast<float>(fractal.getLacunarity());
+    m_octaves.persistence = static_cast<float>(fractal.getPersistence());
+    m_octaves.dimension = static_cast<float>(fractal.getDimension());
+  }
+
+  Shader& GpuPerlinNoise2D::getShader() {
+    return getShaderOf(m_gradient);
+  }
+
+  GpuNoise2D::Octaves GpuPerlinNoise2D::getOctaves() const {
+    return m_octaves;
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
@@ -20,6 +20,8 @@
  */
 #include <gf/Grid.h>
 
+#include <cmath>
+
 #include <gf/RenderTarget.h>
 
 #include <gf/Stagger.h>
@@ -27,16 +29,50 @@
 
 #include <gf/Log.h>
 
+#include "generated/default.vert.h"
+#include "generated/hexagon_grid.frag.h"
+#include "generated/square_grid.frag.h"
+
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
 
+  namespace {
+
+    // size of a pixel in local coordinates, along the local axes
+    Vector2f computeGridPixelSize(const RenderTarget& target, const Matrix3f& transform) {
+      Matrix3f mat = target.getView().getTransform() * transform;
+      Vector2f viewportSize = target.getViewport(target.getView()).getSize();
+      Vector2f axisX(mat(0, 0) * viewportSize.width / 2, mat(1, 0) * viewportSize.height / 2);
+      Vector2f axisY(mat(0, 1) * viewportSize.width / 2, mat(1, 1) * viewportSize.height / 2);
+      return { 1.0f / gf::euclideanLength(axisX), 1.0f / gf::euclideanLength(axisY) };
+    }
+
+    // a quad on the bounds, with the local coordinates in the texture coordinates
+    void drawGridQuad(RenderTarget& target, const RenderStates& states, const RectF& bounds, const Color4f& color, bool swapped) {
+      Vertex vertices[4];
+      vertices[0].position = bounds.getTopLeft();
+      vertices[1].position = bounds.getTopRight();
+      vertices[2].position = bounds.getBottomLeft();
+      vertices[3].position = bounds.getBottomRight();
+
+      for (auto& vertex : vertices) {
+        vertex.color = color;
+        vertex.texCoords = swapped ? gf::vec(vertex.position.y, vertex.position.x) : vertex.position;
+      }
+
+      target.draw(vertices, 4, PrimitiveType::TriangleStrip, states);
+    }
+
+  }
+
   SquareGrid::SquareGrid(Vector2i gridSize, Vector2f cellSize, const Color4f& color, float lineWidth)
   : m_gridSize(gridSize)
   , m_cellSize(cellSize)
   , m_color(color)
   , m_lineWidth(lineWidth)
+  , m_mode(GridMode::Geometry)
   , m_vertices(PrimitiveType::Lines)
   {
     updateGeometry();
@@ -61,6 +97,11 @@ inline namespace v1 {
     }
   }
 
+  void SquareGrid::setMode(GridMode mode) {
+    m_mode = mode;
+    updateGeometry();
+  }
+
   RectF SquareGrid::getLocalBounds() const {
     return RectF::fromPositionSize({ 0.0f, 0.0f }, m_gridSize * m_cellSize);
   }
@@ -76,12 +117,35 @@ inline namespace v1 {
   void SquareGrid::draw(RenderTarget& target, const RenderStates& states) {
     RenderStates localStates = states;
     localStates.transform *= getTransform();
-    localStates.lineWidth = m_lineWidth;
-    target.draw(m_vertices, localStates);
+
+    if (m_mode == GridMode::Geometry) {
+      localStates.lineWidth = m_lineWidth;
+      target.draw(m_vertices, localStates);
+      return;
+    }
+
+    if (!m_shader) {
+      m_shader = std::make_shared<Shader>(default_vert, square_grid_frag);
+    }
+
+    Vector2f pixelSize = computeGridPixelSize(target, localStates.transform);
+    m_shader->setUniform("u_cellSize", m_cellSize);
+    m_shader->setUniform("u_pixelSize", pixelSize);
+    m_shader->setUniform("u_lineWidth", m_lineWidth);
+    localStates.shader = m_shader.get();
+
+    // enlarge the quad so that the border lines are entirely drawn
+    Vector2f margin = m_lineWidth * pixelSize;
+    RectF bounds = getLocalBounds();
+    drawGridQuad(target, localStates, RectF::fromMinMax(bounds.min - margin, bounds.max + margin), m_color, false);
   }
 
   void SquareGrid::updateGeometry() {
     m_vertices.clear();
+
+    if (m_mode == GridMode::Procedural) {
+      return;
+    }
     Vector2f max = m_gridSize * m_cellSize;
 
     Vertex vertices[2];
@@ -113,6 +177,7 @@ inline namespace v1 {
   , m_helper(axis, index)
   , m_color(color)
   , m_lineWidth(lineWidth)
+  , m_mode(GridMode::Geometry)
   , m_vertices(PrimitiveType::Lines)
   {
     updateGeometry();
@@ -137,6 +202,11 @@ inline namespace v1 {
     }
   }
 
+  void HexagonGrid::setMode(GridMode mode) {
+    m_mode = mode;
+    updateGeometry();
+  }
+
   RectF HexagonGrid::getLocalBounds() const {
     auto bounds = m_helper.computeBounds(m_gridSize, m_radius);
     return RectF::fromPositionSize({ -m_lineWidth, -m_lineWidth }, bounds.getSize() + 2.0f * m_lineWidth);
@@ -153,21 +223,52 @@ inline namespace v1 {
   void HexagonGrid::draw(RenderTarget& target, const RenderStates& states) {
     RenderStates localStates = states;
     localStates.transform *= getTransform();
-    localStates.lineWidth = m_lineWidth;
-    target.draw(m_vertices, localStates);
+
+    if (m_mode == GridMode::Geometry) {
+      localStates.lineWidth = m_lineWidth;
+      target.draw(m_vertices, localStates);
+      return;
+    }
+
+    if (!m_shader) {
+      m_shader = std::make_shared<Shader>(default_vert, hexagon_grid_frag);
+    }
+
+    // the shader works with pointy hexagons, the coordinates of flat hexagons are swapped
+    bool swapped = (m_helper.getAxis() == MapCellAxis::Y);
+    Vector2f gridSize = swapped ? gf::vec(m_gridSize.height, m_gridSize.width) : gf::vec(m_gridSize.width, m_gridSize.height);
+    Vector2f pixelSize = computeGridPixelSize(target, localStates.transform);
+
+    m_shader->setUniform("u_radius", m_radius);
+    m_shader->setUniform("u_parity", m_helper.getIndex() == MapCellIndex::Odd ? 0.0f : 1.0f);
+    m_shader->setUniform("u_gridSize", gridSize);
+    m_shader->setUniform("u_pixelSize", (pixelSize.x + pixelSize.y) / 2);
+    m_shader->setUniform("u_lineWidth", m_lineWidth);
+    localStates.shader = m_shader.get();
+
+    // enlarge the quad so that the border lines are entirely drawn
+    Vector2f margin = m_lineWidth * pixelSize;
+    RectF bounds = m_helper.computeBounds(m_gridSize, m_radius);
+    drawGridQuad(target, localStates, RectF::fromMinMax(bounds.min - margin, bounds.max + margin), m_color, swapped);
   }
 
   void HexagonGrid::updateGeometry() {
     m_vertices.clear();
 
+    if (m_mode == GridMode::Procedural) {
+      return;
+    }
+
     Vertex vertices[2];
     vertices[0].color = vertices[1].color = m_color;
 
+    Vector2f corners[6];
+
     for (int i = 0; i < m_gridSize.width; ++i) {
       for (int j = 0; j < m_gridSize.height; ++j) {
-        auto corners = m_helper.computeCorners({ i, j }, m_radius);
+        m_helper.computeCorners({ i, j }, m_radius, corners);
 
-        for (unsigned k = 0; k < corners.size() - 1; ++k) {
+        for (unsigned k = 0; k < 5; ++k) {
           vertices[0].position = corners[k];
           vertices[1].position = corners[k + 1];
           m_vertices.append(vertices[0]);
@@ -0,0 +1,131 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/HeadlessContext.h>
+
+#include <SDL.h>
+
+#include <gf/Log.h>
+#include <gf/Shader.h>
+#include <gf/VertexBuffer.h>
+
+#include <gfpriv/GlDebug.h>
+#include <gfpriv/GlFwd.h>
+#include <gfpriv/SdlDebug.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  HeadlessContext::HeadlessContext(Vector2i size)
+  : m_window(nullptr)
+  , m_context(nullptr)
+  , m_vao(0)
+  {
+    m_window = SDL_CHECK_EXPR(SDL_CreateWindow("gf headless context", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, size.width, size.height, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN));
+
+    if (m_window == nullptr) {
+      Log::error("Failed to create a headless surface: %s\n", SDL_GetError());
+      return;
+    }
+
+    // the context must not share its objects, so that it can be used in parallel with other contexts
+    SDL_CHECK(SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0));
+    m_context = SDL_CHECK_EXPR(SDL_GL_CreateContext(m_window));
+
+    if (m_context == nullptr) {
+      Log::error("Failed to create a headless context: %s\n", SDL_GetError());
+      return;
+    }
+
+    int err = SDL_CHECK_EXPR(SDL_GL_MakeCurrent(m_window, m_context));
+
+    if (err != 0) {
+      Log::error("Failed to make the headless context current: %s\n", SDL_GetError());
+    }
+
+#ifndef __APPLE__
+#ifdef GF_OPENGL3
+    if (gladLoadGLLoader(SDL_GL_GetProcAddress) == 0) {
+      Log::error("Failed to load GL3.\n");
+    }
+#else
+    if (gladLoadGLES2Loader(SDL_GL_GetProcAddress) == 0) {
+      Log::error("Failed to load GLES2.\n");
+    }
+#endif
+#endif
+
+    GL_CHECK(glEnable(GL_BLEND));
+    GL_CHECK(glEnable(GL_SCISSOR_TEST));
+
+#ifdef GF_OPENGL3
+    GL_CHECK(glGenVertexArrays(1, &m_vao));
+    GL_CHECK(glBindVertexArray(m_vao));
+#endif
+
+    VertexBuffer::setDefaultVertexArray(m_vao);
+  }
+
+  HeadlessContext::~HeadlessContext() {
+    if (m_context != nullptr) {
+      setActive();
+
+#ifdef GF_OPENGL3
+      GL_CHECK(glBindVertexArray(0));
+      GL_CHECK(glDeleteVertexArrays(1, &m_vao));
+#endif
+
+      setActive(false);
+      Shader::releaseSharedPrograms(m_context);
+      SDL_CHECK(SDL_GL_DeleteContext(m_context));
+    }
+
+    if (m_window != nullptr) {
+      SDL_CHECK(SDL_DestroyWindow(m_window));
+    }
+  }
+
+  void HeadlessContext::setActive(bool active) {
+    if (m_context == nullptr) {
+      return;
+    }
+
+    if (active) {
+      if (SDL_CHECK_EXPR(SDL_GL_GetCurrentContext()) != m_context) {
+        SDL_CHECK(SDL_GL_MakeCurrent(m_window, m_context));
+      }
+
+      VertexBuffer::setDefaultVertexArray(m_vao);
+    } else {
+      SDL_CHECK(SDL_GL_MakeCurrent(m_window, nullptr));
+      VertexBuffer::setDefaultVertexArray(0);
+    }
+  }
+
+  void HeadlessContext::selectOffscreenDriver() {
+    SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
@@ -0,0 +1,95 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/MemoryOverlay.h>
+
+#include <gf/MemoryStats.h>
+#include <gf/RenderTarget.h>
+#include <gf/StringUtils.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    std::string formatMemorySize(std::size_t size) {
+      if (size < 1024) {
+        return formatString("%zu B", size);
+      }
+
+      if (size < 1024 * 1024) {
+        return formatString("%.1f KiB", size / 1024.0);
+      }
+
+      return formatString("%.1f MiB", size / (1024.0 * 1024.0));
+    }
+
+    std::string formatMemoryUsage(const char *name, const MemoryUsage& usage) {
+      return formatString("%-14s %12s %12s %10llu\n", name, formatMemorySize(usage.liveBytes).c_str(), formatMemorySize(usage.peakBytes).c_str(), static_cast<unsigned long long>(usage.allocationCount));
+    }
+
+  }
+
+  MemoryOverlay::MemoryOverlay(Font& font, unsigned characterSize)
+  : m_text("", font, characterSize)
+  , m_period(seconds(0.5f))
+  , m_elapsed(Time::zero())
+  {
+    m_text.setColor(Color::White);
+    m_text.setOutlineColor(Color::Black);
+    m_text.setOutlineThickness(1.0f);
+    refresh();
+  }
+
+  void MemoryOverlay::update(Time time) {
+    m_elapsed += time;
+
+    if (m_elapsed < m_period) {
+      return;
+    }
+
+    m_elapsed = Time::zero();
+    refresh();
+  }
+
+  void MemoryOverlay::refresh() {
+    std::string str = formatString("%-14s %12s %12s %10s\n", "Memory", "live", "peak", "allocs");
+
+    for (std::size_t i = 0; i < MemoryTagCount; ++i) {
+      auto tag = static_cast<MemoryTag>(i);
+      str += formatMemoryUsage(MemoryStats::getTagName(tag), MemoryStats::getUsage(tag));
+    }
+
+    str += formatMemoryUsage("Total", MemoryStats::getTotalUsage());
+    m_text.setString(std::move(str));
+  }
+
+  void MemoryOverlay::draw(RenderTarget& target, const RenderStates& states) {
+    RenderStates localStates = states;
+    localStates.transform *= getTransform();
+    m_text.draw(target, localStates);
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
@@ -0,0 +1,174 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/PixelReadback.h>
+
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+#include <gf/Log.h>
+#include <gf/RenderTexture.h>
+
+#include <gfpriv/GlDebug.h>
+#include <gfpriv/GlFwd.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+#ifdef GF_OPENGL3
+  namespace {
+
+    constexpr GLuint64 ReadbackWaitTimeout = 1000000000; // 1s, in nanoseconds
+
+  }
+#endif
+
+  PixelReadback::PixelReadback()
+#ifdef GF_OPENGL3
+  : m_buffer()
+#else
+  : m_buffer(gf::None)
+#endif
+  , m_fence(nullptr)
+  , m_size(0, 0)
+  , m_capacity(0)
+  , m_pending(false)
+  {
+  }
+
+  PixelReadback::~PixelReadback() {
+    discard();
+  }
+
+  void PixelReadback::request(RenderTexture& texture) {
+    discard();
+
+    m_size = texture.getSize();
+    std::size_t bytes = static_cast<std::size_t>(m_size.width) * static_cast<std::size_t>(m_size.height) * 4;
+
+    GLint boundFrameBuffer;
+    GL_CHECK(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFrameBuffer));
+    texture.setActive();
+
+#ifdef GF_OPENGL3
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer));
+
+    if (bytes > m_capacity) {
+      GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ));
+      m_capacity = bytes;
+    }
+
+    GL_CHECK(glReadPixels(0, 0, m_size.width, m_size.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    GLsync fence;
+    GL_CHECK(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    m_fence = fence;
+#else
+    // no pixel buffer in OpenGL ES 2.0, the copy is synchronous
+    std::vector<uint8_t> pixels(bytes);
+    GL_CHECK(glReadPixels(0, 0, m_size.width, m_size.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+    m_image = Image(m_size, pixels.data());
+#endif
+
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, boundFrameBuffer));
+    m_pending = true;
+  }
+
+  bool PixelReadback::isReady() {
+    if (!m_pending) {
+      return false;
+    }
+
+#ifdef GF_OPENGL3
+    assert(m_fence != nullptr);
+    GLenum status;
+    GL_CHECK(status = glClientWaitSync(static_cast<GLsync>(m_fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+#else
+    return true;
+#endif
+  }
+
+  Image PixelReadback::retrieve() {
+    if (!m_pending) {
+      Log::error("No pending read back to retrieve.\n");
+      throw std::runtime_error("No pending read back to retrieve.");
+    }
+
+#ifdef GF_OPENGL3
+    assert(m_fence != nullptr);
+    GLenum status;
+
+    do {
+      GL_CHECK(status = glClientWaitSync(static_cast<GLsync>(m_fence), GL_SYNC_FLUSH_COMMANDS_BIT, ReadbackWaitTimeout));
+    } while (status == GL_TIMEOUT_EXPIRED);
+
+    if (status == GL_WAIT_FAILED) {
+      discard();
+      Log::error("Could not wait for the read back.\n");
+      throw std::runtime_error("Could not wait for the read back.");
+    }
+
+    std::size_t bytes = static_cast<std::size_t>(m_size.width) * static_cast<std::size_t>(m_size.height) * 4;
+
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer));
+    const void *pixels;
+    GL_CHECK(pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT));
+
+    if (pixels != nullptr) {
+      m_image = Image(m_size, static_cast<const uint8_t *>(pixels));
+      GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    if (pixels == nullptr) {
+      discard();
+      Log::error("Could not map the pixel buffer.\n");
+      throw std::runtime_error("Could not map the pixel buffer.");
+    }
+#endif
+
+    discard();
+
+    Image image = std::move(m_image);
+    image.flipHorizontally();
+    return image;
+  }
+
+  void PixelReadback::discard() {
+#ifdef GF_OPENGL3
+    if (m_fence != nullptr) {
+      GL_CHECK(glDeleteSync(static_cast<GLsync>(m_fence)));
+      m_fence = nullptr;
+    }
+#endif
+
+    m_pending = false;
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
@@ -25,8 +25,15 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include <gf/Drawable.h>
+#include <gf/FrameArena.h>
 #include <gf/Image.h>
 #include <gf/Log.h>
 #include <gf/Transform.h>
@@ -79,8 +86,8 @@ inline namespace v1 {
 
   RenderTarget::RenderTarget(Vector2i size)
   : m_view(RectF::fromPositionSize({ 0.0f, 0.0f }, { static_cast<float>(size.width), static_cast<float>(size.height) }))
-  , m_defaultShader(default_vert, default_frag)
-  , m_defaultAlphaShader(default_vert, default_alpha_frag)
+  , m_defaultShader(default_vert, default_frag, Shader::Shared)
+  , m_defaultAlphaShader(default_vert, default_alpha_frag, Shader::Shared)
   , m_defaultTexture(createWhitePixel())
   {
     m_defaultTexture.setRepeated(true);
@@ -202,6 +209,95 @@ inline namespace v1 {
       return GL_POINTS;
     }
 
+    // instanced drawing
+
+    enum class InstancingApi {
+      None,
+      Core,
+      Angle,
+      Ext,
+    };
+
+    InstancingApi getInstancingApi() {
+#ifdef GF_OPENGL3
+      return InstancingApi::Core;
+#else
+      if (GLAD_GL_ANGLE_instanced_arrays != 0) {
+        return InstancingApi::Angle;
+      }
+
+      if (GLAD_GL_EXT_instanced_arrays != 0) {
+        return InstancingApi::Ext;
+      }
+
+      return InstancingApi::None;
+#endif
+    }
+
+    void setAttributeDivisor(InstancingApi api, GLuint loc, GLuint divisor) {
+      switch (api) {
+#ifdef GF_OPENGL3
+        case InstancingApi::Core:
+          GL_CHECK(glVertexAttribDivisor(loc, divisor));
+          break;
+#else
+        case InstancingApi::Angle:
+          GL_CHECK(glVertexAttribDivisorANGLE(loc, divisor));
+          break;
+        case InstancingApi::Ext:
+          GL_CHECK(glVertexAttribDivisorEXT(loc, divisor));
+          break;
+#endif
+        default:
+          assert(false);
+          break;
+      }
+    }
+
+    void drawArraysInstanced(InstancingApi api, GLenum mode, GLsizei count, GLsizei instances) {
+      switch (api) {
+#ifdef GF_OPENGL3
+        case InstancingApi::Core:
+          GL_CHECK(glDrawArraysInstanced(mode, 0, count, instances));
+          break;
+#else
+        case InstancingApi::Angle:
+          GL_CHECK(glDrawArraysInstancedANGLE(mode, 0, count, instances));
+          break;
+        case InstancingApi::Ext:
+          GL_CHECK(glDrawArraysInstancedEXT(mode, 0, count, instances));
+          break;
+#endif
+        default:
+          assert(false);
+          break;
+      }
+    }
+
+    void drawElementsInstanced(InstancingApi api, GLenum mode, GLsizei count, GLsizei instances) {
+      switch (api) {
+#ifdef GF_OPENGL3
+        case InstancingApi::Core:
+          GL_CHECK(glDrawElementsInstanced(mode, count, GL_UNSIGNED_SHORT, nullptr, instances));
+          break;
+#else
+        case InstancingApi::Angle:
+          GL_CHECK(glDrawElementsInstancedANGLE(mode, count, GL_UNSIGNED_SHORT, nullptr, instances));
+          break;
+        case InstancingApi::Ext:
+          GL_CHECK(glDrawElementsInstancedEXT(mode, count, GL_UNSIGNED_SHORT, nullptr, instances));
+          break;
+#endif
+        default:
+          assert(false);
+          break;
+      }
+    }
+
+    bool isListPrimitive(PrimitiveType type) {
+      return type == PrimitiveType::Points || type == PrimitiveType::Lines || type == PrimitiveType::Triangles;
+    }
+
   } // anonymous namespace
 
   void RenderTarget::draw(const Vertex *vertices, std::size_t count, PrimitiveType type, const RenderStates& states) {
@@ -209,8 +305,8 @@ inline namespace v1 {
       return;
     }
 
-    VertexBuffer buffer(vertices, count, type);
-    draw(buffer, states);
+    VertexBuffer buffer(vertices, count, type, VertexBufferUsage::Stream);
+    drawBuffer(buffer, PredefinedAttributes, states, false);
   }
 
   void RenderTarget::draw(const Vertex *vertices, const uint16_t *indices, std::size_t count, PrimitiveType type, const RenderStates& states) {
@@ -218,8 +314,8 @@ inline namespace v1 {
       return;
     }
 
-    VertexBuffer buffer(vertices, indices, count, type);
-    draw(buffer, states);
+    VertexBuffer buffer(vertices, indices, count, type, VertexBufferUsage::Stream);
+    drawBuffer(buffer, PredefinedAttributes, states, false);
   }
 
   void RenderTarget::draw(const VertexBuffer& buffer, const RenderStates& states) {
@@ -231,8 +327,8 @@ inline namespace v1 {
       return;
     }
 
-    VertexBuffer buffer(vertices, size, count, type);
-    customDraw(buffer, attributes, states);
+    VertexBuffer buffer(vertices, size, count, type, VertexBufferUsage::Stream);
+    drawBuffer(buffer, attributes, states, false);
   }
 
   void RenderTarget::customDraw(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderStates& states) {
@@ -240,19 +336,203 @@ inline namespace v1 {
       return;
     }
 
-    VertexBuffer buffer(vertices, size, indices, count, type);
-    customDraw(buffer, attributes, states);
+    VertexBuffer buffer(vertices, size, indices, count, type, VertexBufferUsage::Stream);
+    drawBuffer(buffer, attributes, states, false);
   }
 
   void RenderTarget::customDraw(const VertexBuffer& buffer, Span<const RenderAttributeInfo> attributes, const RenderStates& states) {
-    if (!buffer.hasArrayBuffer()) {
+    // a persistent buffer records its attributes in a vertex array object
+    drawBuffer(buffer, attributes, states, VertexBuffer::hasVertexArraySupport());
+  }
+
+  void RenderTarget::customDrawInstanced(const void *vertices, std::size_t size, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states) {
+    if (vertices == nullptr || count == 0 || instances.data == nullptr || instances.count == 0) {
       return;
     }
 
+    if (hasInstancingSupport()) {
+      drawInstances(vertices, size, nullptr, count, type, attributes, instances, states);
+    } else {
+      drawExpandedInstances(vertices, size, nullptr, count, type, attributes, instances, states);
+    }
+  }
+
+  void RenderTarget::customDrawInstanced(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states) {
+    if (vertices == nullptr || indices == nullptr || count == 0 || instances.data == nullptr || instances.count == 0) {
+      return;
+    }
+
+    if (hasInstancingSupport()) {
+      drawInstances(vertices, size, indices, count, type, attributes, instances, states);
+    } else {
+      drawExpandedInstances(vertices, size, indices, count, type, attributes, instances, states);
+    }
+  }
+
+  bool RenderTarget::hasInstancingSupport() {
+    return getInstancingApi() != InstancingApi::None;
+  }
+
+  void RenderTarget::drawInstances(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states) {
+    InstancingApi api = getInstancingApi();
+
+    VertexBuffer buffer = (indices == nullptr)
+        ? VertexBuffer(vertices, size, count, type, VertexBufferUsage::Stream)
+        : VertexBuffer(vertices, size, indices, count, type, VertexBufferUsage::Stream);
+    VertexBuffer instanceBuffer(instances.data, instances.size, instances.count, PrimitiveType::Points, VertexBufferUsage::Stream);
+
+    Shader& shader = drawStart(states);
+
+    Locations locations;
+    computeLocations(shader, attributes, locations);
+
+    Locations instanceLocations;
+    computeLocations(shader, instances.attributes, instanceLocations);
+
     VertexBuffer::bind(&buffer);
+    enableAttributes(locations, size, attributes);
+
+    // only the array buffer of the instances is bound
+    VertexBuffer::bind(&instanceBuffer);
+    enableAttributes(instanceLocations, instances.size, instances.attributes);
+
+    for (std::size_t i = 0; i < instanceLocations.count; ++i) {
+      if (instanceLocations.data[i] != -1) {
+        setAttributeDivisor(api, instanceLocations.data[i], 1);
+      }
+    }
+
+    if (indices != nullptr) {
+      drawElementsInstanced(api, getEnum(type), count, instances.count);
+    } else {
+      drawArraysInstanced(api, getEnum(type), count, instances.count);
+    }
+
+    for (std::size_t i = 0; i < instanceLocations.count; ++i) {
+      if (instanceLocations.data[i] != -1) {
+        setAttributeDivisor(api, instanceLocations.data[i], 0);
+      }
+    }
+
+    drawFinish(instanceLocations);
+    drawFinish(locations);
+
+    VertexBuffer::bind(nullptr);
+  }
+
+  void RenderTarget::drawExpandedInstances(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, Span<const RenderAttributeInfo> attributes, const RenderInstanceInfo& instances, const RenderStates& states) {
+    // each vertex is followed by the data of its instance
+    std::size_t stride = size + instances.size;
+
+    std::vector<RenderAttributeInfo> instanceAttributes(instances.attributes.begin(), instances.attributes.end());
+
+    for (auto& info : instanceAttributes) {
+      info.offset += size;
+    }
+
+    std::size_t vertexCount = count;
+    std::size_t batchMax = instances.count;
+
+    if (indices != nullptr) {
+      vertexCount = *std::max_element(indices, indices + count) + 1u;
+      batchMax = std::max(std::numeric_limits<uint16_t>::max() / vertexCount, std::size_t(1));
+    }
+
+    Shader& shader = drawStart(states);
 
     Locations locations;
-    drawStart(states, locations, buffer.getVertexSize(), attributes);
+    computeLocations(shader, attributes, locations);
+
+    Locations instanceLocations;
+    computeLocations(shader, instanceAttributes, instanceLocations);
+
+    auto vertexData = static_cast<const uint8_t *>(vertices);
+    auto instanceData = static_cast<const uint8_t *>(instances.data);
+
+    FrameArenaScope scope;
+    FrameVector<uint8_t> data;
+    FrameVector<uint16_t> expandedIndices;
+
+    for (std::size_t first = 0; first < instances.count; first += batchMax) {
+      std::size_t batch = std::min(batchMax, instances.count - first);
+
+      data.resize(batch * vertexCount * stride);
+      uint8_t *out = data.data();
+
+      for (std::size_t i = 0; i < batch; ++i) {
+        const uint8_t *instance = instanceData + (first + i) * instances.size;
+
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+          std::memcpy(out, vertexData + v * size, size);
+          std::memcpy(out + size, instance, instances.size);
+          out += stride;
+        }
+      }
+
+      VertexBuffer buffer;
+
+      if (indices != nullptr) {
+        expandedIndices.resize(batch * count);
+
+        for (std::size_t i = 0; i < batch; ++i) {
+          for (std::size_t k = 0; k < count; ++k) {
+            expandedIndices[i * count + k] = static_cast<uint16_t>(indices[k] + i * vertexCount);
+          }
+        }
+
+        buffer = VertexBuffer(data.data(), stride, expandedIndices.data(), batch * count, type, VertexBufferUsage::Stream);
+      } else {
+        buffer = VertexBuffer(data.data(), stride, batch * vertexCount, type, VertexBufferUsage::Stream);
+      }
+
+      VertexBuffer::bind(&buffer);
+      enableAttributes(locations, stride, attributes);
+      enableAttributes(instanceLocations, stride, instanceAttributes);
+
+      if (isListPrimitive(type)) {
+        // the instances are independent primitives
+        if (indices != nullptr) {
+          GL_CHECK(glDrawElements(getEnum(type), batch * count, GL_UNSIGNED_SHORT, nullptr));
+        } else {
+          GL_CHECK(glDrawArrays(getEnum(type), 0, batch * vertexCount));
+        }
+      } else {
+        // strips, fans and loops must be drawn one by one
+        for (std::size_t i = 0; i < batch; ++i) {
+          if (indices != nullptr) {
+            const void *offset = reinterpret_cast<const void *>(i * count * sizeof(uint16_t));
+            GL_CHECK(glDrawElements(getEnum(type), count, GL_UNSIGNED_SHORT, offset));
+          } else {
+            GL_CHECK(glDrawArrays(getEnum(type), i * vertexCount, vertexCount));
+          }
+        }
+      }
+
+      drawFinish(instanceLocations);
+      drawFinish(locations);
+    }
+
+    VertexBuffer::bind(nullptr);
+  }
+
+  void RenderTarget::drawBuffer(const VertexBuffer& buffer, Span<const RenderAttributeInfo> attributes, const RenderStates& states, bool useVertexArray) {
+    if (!buffer.hasArrayBuffer()) {
+      return;
+    }
+
+    Shader& shader = drawStart(states);
+
+    Locations locations;
+    computeLocations(shader, attributes, locations);
+
+    if (useVertexArray) {
+      if (buffer.bindVertexArray(computeLayout(locations, buffer.getVertexSize(), attributes))) {
+        enableAttributes(locations, buffer.getVertexSize(), attributes);
+      }
+    } else {
+      VertexBuffer::bind(&buffer);
+      enableAttributes(locations, buffer.getVertexSize(), attributes);
+    }
 
     if (buffer.hasElementArrayBuffer()) {
       GL_CHECK(glDrawElements(getEnum(buffer.getPrimitiveType()), buffer.getCount(), GL_UNSIGNED_SHORT, nullptr));
@@ -260,14 +540,16 @@ inline namespace v1 {
       GL_CHECK(glDrawArrays(getEnum(buffer.getPrimitiveType()), 0, buffer.getCount()));
     }
 
-    drawFinish(locations);
+    if (useVertexArray) {
+      VertexBuffer::unbindVertexArray();
+    } else {
+      drawFinish(locations);
+    }
 
     VertexBuffer::bind(nullptr);
   }
 
-  void RenderTarget::drawStart(const RenderStates& states, Locations& locations, std::size_t size, Span<const RenderAttributeInfo> attributes) {
-    assert(attributes.getSize() <= Locations::CountMax);
-
+  Shader& RenderTarget::drawStart(const RenderStates& states) {
     /*
      * texture
      */
@@ -328,20 +610,49 @@ inline namespace v1 {
       GL_CHECK(glLineWidth(states.lineWidth));
     }
 
-    /*
-     * prepare data
-     */
-
     Shader::bind(shader);
+    return *shader;
+  }
+
+  void RenderTarget::computeLocations(Shader& shader, Span<const RenderAttributeInfo> attributes, Locations& locations) {
+    assert(attributes.getSize() <= Locations::CountMax);
 
     for (auto info : attributes) {
-      int loc = shader->getAttributeLocation(info.name);
-      locations.data[locations.count++] = loc;
+      locations.data[locations.count++] = shader.getAttributeLocation(info.name);
+    }
+  }
+
+  uint64_t RenderTarget::computeLayout(const Locations& locations, std::size_t size, Span<const RenderAttributeInfo> attributes) {
+    // FNV-1a on the actual format of the attributes
+    uint64_t layout = UINT64_C(0xcbf29ce484222325);
+
+    auto combine = [&layout](uint64_t value) {
+      layout = (layout ^ value) * UINT64_C(0x100000001b3);
+    };
+
+    combine(size);
+
+    for (std::size_t i = 0; i < locations.count; ++i) {
+      const RenderAttributeInfo& info = attributes[i];
+      combine(static_cast<uint64_t>(static_cast<int64_t>(locations.data[i])));
+      combine(static_cast<uint64_t>(info.size));
+      combine(static_cast<uint64_t>(info.type));
+      combine(info.normalized ? 1 : 0);
+      combine(info.offset);
+    }
+
+    return layout;
+  }
+
+  void RenderTarget::enableAttributes(const Locations& locations, std::size_t size, Span<const RenderAttributeInfo> attributes) {
+    for (std::size_t i = 0; i < locations.count; ++i) {
+      int loc = locations.data[i];
 
       if (loc == -1) {
         continue;
       }
 
+      const RenderAttributeInfo& info = attributes[i];
       GL_CHECK(glEnableVertexAttribArray(loc));
       const void *pointer = reinterpret_cast<const void *>(info.offset);
       GL_CHECK(glVertexAttribPointer(loc, info.size, static_cast<GLenum>(info.type), info.normalized ? GL_TRUE : GL_FALSE, size, pointer));
@@ -457,7 +768,9 @@ inline namespace v1 {
 
   Image RenderTarget::captureFramebuffer(unsigned name) const {
     auto size = getSize();
-    std::vector<uint8_t> pixels(static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height) * 4);
+
+    FrameArenaScope scope;
+    FrameVector<uint8_t> pixels(static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height) * 4);
 
     GLint boundFrameBuffer;
     GL_CHECK(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFrameBuffer));
@@ -23,6 +23,7 @@
  */
 #include <gf/RenderWindow.h>
 
+#include <gf/FrameArena.h>
 #include <gf/Window.h>
 
 #include <gfpriv/GlDebug.h>
@@ -54,6 +55,7 @@ inline namespace v1 {
 
   void RenderWindow::display() {
     m_window.display();
+    FrameArena::getThreadLocal().reset();
   }
 
   Image RenderWindow::capture() const {
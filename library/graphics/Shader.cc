@@ -24,11 +24,19 @@
 #include <gf/Shader.h>
 
 #include <cassert>
+#include <cinttypes>
+#include <cstdio>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
+
+#include <SDL.h>
 
 #include <gf/Stream.h>
 #include <gf/Log.h>
+#include <gf/Unused.h>
 
 #include <gfpriv/GlDebug.h>
 #include <gfpriv/GlFwd.h>
@@ -120,9 +128,223 @@ inline namespace v1 {
       return id;
     }
 
+    /*
+     * program binary cache
+     */
+
+    std::mutex g_binaryCacheMutex;
+    Path g_binaryCacheDirectory;
+
+    Path getBinaryCacheDirectory() {
+      std::lock_guard<std::mutex> lock(g_binaryCacheMutex);
+      return g_binaryCacheDirectory;
+    }
+
+    constexpr uint32_t ProgramBinaryMagic = 0x42504647; // "GFPB"
+
+    struct ProgramBinaryHeader {
+      uint32_t magic;
+      uint32_t format;
+      uint64_t programKey;
+      uint64_t driverKey;
+      uint32_t length;
+    };
+
+    Id computeProgramKey(const char *vertexShaderCode, const char *fragmentShaderCode) {
+      std::string sources;
+      sources.append("vertex:");
+
+      if (vertexShaderCode != nullptr) {
+        sources.append(vertexShaderCode);
+      }
+
+      sources.append(1, '\0');
+      sources.append("fragment:");
+
+      if (fragmentShaderCode != nullptr) {
+        sources.append(fragmentShaderCode);
+      }
+
+      return gf::hash(sources);
+    }
+
+    Id computeDriverKey() {
+      std::string driver;
+
+      for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        const GLubyte *value = nullptr;
+        GL_CHECK(value = glGetString(name));
+
+        if (value != nullptr) {
+          driver.append(reinterpret_cast<const char *>(value));
+        }
+
+        driver.append(1, '\n');
+      }
+
+      return gf::hash(driver);
+    }
+
+    Path computeProgramBinaryPath(const Path& directory, Id programKey, Id driverKey) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "%016" PRIx64 ".bin", programKey ^ (driverKey * UINT64_C(0x9E3779B97F4A7C15)));
+      return directory / name;
+    }
+
+    void setProgramRetrievable(GLuint program) {
+#ifdef GF_OPENGL3
+      GL_CHECK(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+#else
+      gf::unused(program); // always retrievable with OES_get_program_binary
+#endif
+    }
+
+    GLuint loadProgramBinary(const Path& path, Id programKey, Id driverKey) {
+      std::ifstream file(path.string(), std::ios::binary);
+
+      if (!file) {
+        return 0;
+      }
+
+      ProgramBinaryHeader header;
+      file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+      if (!file || header.magic != ProgramBinaryMagic || header.programKey != programKey || header.driverKey != driverKey) {
+        return 0;
+      }
+
+      std::vector<char> binary(header.length);
+      file.read(binary.data(), binary.size());
+
+      if (!file) {
+        return 0;
+      }
+
+      GLuint program = 0;
+      GL_CHECK(program = glCreateProgram());
+
+#ifdef GF_OPENGL3
+      GL_CHECK(glProgramBinary(program, header.format, binary.data(), header.length));
+#else
+      GL_CHECK(glProgramBinaryOES(program, header.format, binary.data(), header.length));
+#endif
+
+      GLint linkStatus = GL_FALSE;
+      GL_CHECK(glGetProgramiv(program, GL_LINK_STATUS, &linkStatus));
+
+      if (linkStatus == GL_FALSE) {
+        // the driver may reject its own binaries after an update
+        Log::debug("Program binary rejected by the driver: '%s'\n", path.string().c_str());
+        GL_CHECK(glDeleteProgram(program));
+        return 0;
+      }
+
+      Log::debug("Program loaded from binary cache: '%s'\n", path.string().c_str());
+      return program;
+    }
+
+    void saveProgramBinary(const Path& path, GLuint program, Id programKey, Id driverKey) {
+      GLint length = 0;
+#ifdef GF_OPENGL3
+      GL_CHECK(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+#else
+      GL_CHECK(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &length));
+#endif
+
+      if (length <= 0) {
+        return;
+      }
+
+      std::vector<char> binary(length);
+      GLenum format = 0;
+#ifdef GF_OPENGL3
+      GL_CHECK(glGetProgramBinary(program, length, &length, &format, binary.data()));
+#else
+      GL_CHECK(glGetProgramBinaryOES(program, length, &length, &format, binary.data()));
+#endif
+
+      boost::system::error_code error;
+      boost::filesystem::create_directories(path.parent_path(), error);
+
+      // the binary is written in a temporary file and then renamed, so that
+      // another thread or process never reads a partial binary
+      Path temporary = path.parent_path() / boost::filesystem::unique_path(path.filename().string() + ".%%%%-%%%%-%%%%");
+
+      {
+        std::ofstream file(temporary.string(), std::ios::binary | std::ios::trunc);
+
+        if (!file) {
+          Log::warning("Could not write the program binary: '%s'\n", path.string().c_str());
+          return;
+        }
+
+        ProgramBinaryHeader header;
+        header.magic = ProgramBinaryMagic;
+        header.format = format;
+        header.programKey = programKey;
+        header.driverKey = driverKey;
+        header.length = static_cast<uint32_t>(length);
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(binary.data(), length);
+      }
+
+      boost::filesystem::rename(temporary, path, error);
+
+      if (error) {
+        Log::warning("Could not write the program binary: '%s'\n", path.string().c_str());
+        boost::filesystem::remove(temporary, error);
+      }
+    }
+
+    /*
+     * shared programs
+     */
+
+    struct SharedProgram {
+      void *context;
+      GLuint program;
+      int references;
+    };
+
+    std::mutex g_sharedProgramsMutex;
+    std::map<Id, SharedProgram> g_sharedPrograms;
+
+    // a context may be allocated at the address of a destroyed context, so
+    // each address has a generation that changes when its context is destroyed
+    std::map<void *, Id> g_sharedProgramsGenerations;
+
+    // must be called with g_sharedProgramsMutex locked
+    Id computeSharedProgramKey(void *context, const char *vertexShaderCode, const char *fragmentShaderCode) {
+      // programs are only shared inside a context, because independent
+      // contexts (e.g. headless contexts) can not see each other's objects
+      Id key = computeProgramKey(vertexShaderCode, fragmentShaderCode);
+      key = (key ^ static_cast<Id>(reinterpret_cast<uintptr_t>(context))) * UINT64_C(0x100000001b3);
+      key = (key ^ g_sharedProgramsGenerations[context]) * UINT64_C(0x100000001b3);
+      return key;
+    }
+
     GLuint compile(const char *vertexShaderCode, const char *fragmentShaderCode) {
       assert(vertexShaderCode != nullptr || fragmentShaderCode != nullptr);
 
+      Path directory = getBinaryCacheDirectory();
+      bool cached = !directory.empty() && Shader::hasBinaryCacheSupport();
+      Id programKey = InvalidId;
+      Id driverKey = InvalidId;
+      Path binaryPath;
+
+      if (cached) {
+        programKey = computeProgramKey(vertexShaderCode, fragmentShaderCode);
+        driverKey = computeDriverKey();
+        binaryPath = computeProgramBinaryPath(directory, programKey, driverKey);
+
+        GLuint program = loadProgramBinary(binaryPath, programKey, driverKey);
+
+        if (program != 0) {
+          return program;
+        }
+      }
+
       GLuint program = 0;
       GL_CHECK(program = glCreateProgram());
 
@@ -138,6 +360,10 @@ inline namespace v1 {
         GL_CHECK(glDeleteShader(id)); // the shader is still here because it is attached to the program
       }
 
+      if (cached) {
+        setProgramRetrievable(program);
+      }
+
       GL_CHECK(glLinkProgram(program));
 
       GLint linkStatus = GL_FALSE;
@@ -155,6 +381,10 @@ inline namespace v1 {
         throw std::runtime_error("Error while linking program");
       }
 
+      if (cached) {
+        saveProgramBinary(binaryPath, program, programKey, driverKey);
+      }
+
       return program;
     }
 
@@ -163,6 +393,7 @@ inline namespace v1 {
 
   Shader::Shader()
   : m_program(0)
+  , m_sharedKey(InvalidId)
   {
 
   }
@@ -179,6 +410,7 @@ inline namespace v1 {
 
   Shader::Shader(const char *shader, Type type)
   : m_program(0)
+  , m_sharedKey(InvalidId)
   {
     if (shader == nullptr) {
       return;
@@ -196,6 +428,7 @@ inline namespace v1 {
 
   Shader::Shader(const char *vertexShader, const char *fragmentShader)
   : m_program(0)
+  , m_sharedKey(InvalidId)
   {
     if (vertexShader == nullptr && fragmentShader == nullptr) {
       return;
@@ -214,12 +447,112 @@ inline namespace v1 {
   {
   }
 
+  Shader::Shader(const char *vertexShader, const char *fragmentShader, Sharing sharing)
+  : m_program(0)
+  , m_sharedKey(InvalidId)
+  {
+    gf::unused(sharing);
+    assert(vertexShader != nullptr && fragmentShader != nullptr);
+
+    void *context = SDL_GL_GetCurrentContext();
+
+    std::unique_lock<std::mutex> lock(g_sharedProgramsMutex);
+    Id key = computeSharedProgramKey(context, vertexShader, fragmentShader);
+    auto it = g_sharedPrograms.find(key);
+
+    if (it == g_sharedPrograms.end()) {
+      // the compilation and the binary cache are slow, the lock is not held
+      // so that the other shaders are not blocked in the meantime
+      lock.unlock();
+      GLuint program = compile(vertexShader, fragmentShader);
+      lock.lock();
+
+      key = computeSharedProgramKey(context, vertexShader, fragmentShader);
+      it = g_sharedPrograms.find(key);
+
+      if (it == g_sharedPrograms.end()) {
+        g_sharedPrograms.insert(std::make_pair(key, SharedProgram{ context, program, 1 }));
+        m_program = program;
+        m_sharedKey = key;
+        return;
+      }
+
+      // another thread compiled the same program in the meantime
+      if (program != 0) {
+        GL_CHECK(glDeleteProgram(program));
+      }
+    }
+
+    m_program = it->second.program;
+    it->second.references++;
+    m_sharedKey = key;
+  }
+
   Shader::~Shader() {
+    if (m_sharedKey != InvalidId) {
+      std::lock_guard<std::mutex> lock(g_sharedProgramsMutex);
+      auto it = g_sharedPrograms.find(m_sharedKey);
+
+      if (it == g_sharedPrograms.end()) {
+        // the context has been destroyed, and the program with it
+        return;
+      }
+
+      if (--it->second.references > 0) {
+        return;
+      }
+
+      g_sharedPrograms.erase(it);
+    }
+
     if (m_program != 0) {
       GL_CHECK(glDeleteProgram(m_program));
     }
   }
 
+  void Shader::setBinaryCacheDirectory(const Path& directory) {
+    std::lock_guard<std::mutex> lock(g_binaryCacheMutex);
+    g_binaryCacheDirectory = directory;
+  }
+
+  void Shader::releaseSharedPrograms(void *context) {
+    std::lock_guard<std::mutex> lock(g_sharedProgramsMutex);
+
+    for (auto it = g_sharedPrograms.begin(); it != g_sharedPrograms.end(); ) {
+      if (it->second.context == context) {
+        it = g_sharedPrograms.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    g_sharedProgramsGenerations[context]++;
+  }
+
+  bool Shader::hasBinaryCacheSupport() {
+#if defined(__APPLE__)
+    return false;
+#else
+#ifdef GF_OPENGL3
+    if (GLAD_GL_ARB_get_program_binary == 0) {
+      return false;
+    }
+
+    GLenum parameter = GL_NUM_PROGRAM_BINARY_FORMATS;
+#else
+    if (GLAD_GL_OES_get_program_binary == 0) {
+      return false;
+    }
+
+    GLenum parameter = GL_NUM_PROGRAM_BINARY_FORMATS_OES;
+#endif
+
+    GLint formats = 0;
+    GL_CHECK(glGetIntegerv(parameter, &formats));
+    return formats > 0;
+#endif
+  }
+
 
   struct Shader::Guard {
     explicit Guard(Shader& shader)
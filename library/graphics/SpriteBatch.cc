@@ -20,6 +20,10 @@
  */
 #include <gf/SpriteBatch.h>
 
+#include <cstring>
+
+#include <iterator>
+
 #include <gf/RenderTarget.h>
 #include <gf/Sprite.h>
 #include <gf/Transform.h>
@@ -33,13 +37,20 @@ inline namespace v1 {
 
   SpriteBatch::SpriteBatch(RenderTarget& target)
   : m_target(target)
-  , m_count(0)
+  , m_mode(SpriteSortMode::Deferred)
+  , m_culledCount(0)
   {
 
   }
 
-  void SpriteBatch::begin() {
-    m_count = 0;
+  void SpriteBatch::begin(SpriteSortMode mode) {
+    m_mode = mode;
+    m_viewBounds = gf::transform(m_target.getView().getInverseTransform(), RectF::fromMinMax({ -1.0f, -1.0f }, { 1.0f, 1.0f }));
+    m_culledCount = 0;
+    m_states.clear();
+    m_statesIndex.clear();
+    m_quads.clear();
+    m_records.clear();
   }
 
   namespace {
@@ -48,9 +59,31 @@ inline namespace v1 {
       return lhs.mode == rhs.mode && lhs.transform == rhs.transform && lhs.shader == rhs.shader;
     }
 
+    // the blend mode is not part of the key, it is checked with areStatesSimilar()
+    // equal transforms with different bits (0 and -0) only cost an extra batch
+    Id computeStatesKey(const Texture& texture, const RenderStates& states) {
+      const Texture *texturePtr = &texture;
+      char data[sizeof(texturePtr) + sizeof(states.shader) + sizeof(states.transform)];
+      std::memcpy(data, &texturePtr, sizeof(texturePtr));
+      std::memcpy(data + sizeof(texturePtr), &states.shader, sizeof(states.shader));
+      std::memcpy(data + sizeof(texturePtr) + sizeof(states.shader), &states.transform, sizeof(states.transform));
+      return gf::hash(data, sizeof(data));
+    }
+
+    // map the float to an unsigned integer with the same order
+    uint32_t computeDepthKey(float depth) {
+      uint32_t bits;
+      std::memcpy(&bits, &depth, sizeof(bits));
+      return (bits & UINT32_C(0x80000000)) != 0 ? ~bits : bits | UINT32_C(0x80000000);
+    }
+
   } // anonymous namespace
 
   void SpriteBatch::draw(Sprite& sprite, const RenderStates& states) {
+    draw(sprite, 0.0f, states);
+  }
+
+  void SpriteBatch::draw(Sprite& sprite, float depth, const RenderStates& states) {
     if (!sprite.hasTexture()) {
       return;
     }
@@ -60,22 +93,6 @@ inline namespace v1 {
     Matrix3f transform = sprite.getTransform();
     Color4f color = sprite.getColor();
 
-    if (m_count == 0) {
-      m_currentRenderStates.mode = states.mode;
-      m_currentRenderStates.transform = states.transform;
-      m_currentRenderStates.texture[0] = &texture;
-      m_currentRenderStates.shader = states.shader;
-    } else {
-      if (m_count == MaxSpriteCount || m_currentRenderStates.texture[0] != &texture || !areStatesSimilar(m_currentRenderStates, states)) {
-        renderBatch();
-
-        m_currentRenderStates.mode = states.mode;
-        m_currentRenderStates.transform = states.transform;
-        m_currentRenderStates.texture[0] = &texture;
-        m_currentRenderStates.shader = states.shader;
-      }
-    }
-
     Vertex vertices[4];
 
     // compute sprite position
@@ -88,9 +105,19 @@ inline namespace v1 {
     vertices[2].position = {  0.0f,            spriteSize.height };
     vertices[3].position = { spriteSize.width, spriteSize.height };
 
+    RectF bounds = RectF::empty();
+
     for (auto& vertex : vertices) {
       // apply transform as it is different for every sprite
       vertex.position = gf::transform(transform, vertex.position);
+      bounds.extend(vertex.position);
+    }
+
+    // cull the sprite against the view
+
+    if (!gf::transform(states.transform, bounds).intersects(m_viewBounds)) {
+      m_culledCount++;
+      return;
     }
 
     // set sprite color
@@ -104,21 +131,20 @@ inline namespace v1 {
     vertices[2].texCoords = textureRect.getBottomLeft();
     vertices[3].texCoords = textureRect.getBottomRight();
 
-    // add first triangle
-
-    std::size_t index = m_count * VerticesPerSprite;
+    // record the sprite
 
-    m_vertices[index + 0] = vertices[0];
-    m_vertices[index + 1] = vertices[1];
-    m_vertices[index + 2] = vertices[2];
+    SpriteRecord record;
+    record.sprite = static_cast<uint32_t>(m_records.size());
+    record.states = findStates(texture, states);
 
-    // add second triangle
-
-    m_vertices[index + 3] = vertices[2];
-    m_vertices[index + 4] = vertices[1];
-    m_vertices[index + 5] = vertices[3];
+    if (m_mode == SpriteSortMode::Depth) {
+      record.key = (static_cast<uint64_t>(computeDepthKey(depth)) << 32) | record.states;
+    } else {
+      record.key = 0;
+    }
 
-    m_count++;
+    m_quads.insert(m_quads.end(), std::begin(vertices), std::end(vertices));
+    m_records.push_back(record);
   }
 
 
@@ -134,19 +160,131 @@ inline namespace v1 {
     draw(sprite, states);
   }
 
+  namespace {
+
+    template<typename Record>
+    void radixSortRecords(std::vector<Record>& records, std::vector<Record>& buffer) {
+      static constexpr std::size_t Passes = sizeof(uint64_t);
+      std::size_t counts[Passes][256] = { };
+
+      for (auto& record : records) {
+        for (std::size_t pass = 0; pass < Passes; ++pass) {
+          counts[pass][(record.key >> (pass * 8)) & 0xFF]++;
+        }
+      }
+
+      buffer.resize(records.size());
+
+      for (std::size_t pass = 0; pass < Passes; ++pass) {
+        std::size_t *count = counts[pass];
+
+        // skip the pass if all the records have the same digit
+        if (count[(records.front().key >> (pass * 8)) & 0xFF] == records.size()) {
+          continue;
+        }
+
+        std::size_t offset = 0;
+
+        for (std::size_t digit = 0; digit < 256; ++digit) {
+          std::size_t n = count[digit];
+          count[digit] = offset;
+          offset += n;
+        }
+
+        for (auto& record : records) {
+          buffer[count[(record.key >> (pass * 8)) & 0xFF]++] = record;
+        }
+
+        records.swap(buffer);
+      }
+    }
+
+  } // anonymous namespace
+
   void SpriteBatch::end() {
-    renderBatch();
+    if (m_records.empty()) {
+      return;
+    }
+
+    if (m_mode == SpriteSortMode::Depth) {
+      radixSortRecords(m_records, m_sortBuffer);
+    }
+
+    std::size_t count = 0;
+    uint32_t current = m_records.front().states;
+
+    for (auto& record : m_records) {
+      if (count == MaxSpriteCount || record.states != current) {
+        renderBatch(current, count);
+        count = 0;
+        current = record.states;
+      }
+
+      const Vertex *quad = &m_quads[record.sprite * 4];
+      std::size_t index = count * VerticesPerSprite;
+
+      // add first triangle
+
+      m_vertices[index + 0] = quad[0];
+      m_vertices[index + 1] = quad[1];
+      m_vertices[index + 2] = quad[2];
+
+      // add second triangle
+
+      m_vertices[index + 3] = quad[2];
+      m_vertices[index + 4] = quad[1];
+      m_vertices[index + 5] = quad[3];
+
+      count++;
+    }
+
+    renderBatch(current, count);
+
+    m_quads.clear();
+    m_records.clear();
+  }
+
+  uint32_t SpriteBatch::findStates(const Texture& texture, const RenderStates& states) {
+    // the last states are the most likely
+    if (!m_states.empty()) {
+      const RenderStates& last = m_states.back();
+
+      if (last.texture[0] == &texture && areStatesSimilar(last, states)) {
+        return static_cast<uint32_t>(m_states.size() - 1);
+      }
+    }
+
+    Id key = computeStatesKey(texture, states);
+    auto range = m_statesIndex.equal_range(key);
+
+    for (auto it = range.first; it != range.second; ++it) {
+      const RenderStates& candidate = m_states[it->second];
+
+      if (candidate.texture[0] == &texture && areStatesSimilar(candidate, states)) {
+        return it->second;
+      }
+    }
+
+    RenderStates batchStates;
+    batchStates.mode = states.mode;
+    batchStates.transform = states.transform;
+    batchStates.texture[0] = &texture;
+    batchStates.shader = states.shader;
+    m_states.push_back(batchStates);
+
+    auto index = static_cast<uint32_t>(m_states.size() - 1);
+    m_statesIndex.emplace(key, index);
+    return index;
   }
 
-  void SpriteBatch::renderBatch() {
-    if (m_count == 0) {
+  void SpriteBatch::renderBatch(uint32_t states, std::size_t count) {
+    if (count == 0) {
       return;
     }
 
-    // Log::debug(Log::Graphics, "Batch %zu sprites...\n", m_count);
+    // Log::debug(Log::Graphics, "Batch %zu sprites...\n", count);
 
-    m_target.draw(m_vertices.data(), m_count * VerticesPerSprite, PrimitiveType::Triangles, m_currentRenderStates);
-    m_count = 0;
+    m_target.draw(m_vertices.data(), count * VerticesPerSprite, PrimitiveType::Triangles, m_states[states]);
   }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -74,6 +74,17 @@ inline namespace v1 {
       return 4;
     }
 
+    // an estimation, the driver may pad the rows or use another internal format
+    std::size_t computeTextureMemory(BareTexture::Format format, Vector2i size, bool mipmap) {
+      std::size_t memory = static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height) * static_cast<std::size_t>(getAlignment(format));
+
+      if (mipmap) {
+        memory += memory / 3;
+      }
+
+      return memory;
+    }
+
     GLenum getMinFilter(bool smooth, bool mipmap) {
       if (mipmap) {
         return smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
@@ -91,6 +102,7 @@ inline namespace v1 {
   , m_smooth(false)
   , m_repeated(false)
   , m_mipmap(false)
+  , m_memory(MemoryTag::GpuTextures)
   {
   }
 
@@ -100,6 +112,7 @@ inline namespace v1 {
   , m_smooth(false)
   , m_repeated(false)
   , m_mipmap(false)
+  , m_memory(MemoryTag::GpuTextures, computeTextureMemory(format, size, false))
   {
     assert(m_size.width > 0 && m_size.height > 0);
 
@@ -187,6 +200,9 @@ inline namespace v1 {
 
     GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_handle));
     GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, textureFormat, m_size.width, m_size.height, 0, textureFormat, GL_UNSIGNED_BYTE, data));
+
+    // the mipmaps are lost
+    m_memory.resize(computeTextureMemory(m_format, m_size, false));
   }
 
   RectF BareTexture::computeTextureCoords(const RectI& rect) const {
@@ -200,6 +216,7 @@ inline namespace v1 {
     }
 
     m_mipmap = true;
+    m_memory.resize(computeTextureMemory(m_format, m_size, true));
 
     GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_handle));
     GL_CHECK(glGenerateMipmap(GL_TEXTURE_2D));
@@ -24,9 +24,11 @@
 #include <cstdio>
 #include <algorithm>
 
+#include <gf/FrameArena.h>
 #include <gf/Log.h>
 
 #include <gf/RenderTarget.h>
+#include <gf/SnapshotHistory.h>
 #include <gf/Transform.h>
 #include <gf/VectorOps.h>
 
@@ -88,6 +90,10 @@ inline namespace v1 {
     }
   }
 
+  void TileLayer::trackState(SnapshotHistory& history) {
+    history.track(m_tiles);
+  }
+
   RectF TileLayer::getLocalBounds() const {
     return RectF::fromPositionSize({ 0.0f, 0.0f }, m_layerSize * m_tileSize);
   }
@@ -97,11 +103,13 @@ inline namespace v1 {
   }
 
   VertexBuffer TileLayer::commitGeometry() const {
-    VertexArray vertices(PrimitiveType::Triangles);
     RectI rect = RectI::fromPositionSize({ 0, 0 }, m_layerSize);
-    fillVertexArray(vertices, rect);
 
-    return VertexBuffer(vertices.getVertexData(), vertices.getVertexCount(), vertices.getPrimitiveType());
+    FrameArenaScope scope;
+    FrameVector<Vertex> vertices(computeVertexCapacity(rect));
+    std::size_t count = fillVertices(vertices.data(), rect);
+
+    return VertexBuffer(vertices.data(), count, PrimitiveType::Triangles);
   }
 
   void TileLayer::draw(RenderTarget& target, const RenderStates& states) {
@@ -155,9 +163,13 @@ inline namespace v1 {
   }
 
 
-  void TileLayer::fillVertexArray(VertexArray& array, RectI rect) const {
-    array.reserve(static_cast<std::size_t>(rect.getWidth()) * static_cast<std::size_t>(rect.getHeight()) * 6);
+  std::size_t TileLayer::computeVertexCapacity(RectI rect) {
+    // the bounds of the rectangle are inclusive
+    return static_cast<std::size_t>(rect.getWidth() + 1) * static_cast<std::size_t>(rect.getHeight() + 1) * 6;
+  }
 
+  std::size_t TileLayer::fillVertices(Vertex *array, RectI rect) const {
+    std::size_t count = 0;
     Vector2i cell;
 
     for (cell.y = rect.min.y; cell.y <= rect.max.y; ++cell.y) {
@@ -235,18 +247,20 @@ inline namespace v1 {
 
         // first triangle
 
-        array.append(vertices[0]);
-        array.append(vertices[1]);
-        array.append(vertices[2]);
+        array[count++] = vertices[0];
+        array[count++] = vertices[1];
+        array[count++] = vertices[2];
 
         // second triangle
 
-        array.append(vertices[2]);
-        array.append(vertices[1]);
-        array.append(vertices[3]);
+        array[count++] = vertices[2];
+        array[count++] = vertices[1];
+        array[count++] = vertices[3];
       }
     }
 
+    assert(count <= computeVertexCapacity(rect));
+    return count;
   }
 
   void TileLayer::updateGeometry() {
@@ -256,7 +270,9 @@ inline namespace v1 {
       return;
     }
 
-    fillVertexArray(m_vertices, m_rect);
+    m_vertices.resize(computeVertexCapacity(m_rect));
+    std::size_t count = fillVertices(m_vertices.begin(), m_rect);
+    m_vertices.resize(count);
   }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -20,8 +20,12 @@
  */
 #include <gf/VertexBuffer.h>
 
+#include <cassert>
 #include <algorithm>
 #include <stdexcept>
+#include <utility>
+
+#include <SDL.h>
 
 #include <gf/Log.h>
 #include <gf/Vertex.h>
@@ -42,59 +46,135 @@ inline namespace v1 {
     GL_CHECK(glDeleteBuffers(n, resources));
   }
 
+  void GraphicsTrait<GraphicsTag::VertexArray>::gen(int n, unsigned* resources) {
+#ifdef GF_OPENGL3
+    GL_CHECK(glGenVertexArrays(n, resources));
+#else
+    GL_CHECK(glGenVertexArraysOES(n, resources));
+#endif
+  }
+
+  void GraphicsTrait<GraphicsTag::VertexArray>::del(int n, const unsigned* resources) {
+#ifdef GF_OPENGL3
+    GL_CHECK(glDeleteVertexArrays(n, resources));
+#else
+    GL_CHECK(glDeleteVertexArraysOES(n, resources));
+#endif
+  }
+
+  namespace {
+
+    GLenum getBufferUsage(VertexBufferUsage usage) {
+      switch (usage) {
+        case VertexBufferUsage::Static:
+          return GL_STATIC_DRAW;
+        case VertexBufferUsage::Dynamic:
+          return GL_DYNAMIC_DRAW;
+        case VertexBufferUsage::Stream:
+          return GL_STREAM_DRAW;
+      }
+
+      assert(false);
+      return GL_STATIC_DRAW;
+    }
+
+    // (re)allocate the storage of a buffer, orphaning the previous storage
+    bool allocateBufferStorage(GLenum target, GLuint buffer, std::size_t size, const void *data, VertexBufferUsage usage) {
+      GL_CHECK(glBindBuffer(target, buffer));
+      GL_CHECK(glBufferData(target, size, nullptr, getBufferUsage(usage)));
+
+      if (data != nullptr) {
+        GL_CHECK(glBufferSubData(target, 0, size, data));
+      }
+
+      GLint uploadedSize = 0;
+      GL_CHECK(glGetBufferParameteriv(target, GL_BUFFER_SIZE, &uploadedSize));
+
+      GL_CHECK(glBindBuffer(target, 0));
+
+      return size == static_cast<std::size_t>(uploadedSize);
+    }
+
+    // maximum number of attribute layouts per buffer
+    constexpr std::size_t VertexArrayCountMax = 4;
+
+    // the vertex array object of the context that is current on this thread
+    thread_local GLuint g_defaultVertexArray = 0;
+
+    void bindVertexArrayName(GLuint name) {
+#ifdef GF_OPENGL3
+      GL_CHECK(glBindVertexArray(name));
+#else
+      GL_CHECK(glBindVertexArrayOES(name));
+#endif
+    }
+
+    void updateBufferStorage(GLenum target, GLuint buffer, std::size_t offset, std::size_t size, const void *data, std::size_t total, VertexBufferUsage usage) {
+      GL_CHECK(glBindBuffer(target, buffer));
+
+      if (offset == 0 && size == total) {
+        GL_CHECK(glBufferData(target, size, nullptr, getBufferUsage(usage)));
+      }
+
+      GL_CHECK(glBufferSubData(target, offset, size, data));
+      GL_CHECK(glBindBuffer(target, 0));
+    }
+
+  }
+
   VertexBuffer::VertexBuffer()
   : m_vbo(gf::None)
   , m_ebo(gf::None)
   , m_size(0)
   , m_count(0)
+  , m_vertexCount(0)
   , m_type(PrimitiveType::Points)
+  , m_usage(VertexBufferUsage::Static)
+  , m_memory(MemoryTag::GpuBuffers)
   {
   }
 
 
-  VertexBuffer::VertexBuffer(const Vertex *vertices, std::size_t count, PrimitiveType type)
-  : VertexBuffer(vertices, sizeof(Vertex), count, type)
+  VertexBuffer::VertexBuffer(const Vertex *vertices, std::size_t count, PrimitiveType type, VertexBufferUsage usage)
+  : VertexBuffer(vertices, sizeof(Vertex), count, type, usage)
   {
   }
 
-  VertexBuffer::VertexBuffer(const Vertex *vertices, const uint16_t *indices, std::size_t count, PrimitiveType type)
-  : VertexBuffer(vertices, sizeof(Vertex), indices, count, type)
+  VertexBuffer::VertexBuffer(const Vertex *vertices, const uint16_t *indices, std::size_t count, PrimitiveType type, VertexBufferUsage usage)
+  : VertexBuffer(vertices, sizeof(Vertex), indices, count, type, usage)
   {
   }
 
-  VertexBuffer::VertexBuffer(const void *vertices, std::size_t size, std::size_t count, PrimitiveType type)
+  VertexBuffer::VertexBuffer(const void *vertices, std::size_t size, std::size_t count, PrimitiveType type, VertexBufferUsage usage)
   : m_ebo(gf::None)
   , m_size(size)
   , m_count(count)
+  , m_vertexCount(count)
   , m_type(type)
+  , m_usage(usage)
+  , m_memory(MemoryTag::GpuBuffers)
   {
     if (vertices == nullptr || count == 0) {
       Log::error("Could not create the buffer, invalid input.\n");
       throw std::runtime_error("Could not create the buffer, invalid input.");
     }
 
-    std::size_t vboSize = count * size;
-
-    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-    GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vboSize, nullptr, GL_STATIC_DRAW));
-    GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, 0, vboSize, vertices));
-
-    GLint vboUploadedSize = 0;
-    GL_CHECK(glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &vboUploadedSize));
-
-    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
-    if(vboSize != static_cast<std::size_t>(vboUploadedSize)) {
+    if (!allocateBufferStorage(GL_ARRAY_BUFFER, m_vbo, count * size, vertices, usage)) {
       Log::error("Vertex array buffer size in not correct.\n");
       throw std::runtime_error("Vertex array buffer size in not correct.");
     }
+
+    updateMemory();
   }
 
 
-  VertexBuffer::VertexBuffer(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type)
+  VertexBuffer::VertexBuffer(const void *vertices, std::size_t size, const uint16_t *indices, std::size_t count, PrimitiveType type, VertexBufferUsage usage)
   : m_size(size)
   , m_count(count)
+  , m_vertexCount(0)
   , m_type(type)
+  , m_usage(usage)
+  , m_memory(MemoryTag::GpuBuffers)
   {
     if (vertices == nullptr || indices == nullptr || count == 0) {
       Log::error("Could not create the buffer, invalid input.\n");
@@ -102,37 +182,168 @@ inline namespace v1 {
     }
 
     uint16_t maxIndex = *std::max_element(indices, indices + count);
-    std::size_t vboSize = (maxIndex + 1) * size;
+    m_vertexCount = maxIndex + 1;
+
+    if (!allocateBufferStorage(GL_ARRAY_BUFFER, m_vbo, m_vertexCount * size, vertices, usage)) {
+      Log::error("Vertex array buffer size in not correct.\n");
+      throw std::runtime_error("Vertex array buffer size in not correct.");
+    }
+
+    if (!allocateBufferStorage(GL_ELEMENT_ARRAY_BUFFER, m_ebo, count * sizeof(uint16_t), indices, usage)) {
+      Log::error("Vertex element array buffer size in not correct.\n");
+      throw std::runtime_error("Vertex element array buffer size in not correct.");
+    }
+
+    updateMemory();
+  }
+
+  void VertexBuffer::update(std::size_t offset, const Vertex *vertices, std::size_t count) {
+    assert(m_size == sizeof(Vertex));
+    update(offset, static_cast<const void *>(vertices), count);
+  }
 
-    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-    GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vboSize, nullptr, GL_STATIC_DRAW));
-    GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, 0, vboSize, vertices));
+  void VertexBuffer::update(std::size_t offset, const void *vertices, std::size_t count) {
+    if (!m_vbo.isValid() || vertices == nullptr || offset + count > m_vertexCount) {
+      Log::error("Could not update the vertex buffer, invalid range.\n");
+      return;
+    }
+
+    if (count == 0) {
+      return;
+    }
+
+    updateBufferStorage(GL_ARRAY_BUFFER, m_vbo, offset * m_size, count * m_size, vertices, m_vertexCount * m_size, m_usage);
+  }
+
+  void VertexBuffer::updateIndices(std::size_t offset, const uint16_t *indices, std::size_t count) {
+    if (!m_ebo.isValid() || indices == nullptr || offset + count > m_count) {
+      Log::error("Could not update the vertex buffer indices, invalid range.\n");
+      return;
+    }
+
+    if (count == 0) {
+      return;
+    }
 
-    GLint vboUploadedSize = 0;
-    GL_CHECK(glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &vboUploadedSize));
+    assert(*std::max_element(indices, indices + count) < m_vertexCount);
+    updateBufferStorage(GL_ELEMENT_ARRAY_BUFFER, m_ebo, offset * sizeof(uint16_t), count * sizeof(uint16_t), indices, m_count * sizeof(uint16_t), m_usage);
+  }
 
-    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+  void VertexBuffer::resize(std::size_t count) {
+    if (!m_vbo.isValid() || count == 0) {
+      Log::error("Could not resize the vertex buffer, invalid input.\n");
+      return;
+    }
 
-    if(vboSize != static_cast<std::size_t>(vboUploadedSize)) {
+    if (!allocateBufferStorage(GL_ARRAY_BUFFER, m_vbo, count * m_size, nullptr, m_usage)) {
       Log::error("Vertex array buffer size in not correct.\n");
       throw std::runtime_error("Vertex array buffer size in not correct.");
     }
 
-    std::size_t eboSize = count * sizeof(uint16_t);
+    m_vertexCount = count;
 
-    GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo));
-    GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, eboSize, nullptr, GL_STATIC_DRAW));
-    GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, eboSize, indices));
+    if (!m_ebo.isValid()) {
+      m_count = count;
+    }
 
-    GLint eboUploadedSize = 0;
-    GL_CHECK(glGetBufferParameteriv(GL_ELEMENT_ARRAY_BUFFER, GL_BUFFER_SIZE, &eboUploadedSize));
+    updateMemory();
+  }
 
-    GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+  void VertexBuffer::resizeIndices(std::size_t count) {
+    if (!m_ebo.isValid() || count == 0) {
+      Log::error("Could not resize the vertex buffer indices, invalid input.\n");
+      return;
+    }
 
-    if(eboSize != static_cast<std::size_t>(eboUploadedSize)) {
+    if (!allocateBufferStorage(GL_ELEMENT_ARRAY_BUFFER, m_ebo, count * sizeof(uint16_t), nullptr, m_usage)) {
       Log::error("Vertex element array buffer size in not correct.\n");
       throw std::runtime_error("Vertex element array buffer size in not correct.");
     }
+
+    m_count = count;
+    updateMemory();
+  }
+
+  void VertexBuffer::updateMemory() {
+    std::size_t memory = m_vertexCount * m_size;
+
+    if (m_ebo.isValid()) {
+      memory += m_count * sizeof(uint16_t);
+    }
+
+    m_memory.resize(memory);
+  }
+
+  bool VertexBuffer::hasVertexArraySupport() {
+#if defined(GF_OPENGL3) || defined(__APPLE__)
+    return true;
+#else
+    return GLAD_GL_OES_vertex_array_object != 0;
+#endif
+  }
+
+  bool VertexBuffer::bindVertexArray(uint64_t layout) const {
+    assert(hasVertexArraySupport());
+
+    void *context = SDL_GL_GetCurrentContext();
+
+    auto it = std::find_if(m_arrays.begin(), m_arrays.end(), [layout, context](const VertexArray& array) {
+      return array.layout == layout && array.context == context;
+    });
+
+    if (it != m_arrays.end()) {
+      bindVertexArrayName(it->name);
+      return false;
+    }
+
+    if (m_arrays.size() == VertexArrayCountMax) {
+      m_arrays.erase(m_arrays.begin());
+    }
+
+    m_arrays.emplace_back(layout);
+    bindVertexArrayName(m_arrays.back().name);
+
+    // the element array buffer binding is part of the vertex array object
+    bind(this);
+    return true;
+  }
+
+  VertexBuffer::VertexArray::VertexArray(uint64_t arrayLayout)
+  : layout(arrayLayout)
+  , context(SDL_GL_GetCurrentContext())
+  , name(0)
+  {
+    GraphicsTrait<GraphicsTag::VertexArray>::gen(1, &name);
+  }
+
+  VertexBuffer::VertexArray::~VertexArray() {
+    // if the context is not current, the vertex array object can not be
+    // deleted here, it is deleted with its context
+    if (name != 0 && context == SDL_GL_GetCurrentContext()) {
+      GraphicsTrait<GraphicsTag::VertexArray>::del(1, &name);
+    }
+  }
+
+  VertexBuffer::VertexArray::VertexArray(VertexArray&& other) noexcept
+  : layout(other.layout)
+  , context(other.context)
+  , name(std::exchange(other.name, 0))
+  {
+  }
+
+  VertexBuffer::VertexArray& VertexBuffer::VertexArray::operator=(VertexArray&& other) noexcept {
+    std::swap(layout, other.layout);
+    std::swap(context, other.context);
+    std::swap(name, other.name);
+    return *this;
+  }
+
+  void VertexBuffer::unbindVertexArray() {
+    bindVertexArrayName(g_defaultVertexArray);
+  }
+
+  void VertexBuffer::setDefaultVertexArray(unsigned name) {
+    g_defaultVertexArray = name;
   }
 
   void VertexBuffer::bind(const VertexBuffer *buffer) {
@@ -20,13 +20,112 @@
  */
 #include <gf/Widget.h>
 
+#include <cassert>
+
+#include <gf/RenderStates.h>
+#include <gf/RenderTarget.h>
+#include <gf/Transform.h>
+#include <gf/VertexArray.h>
+
 namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
+
+  /*
+   * WidgetBatch
+   */
+
+  void WidgetBatch::clear() {
+    m_vertices.clear();
+    m_commands.clear();
+  }
+
+  bool WidgetBatch::addGeometry(const VertexArray& vertices, const BareTexture *texture, const Matrix3f& transform) {
+    return addGeometry(vertices.getVertexData(), vertices.getVertexCount(), vertices.getPrimitiveType(), texture, transform);
+  }
+
+  bool WidgetBatch::addGeometry(const Vertex *vertices, std::size_t count, PrimitiveType type, const BareTexture *texture, const Matrix3f& transform) {
+    if (count < 3) {
+      return count == 0;
+    }
+
+    std::size_t first = m_vertices.size();
+
+    auto append = [&](std::size_t index) {
+      Vertex vertex = vertices[index];
+      vertex.position = gf::transform(transform, vertex.position);
+      m_vertices.push_back(vertex);
+    };
+
+    switch (type) {
+      case PrimitiveType::Triangles:
+        for (std::size_t i = 0; i < count; ++i) {
+          append(i);
+        }
+        break;
+
+      case PrimitiveType::TriangleStrip:
+        for (std::size_t i = 2; i < count; ++i) {
+          append(i - 2);
+          append(i - 1);
+          append(i);
+        }
+        break;
+
+      case PrimitiveType::TriangleFan:
+        for (std::size_t i = 2; i < count; ++i) {
+          append(0);
+          append(i - 1);
+          append(i);
+        }
+        break;
+
+      default:
+        return false;
+    }
+
+    // merge with the previous command if possible
+    if (!m_commands.empty()) {
+      Command& last = m_commands.back();
+
+      if (last.widget == nullptr && last.texture == texture) {
+        assert(last.first + last.count == first);
+        last.count += m_vertices.size() - first;
+        return true;
+      }
+    }
+
+    m_commands.push_back({ texture, nullptr, first, m_vertices.size() - first });
+    return true;
+  }
+
+  void WidgetBatch::addWidget(Widget& widget) {
+    m_commands.push_back({ nullptr, &widget, 0, 0 });
+  }
+
+  void WidgetBatch::render(RenderTarget& target, const RenderStates& states) {
+    RenderStates localStates = states;
+
+    for (auto& command : m_commands) {
+      if (command.widget != nullptr) {
+        command.widget->draw(target, states);
+        continue;
+      }
+
+      localStates.texture[0] = command.texture;
+      target.draw(m_vertices.data() + command.first, command.count, PrimitiveType::Triangles, localStates);
+    }
+  }
+
+  /*
+   * Widget
+   */
+
   Widget::Widget()
   : m_state(WidgetState::Default)
   , m_callback(nullptr)
+  , m_geometryVersion(0)
   {
 
   }
@@ -46,6 +145,7 @@ inline namespace v1 {
   void Widget::setState(WidgetState state) {
     m_state = state;
     onStateChanged();
+    invalidateGeometry();
   }
 
   void Widget::setCallback(std::function<void()> callback) {
@@ -60,6 +160,10 @@ inline namespace v1 {
     }
   }
 
+  void Widget::batch(WidgetBatch& batch) {
+    batch.addWidget(*this);
+  }
+
   void Widget::onStateChanged() {
     // nothing to do
   }
@@ -59,13 +59,16 @@ inline namespace v1 {
   }
 
   void WidgetContainer::render(RenderTarget &target, const RenderStates &states) {
-    for (Widget& widget : m_widgets) {
-      widget.draw(target, states);
+    if (isBatchOutdated()) {
+      updateBatch();
     }
+
+    m_batch.render(target, states);
   }
 
   void WidgetContainer::addWidget(Widget& widget) {
     m_widgets.push_back(widget);
+    m_batched.clear();
   }
 
   Widget *WidgetContainer::removeWidget(Widget *widget) {
@@ -74,6 +77,7 @@ inline namespace v1 {
 
     if (it != m_widgets.end()) {
       m_widgets.erase(it, m_widgets.end());
+      m_batched.clear();
       return widget;
     }
 
@@ -158,6 +162,8 @@ inline namespace v1 {
     m_widgets.clear();
     m_selectedWidgetIndex = 0;
     m_widgetIsSelected =false;
+    m_batch.clear();
+    m_batched.clear();
   }
 
   void WidgetContainer::unselectCurrentlySelected() {
@@ -183,6 +189,32 @@ inline namespace v1 {
     }
   }
 
+  bool WidgetContainer::isBatchOutdated() const {
+    if (m_batched.getCount() != m_widgets.size()) {
+      return true;
+    }
+
+    for (std::size_t i = 0; i < m_widgets.size(); ++i) {
+      const Widget& widget = m_widgets[i];
+
+      if (m_batched.hasChanged(i, widget.getGeometryVersion(), widget.getTransform())) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void WidgetContainer::updateBatch() {
+    m_batch.clear();
+    m_batched.clear();
+
+    for (Widget& widget : m_widgets) {
+      widget.batch(m_batch);
+      m_batched.add(widget.getGeometryVersion(), widget.getTransform());
+    }
+  }
+
   Widget& WidgetContainer::getCurrent() {
     assert(m_widgetIsSelected);
     assert(m_selectedWidgetIndex < m_widgets.size());
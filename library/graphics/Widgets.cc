@@ -80,6 +80,20 @@ inline namespace v1 {
     target.draw(m_vertices, localStates);
   }
 
+  void TextWidget::batch(WidgetBatch& batch) {
+    if (m_basic.getFont() == nullptr || m_basic.getCharacterSize() == 0) {
+      return;
+    }
+
+    Matrix3f transform = getTransform();
+
+    if (m_basic.getOutlineThickness() > 0) {
+      batch.addGeometry(m_outlineVertices, m_basic.getFontTexture(), transform);
+    }
+
+    batch.addGeometry(m_vertices, m_basic.getFontTexture(), transform);
+  }
+
   bool TextWidget::contains(Vector2f coords) {
     return isInsideBounds(coords, m_basic, *this);
   }
@@ -217,6 +231,8 @@ inline namespace v1 {
     for (auto& vertex : m_outlineVertices) {
       vertex.color = outlineColor;
     }
+
+    invalidateGeometry();
   }
 
   void TextWidget::updateGeometry() {
@@ -244,14 +260,10 @@ inline namespace v1 {
   , m_radius(0)
   , m_padding(0)
   {
-    updateGeometry();
+    updateBackground();
   }
 
   void TextButtonWidget::draw(RenderTarget &target, const RenderStates& states) {
-    RectF bounds = getLocalBounds().grow(m_padding);
-    m_rect.setSize(bounds.getSize());
-    m_rect.setPosition(bounds.getPosition());
-
     RenderStates localStates = states;
     localStates.transform = getTransform();
 
@@ -261,6 +273,19 @@ inline namespace v1 {
     TextWidget::draw(target, states);
   }
 
+  void TextButtonWidget::batch(WidgetBatch& batch) {
+    Matrix3f transform = getTransform() * m_rect.getTransform();
+
+    if (m_rect.getOutlineThickness() > 0.0f) {
+      batch.addGeometry(m_rect.getOutlineGeometry(), nullptr, transform);
+    }
+
+    batch.addGeometry(m_rect.getGeometry(), m_rect.hasTexture() ? &m_rect.getTexture() : nullptr, transform);
+
+    // text over background
+    TextWidget::batch(batch);
+  }
+
   bool TextButtonWidget::contains(Vector2f coords) {
     return isInsideBounds(coords, m_rect, *this, -m_rect.getPosition());
   }
@@ -294,6 +319,15 @@ inline namespace v1 {
   }
 
   void TextButtonWidget::updateGeometry() {
+    TextWidget::updateGeometry();
+    updateBackground();
+  }
+
+  void TextButtonWidget::updateBackground() {
+    // the background depends on the bounds of the text
+    RectF bounds = getLocalBounds().grow(m_padding);
+    m_rect.setSize(bounds.getSize());
+    m_rect.setPosition(bounds.getPosition());
     m_rect.setOutlineThickness(m_backgroundOutlineThickness);
 
     switch(getState()) {
@@ -312,11 +346,12 @@ inline namespace v1 {
     }
 
     m_rect.setRadius(m_radius);
+    invalidateGeometry();
   }
 
   void TextButtonWidget::onStateChanged() {
     TextWidget::onStateChanged();
-    updateGeometry();
+    updateBackground();
   }
 
   /*
@@ -353,6 +388,16 @@ inline namespace v1 {
     target.draw(m_vertices, 4, PrimitiveType::TriangleStrip, localStates);
   }
 
+  void SpriteWidget::batch(WidgetBatch& batch) {
+    const BasicSprite& sprite = getSprite();
+
+    if (!sprite.hasTexture()) {
+      return;
+    }
+
+    batch.addGeometry(m_vertices, 4, PrimitiveType::TriangleStrip, &sprite.getTexture(), getTransform());
+  }
+
   bool SpriteWidget::contains(Vector2f coords) {
     return isInsideBounds(coords, getSprite(), *this);
   }
@@ -414,6 +459,7 @@ inline namespace v1 {
 
   void SpriteWidget::updateGeometry() {
     getSprite().updateGeometry(m_vertices);
+    invalidateGeometry();
   }
 
   void SpriteWidget::onStateChanged() {
@@ -482,6 +528,16 @@ inline namespace v1 {
     target.draw(m_vertices, 4, PrimitiveType::TriangleStrip, localStates);
   }
 
+  void ChoiceSpriteWidget::batch(WidgetBatch& batch) {
+    const BasicSprite& sprite = getSprite();
+
+    if (!sprite.hasTexture()) {
+      return;
+    }
+
+    batch.addGeometry(m_vertices, 4, PrimitiveType::TriangleStrip, &sprite.getTexture(), getTransform());
+  }
+
   bool ChoiceSpriteWidget::contains(Vector2f coords) {
     return isInsideBounds(coords, getSprite(), *this);
   }
@@ -518,6 +574,7 @@ inline namespace v1 {
 
   void ChoiceSpriteWidget::updateGeometry() {
     getSprite().updateGeometry(m_vertices);
+    invalidateGeometry();
   }
 
   BasicSprite& ChoiceSpriteWidget::getSprite() {
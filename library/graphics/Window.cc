@@ -34,10 +34,12 @@
 #include <gf/Keyboard.h>
 #include <gf/Log.h>
 #include <gf/Mouse.h>
+#include <gf/Shader.h>
 #include <gf/Sleep.h>
 #include <gf/Unused.h>
 #include <gf/Vector.h>
 #include <gf/VectorOps.h>
+#include <gf/VertexBuffer.h>
 
 #include <gfpriv/GlDebug.h>
 #include <gfpriv/GlFwd.h>
@@ -135,9 +137,9 @@ inline namespace v1 {
 #ifdef GF_OPENGL3
       GL_CHECK(glGenVertexArrays(1, &m_vao));
       GL_CHECK(glBindVertexArray(m_vao));
-#else
-      gf::unused(m_vao);
 #endif
+
+      VertexBuffer::setDefaultVertexArray(m_vao);
     }
   }
 
@@ -145,6 +147,7 @@ inline namespace v1 {
     makeMainContextCurrent();
 
     if (m_sharedContext != nullptr) {
+      Shader::releaseSharedPrograms(m_sharedContext);
       SDL_CHECK(SDL_GL_DeleteContext(m_sharedContext));
     }
 
@@ -153,6 +156,8 @@ inline namespace v1 {
       GL_CHECK(glBindVertexArray(0));
       GL_CHECK(glDeleteVertexArrays(1, &m_vao));
 #endif
+      VertexBuffer::setDefaultVertexArray(0);
+      Shader::releaseSharedPrograms(m_mainContext);
       SDL_CHECK(SDL_GL_DeleteContext(m_mainContext));
     }
 
@@ -815,14 +820,18 @@ inline namespace v1 {
     if (SDL_CHECK_EXPR(SDL_GL_GetCurrentContext()) != m_mainContext) {
       SDL_CHECK(SDL_GL_MakeCurrent(m_window, m_mainContext));
     }
+
+    VertexBuffer::setDefaultVertexArray(m_vao);
   }
 
   void Window::makeSharedContextCurrent() {
     SDL_CHECK(SDL_GL_MakeCurrent(m_window, m_sharedContext));
+    VertexBuffer::setDefaultVertexArray(0);
   }
 
   void Window::makeNoContextCurrent() {
     SDL_CHECK(SDL_GL_MakeCurrent(m_window, nullptr));
+    VertexBuffer::setDefaultVertexArray(0);
   }
 
   std::vector<Event> Window::g_pendingEvents;
@@ -49,16 +49,20 @@
 #include "Font.cc"
 #include "Gamepad.cc"
 #include "GlDebug.cc"
+#include "GpuNoises.cc"
 #include "GraphicsHandle.cc"
 #include "GraphicsInfo.cc"
 #include "Grid.cc"
+#include "HeadlessContext.cc"
 #include "Keyboard.cc"
 #include "Library.cc"
 #include "Logo.cc"
+#include "MemoryOverlay.cc"
 #include "Monitor.cc"
 #include "NinePatch.cc"
 #include "Particles.cc"
 #include "Paths.cc"
+#include "PixelReadback.cc"
 #include "PostProcessing.cc"
 #include "RenderPipeline.cc"
 #include "RenderTarget.cc"
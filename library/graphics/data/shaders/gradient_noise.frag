@@ -0,0 +1,117 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#version 100
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+varying vec2 v_texCoords; // noise coordinates
+
+uniform sampler2D u_lattice; // gradients of the 256x256 lattice
+uniform int u_step; // 0: linear, 1: cubic, 2: quintic, 3: cosine
+
+// vectors are stored with 16 bits per coordinate in [-2, 2]
+vec2 decodeVector(vec4 texel) {
+  // the bytes are rounded because the texel values may not be exact multiples of 1/255
+  vec4 bytes = floor(texel * 255.0 + 0.5);
+  vec2 value = (bytes.rb * 256.0 + bytes.ga) / 65535.0;
+  return value * 4.0 - 2.0;
+}
+
+vec2 gradientAt(vec2 lattice) {
+  return decodeVector(texture2D(u_lattice, (lattice + 0.5) / 256.0));
+}
+
+float interpolationStep(float t) {
+  if (u_step == 0) {
+    return t;
+  }
+
+  if (u_step == 1) {
+    return (-2.0 * t + 3.0) * t * t;
+  }
+
+  if (u_step == 2) {
+    return ((6.0 * t - 15.0) * t + 10.0) * t * t * t;
+  }
+
+  return (1.0 - cos(3.14159265358979323846 * t)) * 0.5;
+}
+
+float noise(vec2 position) {
+  vec2 lattice = floor(position);
+  vec2 r = position - lattice;
+  lattice = mod(lattice, 256.0);
+
+  float p00 = dot(gradientAt(lattice                  ), r                  );
+  float p10 = dot(gradientAt(lattice + vec2(1.0, 0.0)), r - vec2(1.0, 0.0));
+  float p01 = dot(gradientAt(lattice + vec2(0.0, 1.0)), r - vec2(0.0, 1.0));
+  float p11 = dot(gradientAt(lattice + vec2(1.0, 1.0)), r - vec2(1.0, 1.0));
+
+  float u = interpolationStep(r.x);
+  float v = interpolationStep(r.y);
+
+  return mix(mix(p00, p10, u), mix(p01, p11, u), v);
+}
+
+uniform float u_scale;
+uniform int u_octaves;
+uniform float u_lacunarity;
+uniform float u_persistence;
+uniform float u_dimension;
+
+uniform vec2 u_valueRange;
+uniform int u_encoding; // 0: grayscale, 1: packed
+
+const int MaxOctaves = 16;
+
+void main(void) {
+  vec2 position = v_texCoords * u_scale;
+
+  float value = 0.0;
+  float frequency = 1.0;
+  float amplitude = 1.0;
+
+  for (int k = 0; k < MaxOctaves; ++k) {
+    if (k >= u_octaves) {
+      break;
+    }
+
+    value += noise(position * frequency) * pow(amplitude, u_dimension);
+
+    frequency *= u_lacunarity;
+    amplitude *= u_persistence;
+  }
+
+  float normalized = clamp((value - u_valueRange.x) / (u_valueRange.y - u_valueRange.x), 0.0, 1.0);
+
+  if (u_encoding == 1) {
+    // 16 bits in red (high byte) and green (low byte)
+    float quantized = floor(normalized * 65535.0 + 0.5);
+    float high = floor(quantized / 256.0);
+    gl_FragColor = vec4(high / 255.0, (quantized - high * 256.0) / 255.0, 0.0, 1.0);
+  } else {
+    gl_FragColor = vec4(normalized, normalized, normalized, 1.0);
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#version 100
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+// the grid is always seen as a grid of pointy hexagons, the coordinates
+// of a flat grid are swapped before
+
+varying vec4 v_color;
+varying vec2 v_texCoords; // local coordinates
+
+uniform float u_radius;
+uniform float u_parity; // 0.0 for odd index, 1.0 for even index
+uniform vec2 u_gridSize;
+uniform float u_pixelSize; // size of a pixel in local coordinates
+uniform float u_lineWidth; // in pixels
+
+const float Sqrt3 = 1.7320508;
+
+vec2 computeCenter(vec2 coords) {
+  float shift = mod(coords.y + u_parity, 2.0);
+  return vec2(u_radius * Sqrt3 * (0.5 + coords.x + 0.5 * shift), u_radius * (1.0 + 1.5 * coords.y));
+}
+
+vec2 computeCoords(vec2 position) {
+  float j = floor((position.y - u_radius) / (1.5 * u_radius) + 0.5);
+  float shift = mod(j + u_parity, 2.0);
+  float i = floor(position.x / (u_radius * Sqrt3) - 0.5 * shift);
+  return vec2(i, j);
+}
+
+bool isInside(vec2 coords) {
+  return coords.x >= 0.0 && coords.y >= 0.0 && coords.x < u_gridSize.x && coords.y < u_gridSize.y;
+}
+
+void main(void) {
+  vec2 position = v_texCoords;
+
+  // the closest center is in one of the two surrounding rows
+  float row = floor((position.y - u_radius) / (1.5 * u_radius));
+  vec2 coords = vec2(0.0);
+  float best = 0.0;
+
+  for (int k = 0; k < 2; ++k) {
+    float j = row + float(k);
+    float shift = mod(j + u_parity, 2.0);
+    vec2 candidate = vec2(floor(position.x / (u_radius * Sqrt3) - 0.5 * shift), j);
+    vec2 offset = position - computeCenter(candidate);
+
+    if (k == 0 || dot(offset, offset) < best) {
+      coords = candidate;
+      best = dot(offset, offset);
+    }
+  }
+
+  // distance to the closest edge, in pixels
+  vec2 center = computeCenter(coords);
+  vec2 d = position - center;
+  vec2 n1 = vec2(1.0, 0.0);
+  vec2 n2 = vec2(0.5, 0.5 * Sqrt3);
+  vec2 n3 = vec2(-0.5, 0.5 * Sqrt3);
+  vec3 projections = vec3(dot(d, n1), dot(d, n2), dot(d, n3));
+  vec3 a = abs(projections);
+  float inradius = 0.5 * Sqrt3 * u_radius;
+  float lineDistance = (inradius - max(a.x, max(a.y, a.z))) / u_pixelSize;
+
+  // the edge is drawn if the cell or the cell on the other side is in the grid
+  vec2 normal = n3 * sign(projections.z);
+
+  if (a.x >= a.y && a.x >= a.z) {
+    normal = n1 * sign(projections.x);
+  } else if (a.y >= a.z) {
+    normal = n2 * sign(projections.y);
+  }
+
+  vec2 neighbor = computeCoords(center + 2.0 * inradius * normal);
+
+  float alpha = clamp(0.5 * u_lineWidth + 0.5 - lineDistance, 0.0, min(u_lineWidth, 1.0));
+
+  if (!isInside(coords) && !isInside(neighbor)) {
+    alpha = 0.0;
+  }
+
+  gl_FragColor = vec4(v_color.rgb, v_color.a * alpha);
+}
@@ -0,0 +1,124 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#version 100
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+varying vec2 v_texCoords; // noise coordinates
+
+uniform sampler2D u_lattice; // gradients of the 256x256 lattice
+
+// vectors are stored with 16 bits per coordinate in [-2, 2]
+vec2 decodeVector(vec4 texel) {
+  // the bytes are rounded because the texel values may not be exact multiples of 1/255
+  vec4 bytes = floor(texel * 255.0 + 0.5);
+  vec2 value = (bytes.rb * 256.0 + bytes.ga) / 65535.0;
+  return value * 4.0 - 2.0;
+}
+
+vec2 gradientAt(vec2 lattice) {
+  return decodeVector(texture2D(u_lattice, (lattice + 0.5) / 256.0));
+}
+
+const float F2 = 0.366025403784438646763723170752; // (sqrt(3) - 1) / 2
+const float G2 = 0.211324865405187117745425609748; // K / (1 + 2 * K)
+
+float noise(vec2 position) {
+  vec2 lattice = floor(position + (position.x + position.y) * F2);
+  vec2 p0 = position - (lattice - (lattice.x + lattice.y) * G2);
+
+  vec2 offset = p0.x > p0.y ? vec2(1.0, 0.0) : vec2(0.0, 1.0);
+
+  vec2 p1 = p0 - offset + G2;
+  vec2 p2 = p0 - 1.0 + 2.0 * G2;
+
+  lattice = mod(lattice, 256.0);
+
+  float res = 0.0;
+
+  float d0 = 0.5 - dot(p0, p0);
+
+  if (d0 > 0.0) {
+    d0 *= d0;
+    res += d0 * d0 * dot(gradientAt(lattice), p0);
+  }
+
+  float d1 = 0.5 - dot(p1, p1);
+
+  if (d1 > 0.0) {
+    d1 *= d1;
+    res += d1 * d1 * dot(gradientAt(lattice + offset), p1);
+  }
+
+  float d2 = 0.5 - dot(p2, p2);
+
+  if (d2 > 0.0) {
+    d2 *= d2;
+    res += d2 * d2 * dot(gradientAt(lattice + 1.0), p2);
+  }
+
+  return 45.23065 * res;
+}
+
+uniform float u_scale;
+uniform int u_octaves;
+uniform float u_lacunarity;
+uniform float u_persistence;
+uniform float u_dimension;
+
+uniform vec2 u_valueRange;
+uniform int u_encoding; // 0: grayscale, 1: packed
+
+const int MaxOctaves = 16;
+
+void main(void) {
+  vec2 position = v_texCoords * u_scale;
+
+  float value = 0.0;
+  float frequency = 1.0;
+  float amplitude = 1.0;
+
+  for (int k = 0; k < MaxOctaves; ++k) {
+    if (k >= u_octaves) {
+      break;
+    }
+
+    value += noise(position * frequency) * pow(amplitude, u_dimension);
+
+    frequency *= u_lacunarity;
+    amplitude *= u_persistence;
+  }
+
+  float normalized = clamp((value - u_valueRange.x) / (u_valueRange.y - u_valueRange.x), 0.0, 1.0);
+
+  if (u_encoding == 1) {
+    // 16 bits in red (high byte) and green (low byte)
+    float quantized = floor(normalized * 65535.0 + 0.5);
+    float high = floor(quantized / 256.0);
+    gl_FragColor = vec4(high / 255.0, (quantized - high * 256.0) / 255.0, 0.0, 1.0);
+  } else {
+    gl_FragColor = vec4(normalized, normalized, normalized, 1.0);
+  }
+}
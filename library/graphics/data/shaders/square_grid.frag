@@ -0,0 +1,46 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#version 100
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+varying vec4 v_color;
+varying vec2 v_texCoords; // local coordinates
+
+uniform vec2 u_cellSize;
+uniform vec2 u_pixelSize; // size of a pixel in local coordinates
+uniform float u_lineWidth; // in pixels
+
+void main(void) {
+  // distance to the closest line on each axis, in pixels
+  vec2 cell = v_texCoords / u_cellSize;
+  vec2 lineDistance = abs(fract(cell + 0.5) - 0.5) * u_cellSize / u_pixelSize;
+
+  // coverage of a pixel by a line of width u_lineWidth
+  vec2 coverage = clamp(0.5 * u_lineWidth + 0.5 - lineDistance, 0.0, min(u_lineWidth, 1.0));
+  float alpha = max(coverage.x, coverage.y);
+
+  gl_FragColor = vec4(v_color.rgb, v_color.a * alpha);
+}
@@ -0,0 +1,152 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#version 100
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+varying vec2 v_texCoords; // noise coordinates
+
+uniform sampler2D u_cells; // points of the noise, 256 per row
+uniform vec2 u_cellsSize; // size of the texture of points
+uniform int u_cellCount;
+uniform vec4 u_coeffs;
+uniform int u_distance; // 0: manhattan, 1: square, 2: euclidean, 3: chebyshev, 4: natural
+
+const int MaxCells = 1024;
+
+// vectors are stored with 16 bits per coordinate in [-2, 2]
+vec2 decodeVector(vec4 texel) {
+  // the bytes are rounded because the texel values may not be exact multiples of 1/255
+  vec4 bytes = floor(texel * 255.0 + 0.5);
+  vec2 value = (bytes.rb * 256.0 + bytes.ga) / 65535.0;
+  return value * 4.0 - 2.0;
+}
+
+vec2 cellAt(int index) {
+  float i = float(index);
+  float row = floor(i / 256.0);
+  return decodeVector(texture2D(u_cells, (vec2(i - row * 256.0, row) + 0.5) / u_cellsSize));
+}
+
+float cellDistance(vec2 lhs, vec2 rhs) {
+  vec2 d = abs(lhs - rhs);
+
+  if (u_distance == 0) {
+    return d.x + d.y;
+  }
+
+  if (u_distance == 1) {
+    return dot(d, d);
+  }
+
+  if (u_distance == 2) {
+    return length(d);
+  }
+
+  if (u_distance == 3) {
+    return max(d.x, d.y);
+  }
+
+  return d.x + d.y + dot(d, d);
+}
+
+float noise(vec2 position) {
+  vec2 here = fract(position);
+
+  // the four smallest distances, in increasing order
+  vec4 nearest = vec4(1000.0);
+
+  for (int k = 0; k < MaxCells; ++k) {
+    if (k >= u_cellCount) {
+      break;
+    }
+
+    float d = cellDistance(here, cellAt(k));
+
+    if (d < nearest.w) {
+      if (d < nearest.z) {
+        nearest.w = nearest.z;
+
+        if (d < nearest.y) {
+          nearest.z = nearest.y;
+
+          if (d < nearest.x) {
+            nearest.y = nearest.x;
+            nearest.x = d;
+          } else {
+            nearest.y = d;
+          }
+        } else {
+          nearest.z = d;
+        }
+      } else {
+        nearest.w = d;
+      }
+    }
+  }
+
+  return dot(u_coeffs, nearest);
+}
+
+uniform float u_scale;
+uniform int u_octaves;
+uniform float u_lacunarity;
+uniform float u_persistence;
+uniform float u_dimension;
+
+uniform vec2 u_valueRange;
+uniform int u_encoding; // 0: grayscale, 1: packed
+
+const int MaxOctaves = 16;
+
+void main(void) {
+  vec2 position = v_texCoords * u_scale;
+
+  float value = 0.0;
+  float frequency = 1.0;
+  float amplitude = 1.0;
+
+  for (int k = 0; k < MaxOctaves; ++k) {
+    if (k >= u_octaves) {
+      break;
+    }
+
+    value += noise(position * frequency) * pow(amplitude, u_dimension);
+
+    frequency *= u_lacunarity;
+    amplitude *= u_persistence;
+  }
+
+  float normalized = clamp((value - u_valueRange.x) / (u_valueRange.y - u_valueRange.x), 0.0, 1.0);
+
+  if (u_encoding == 1) {
+    // 16 bits in red (high byte) and green (low byte)
+    float quantized = floor(normalized * 65535.0 + 0.5);
+    float high = floor(quantized / 256.0);
+    gl_FragColor = vec4(high / 255.0, (quantized - high * 256.0) / 255.0, 0.0, 1.0);
+  } else {
+    gl_FragColor = vec4(normalized, normalized, normalized, 1.0);
+  }
+}
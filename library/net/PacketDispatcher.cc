@@ -0,0 +1,227 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/PacketDispatcher.h>
+
+#include <cassert>
+#include <cstring>
+
+#include <gf/Log.h>
+#include <gf/Streams.h>
+
+#include <gfpriv/SocketPrivate.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    // see Serializer: magic (2 bytes), version (2 bytes), then the Id of Packet::is()
+    constexpr std::size_t PacketIdOffset = 4;
+    constexpr std::size_t PacketIdSize = 8;
+    constexpr std::size_t PacketFrameSize = sizeof(priv::SizeHeader);
+    constexpr std::size_t PacketMinimumCapacity = 16;
+
+    bool readPacketId(Span<const uint8_t> bytes, Id& type) {
+      if (bytes.getSize() < PacketIdOffset + PacketIdSize || bytes[0] != 'g' || bytes[1] != 'f') {
+        return false;
+      }
+
+      type = 0;
+
+      for (std::size_t i = 0; i < PacketIdSize; ++i) {
+        type = (type << 8) | bytes[PacketIdOffset + i];
+      }
+
+      return true;
+    }
+
+    std::size_t computePacketSlot(Id type, std::size_t mask) {
+      return static_cast<std::size_t>(type ^ (type >> 32)) & mask;
+    }
+
+  }
+
+  PacketDispatcher::Slot::~Slot() = default;
+
+  PacketDispatcher::PacketDispatcher()
+  : m_count(0)
+  {
+  }
+
+  PacketDispatcher::PacketDispatcher(PacketDispatcher&&) noexcept = default;
+
+  PacketDispatcher& PacketDispatcher::operator=(PacketDispatcher&&) noexcept = default;
+
+  PacketDispatcher::~PacketDispatcher() = default;
+
+  void PacketDispatcher::unregisterHandler(Id type) {
+    std::size_t index = findIndex(type);
+
+    if (index == m_entries.size()) {
+      return;
+    }
+
+    // backward shift deletion, so that no tombstone is needed
+    std::size_t mask = m_entries.size() - 1;
+    std::size_t hole = index;
+    std::size_t next = (hole + 1) & mask;
+
+    while (m_entries[next].type != InvalidId) {
+      std::size_t home = computePacketSlot(m_entries[next].type, mask);
+
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        m_entries[hole] = std::move(m_entries[next]);
+        hole = next;
+      }
+
+      next = (next + 1) & mask;
+    }
+
+    m_entries[hole].type = InvalidId;
+    m_entries[hole].slot.reset();
+    --m_count;
+  }
+
+  bool PacketDispatcher::hasHandler(Id type) const {
+    return findSlot(type) != nullptr;
+  }
+
+  bool PacketDispatcher::dispatch(Span<const uint8_t> bytes) {
+    Id type;
+
+    if (!readPacketId(bytes, type)) {
+      Log::error("The packet is not a gf packet.\n");
+      return false;
+    }
+
+    Slot *slot = findSlot(type);
+
+    if (slot == nullptr) {
+      return false;
+    }
+
+    MemoryInputStream stream(bytes);
+    Deserializer deserializer(stream);
+    stream.skip(PacketIdSize);
+    slot->handle(deserializer);
+    return true;
+  }
+
+  std::size_t PacketDispatcher::dispatchBuffer(Span<const uint8_t> buffer, std::size_t *dispatched) {
+    std::size_t offset = 0;
+    std::size_t count = 0;
+
+    while (buffer.getSize() - offset >= PacketFrameSize) {
+      priv::SizeHeader header;
+      std::memcpy(header.data, buffer.getData() + offset, PacketFrameSize);
+      uint64_t size = priv::decodeHeader(header);
+
+      if (buffer.getSize() - offset - PacketFrameSize < size) {
+        break;
+      }
+
+      offset += PacketFrameSize;
+
+      if (dispatch(buffer.slice(offset, offset + static_cast<std::size_t>(size)))) {
+        ++count;
+      }
+
+      offset += static_cast<std::size_t>(size);
+    }
+
+    if (dispatched != nullptr) {
+      *dispatched = count;
+    }
+
+    return offset;
+  }
+
+  void PacketDispatcher::insertSlot(Id type, std::unique_ptr<Slot> slot) {
+    assert(type != InvalidId);
+
+    if ((m_count + 1) * 2 > m_entries.size()) {
+      rehash(m_entries.empty() ? PacketMinimumCapacity : m_entries.size() * 2);
+    }
+
+    std::size_t mask = m_entries.size() - 1;
+    std::size_t index = computePacketSlot(type, mask);
+
+    while (m_entries[index].type != InvalidId && m_entries[index].type != type) {
+      index = (index + 1) & mask;
+    }
+
+    if (m_entries[index].type == InvalidId) {
+      ++m_count;
+    }
+
+    m_entries[index].type = type;
+    m_entries[index].slot = std::move(slot);
+  }
+
+  PacketDispatcher::Slot *PacketDispatcher::findSlot(Id type) const {
+    std::size_t index = findIndex(type);
+
+    if (index == m_entries.size()) {
+      return nullptr;
+    }
+
+    return m_entries[index].slot.get();
+  }
+
+  std::size_t PacketDispatcher::findIndex(Id type) const {
+    if (m_entries.empty() || type == InvalidId) {
+      return m_entries.size();
+    }
+
+    std::size_t mask = m_entries.size() - 1;
+    std::size_t index = computePacketSlot(type, mask);
+
+    while (m_entries[index].type != InvalidId) {
+      if (m_entries[index].type == type) {
+        return index;
+      }
+
+      index = (index + 1) & mask;
+    }
+
+    return m_entries.size();
+  }
+
+  void PacketDispatcher::rehash(std::size_t capacity) {
+    assert((capacity & (capacity - 1)) == 0);
+
+    std::vector<Entry> entries(capacity);
+    std::swap(entries, m_entries);
+    m_count = 0;
+
+    for (auto& entry : entries) {
+      if (entry.type != InvalidId) {
+        insertSlot(entry.type, std::move(entry.slot));
+      }
+    }
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
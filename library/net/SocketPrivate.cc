@@ -94,6 +94,23 @@ namespace priv {
 
 #endif
 
+  bool nativeSetReuseOption(SocketHandle handle, int option) {
+#ifdef _WIN32
+    BOOL value = TRUE;
+    int err = ::setsockopt(handle, SOL_SOCKET, option, reinterpret_cast<const char *>(&value), sizeof(value));
+#else
+    int value = 1;
+    int err = ::setsockopt(handle, SOL_SOCKET, option, &value, sizeof(value));
+#endif
+
+    if (err != 0) {
+      gf::Log::error("Could not set the socket option: %s\n", getErrorString().c_str());
+      return false;
+    }
+
+    return true;
+  }
+
   SocketSelectorStatus nativePoll(std::vector<pollfd>& fds, Time duration) {
     auto ms = duration.asMilliseconds();
 
@@ -115,7 +132,7 @@ namespace priv {
     return SocketSelectorStatus::Event;
   }
 
-  SocketHandle nativeBindListen(const std::string& service, SocketFamily family) {
+  SocketHandle nativeBindListen(const std::string& service, SocketFamily family, bool reuseAddress, bool reusePort) {
     auto addresses = getLocalAddressInfo(service, SocketType::Tcp, family);
 
     for (auto info : addresses) {
@@ -125,6 +142,24 @@ namespace priv {
         continue;
       }
 
+      if (reuseAddress && !nativeSetReuseOption(sock, SO_REUSEADDR)) {
+        nativeCloseSocket(sock);
+        continue;
+      }
+
+#ifdef GF_REUSE_PORT_OPTION
+      if (reusePort && !nativeSetReuseOption(sock, GF_REUSE_PORT_OPTION)) {
+        nativeCloseSocket(sock);
+        continue;
+      }
+#else
+      if (reusePort) {
+        gf::Log::error("The system can not balance the connections of a shared port.\n");
+        nativeCloseSocket(sock);
+        return InvalidSocketHandle;
+      }
+#endif
+
       if (::bind(sock, info.address.asSockAddr(), info.address.length) != 0) {
         nativeCloseSocket(sock);
         continue;
@@ -164,26 +199,47 @@ namespace priv {
     return InvalidSocketHandle;
   }
 
-  SocketHandle nativeBind(const std::string& service, SocketFamily family) {
-    auto addresses = getLocalAddressInfo(service, SocketType::Udp, family);
+  namespace {
 
-    for (auto info : addresses) {
-      SocketHandle sock = ::socket(static_cast<int>(info.family), static_cast<int>(info.type), 0);
+    SocketHandle bindUdpAddresses(const std::vector<SocketAddressInfo>& addresses) {
+      for (auto info : addresses) {
+        SocketHandle sock = ::socket(static_cast<int>(info.family), static_cast<int>(info.type), 0);
 
-      if (sock == InvalidSocketHandle) {
-        continue;
-      }
+        if (sock == InvalidSocketHandle) {
+          continue;
+        }
 
-      if (::bind(sock, info.address.asSockAddr(), info.address.length) != 0) {
-        nativeCloseSocket(sock);
-        continue;
+        if (::bind(sock, info.address.asSockAddr(), info.address.length) != 0) {
+          nativeCloseSocket(sock);
+          continue;
+        }
+
+        return sock;
       }
 
-      return sock;
+      return InvalidSocketHandle;
     }
 
-    gf::Log::error("Unable to bind service '%s'\n", service.c_str());
-    return InvalidSocketHandle;
+  }
+
+  SocketHandle nativeBind(const std::string& service, SocketFamily family) {
+    SocketHandle sock = bindUdpAddresses(getLocalAddressInfo(service, SocketType::Udp, family));
+
+    if (sock == InvalidSocketHandle) {
+      gf::Log::error("Unable to bind service '%s'\n", service.c_str());
+    }
+
+    return sock;
+  }
+
+  SocketHandle nativeBind(const std::string& hostname, const std::string& service, SocketFamily family) {
+    SocketHandle sock = bindUdpAddresses(getRemoteAddressInfo(hostname, service, SocketType::Udp, family));
+
+    if (sock == InvalidSocketHandle) {
+      gf::Log::error("Unable to bind '%s:%s'\n", hostname.c_str(), service.c_str());
+    }
+
+    return sock;
   }
 
   namespace {
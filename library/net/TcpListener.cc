@@ -42,15 +42,15 @@ namespace gf {
 inline namespace v1 {
 #endif
 
-  TcpListener::TcpListener(const std::string& service, SocketFamily family)
+  TcpListener::TcpListener(const std::string& service, SocketFamily family, Flags<TcpListenerHints> hints)
   {
-    setHandle(priv::nativeBindListen(service, family));
+    setHandle(priv::nativeBindListen(service, family, hints.test(TcpListenerHints::ReuseAddress), hints.test(TcpListenerHints::ReusePort)));
   }
 
   TcpSocket TcpListener::accept() {
     SocketHandle handle = ::accept(getHandle(), nullptr, nullptr);
 
-    if (handle == InvalidSocketHandle) {
+    if (handle == InvalidSocketHandle && !priv::nativeWouldBlock(priv::getErrorCode())) {
       gf::Log::error("Error while accepting. Reason: %s\n", priv::getErrorString().c_str());
     }
 
@@ -61,13 +61,21 @@ inline namespace v1 {
     address.length = sizeof(address.storage);
     SocketHandle handle = ::accept(getHandle(), reinterpret_cast<sockaddr*>(&address.storage), &address.length);
 
-    if (handle == InvalidSocketHandle) {
+    if (handle == InvalidSocketHandle && !priv::nativeWouldBlock(priv::getErrorCode())) {
       gf::Log::error("Error while accepting. Reason: %s\n", priv::getErrorString().c_str());
     }
 
     return TcpSocket(handle);
   }
 
+  bool TcpListener::isReusePortSupported() {
+#ifdef GF_REUSE_PORT_OPTION
+    return true;
+#else
+    return false;
+#endif
+  }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 }
 #endif
@@ -0,0 +1,568 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/TcpServer.h>
+
+#include <cassert>
+#include <cinttypes>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+
+#include <gf/Log.h>
+#include <gf/SocketSelector.h>
+#include <gf/SpscQueue.h>
+#include <gf/UdpSocket.h>
+
+#include <gfpriv/SocketPrivate.h>
+
+namespace gf {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+inline namespace v1 {
+#endif
+
+  namespace {
+
+    constexpr std::size_t TcpServerQueueCapacity = 4096;
+    constexpr std::size_t TcpServerReadSize = 64 * 1024;
+    constexpr std::size_t TcpServerHeaderSize = sizeof(priv::SizeHeader::data);
+
+    void increment(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+      // only the worker writes the counter, so a relaxed load and store is enough
+      counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+  }
+
+  struct TcpServer::Worker {
+    enum class CommandType {
+      Send,
+      Disconnect,
+    };
+
+    struct Command {
+      CommandType type = CommandType::Send;
+      TcpServerConnection connection = 0;
+      std::vector<uint8_t> bytes;
+    };
+
+    struct Client {
+      TcpSocket socket;
+      std::vector<uint8_t> input;
+      std::vector<uint8_t> output;
+      std::size_t outputOffset = 0;
+      std::vector<std::size_t> outputPacketEnds; // offset of the end of each packet in output
+      std::size_t outputPacketsSent = 0;
+    };
+
+    struct AtomicStats {
+      std::atomic<uint64_t> accepted{0};
+      std::atomic<uint64_t> closed{0};
+      std::atomic<uint64_t> packetsReceived{0};
+      std::atomic<uint64_t> packetsSent{0};
+      std::atomic<uint64_t> bytesReceived{0};
+      std::atomic<uint64_t> bytesSent{0};
+    };
+
+    Worker(std::size_t workerIndex, TcpListener *sharedListener, const std::string& service, SocketFamily family, const TcpServerLimits& serverLimits)
+    : index(workerIndex)
+    , limits(serverLimits)
+    , listener(sharedListener)
+    , wakeup("127.0.0.1", "0", SocketFamily::IPv4)
+    , events(TcpServerQueueCapacity)
+    , commands(TcpServerQueueCapacity)
+    , stop(false)
+    , sleeping(false)
+    , readBuffer(TcpServerReadSize)
+    , nextConnection(1)
+    {
+      if (listener == nullptr) {
+        ownListener = TcpListener(service, family, TcpListenerHints::ReuseAddress | TcpListenerHints::ReusePort);
+        listener = &ownListener;
+
+        if (ownListener) {
+          ownListener.setNonBlocking();
+        }
+      }
+
+      wakeupAddress = wakeup.getLocalAddress();
+      wakeup.setNonBlocking();
+    }
+
+    void wake() {
+      // see the other side in run()
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (sleeping.exchange(false)) {
+        uint8_t byte = 0;
+        wakeup.sendRawBytesTo(Span<const uint8_t>(&byte, 1), wakeupAddress);
+      }
+    }
+
+    void run() {
+      selector.addSocket(*listener);
+      selector.addSocket(wakeup);
+
+      while (!stop.load()) {
+        flushEvents();
+        executeCommands();
+        flushOutputs();
+
+        // an idle worker sleeps until a socket is ready or the logic wakes it up
+        Time timeout = milliseconds(100);
+
+        if (!pendingEvents.empty() || !pendingOutputs.empty()) {
+          timeout = milliseconds(1);
+        }
+
+        sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!commands.isEmpty() || stop.load()) {
+          sleeping.store(false);
+          continue;
+        }
+
+        auto status = selector.wait(timeout);
+        sleeping.store(false);
+
+        if (status != SocketSelectorStatus::Event) {
+          continue;
+        }
+
+        if (selector.isReady(wakeup)) {
+          uint8_t buffer[64];
+          SocketAddress address;
+
+          while (wakeup.recvRawBytesFrom(buffer, address).status == SocketStatus::Data) {
+            // drain the wake up datagrams
+          }
+        }
+
+        if (!pendingEvents.empty()) {
+          // the logic does not keep pace, let TCP slow the clients down
+          continue;
+        }
+
+        if (selector.isReady(*listener)) {
+          acceptClients();
+        }
+
+        receivePackets();
+      }
+
+      for (auto& item : clients) {
+        item.second.socket = TcpSocket();
+      }
+
+      clients.clear();
+    }
+
+    void acceptClients() {
+      for (;;) {
+        TcpSocket socket = listener->accept();
+
+        if (!socket) {
+          return;
+        }
+
+        socket.setNonBlocking();
+
+        TcpServerConnection connection = (static_cast<uint64_t>(index) << 48) | nextConnection++;
+        auto& client = clients[connection];
+        client.socket = std::move(socket);
+        selector.addSocket(client.socket);
+        increment(stats.accepted);
+
+        TcpServerEvent event;
+        event.type = TcpServerEventType::Connected;
+        event.connection = connection;
+        pushEvent(std::move(event));
+      }
+    }
+
+    void receivePackets() {
+      std::vector<TcpServerConnection> closed;
+
+      for (auto& item : clients) {
+        auto& client = item.second;
+
+        if (!selector.isReady(client.socket)) {
+          continue;
+        }
+
+        if (!readClient(item.first, client)) {
+          closed.push_back(item.first);
+        }
+      }
+
+      for (auto connection : closed) {
+        closeClient(connection);
+      }
+    }
+
+    bool readClient(TcpServerConnection connection, Client& client) {
+      for (;;) {
+        auto res = client.socket.recvRawBytes(readBuffer);
+
+        if (res.status == SocketStatus::Block) {
+          break;
+        }
+
+        if (res.status != SocketStatus::Data) {
+          return false;
+        }
+
+        client.input.insert(client.input.end(), readBuffer.begin(), readBuffer.begin() + res.length);
+        increment(stats.bytesReceived, res.length);
+
+        if (res.length < readBuffer.size()) {
+          break;
+        }
+
+        if (client.input.size() >= TcpServerHeaderSize + limits.maxPacketSize) {
+          // enough for a packet, the rest is read at the next iteration
+          break;
+        }
+      }
+
+      // extract all the complete packets
+      std::size_t offset = 0;
+
+      while (client.input.size() - offset >= TcpServerHeaderSize) {
+        priv::SizeHeader header;
+        std::copy_n(client.input.begin() + offset, TcpServerHeaderSize, std::begin(header.data));
+        auto size = priv::decodeHeader(header);
+
+        if (size > limits.maxPacketSize) {
+          Log::warning("Client %" PRIu64 " sent a packet too large (%" PRIu64 " bytes), disconnecting.\n", connection, size);
+          return false;
+        }
+
+        if (client.input.size() - offset - TcpServerHeaderSize < size) {
+          break;
+        }
+
+        auto first = client.input.begin() + offset + TcpServerHeaderSize;
+
+        TcpServerEvent event;
+        event.type = TcpServerEventType::Received;
+        event.connection = connection;
+        event.packet.bytes.assign(first, first + size);
+        pushEvent(std::move(event));
+        increment(stats.packetsReceived);
+
+        offset += TcpServerHeaderSize + size;
+      }
+
+      client.input.erase(client.input.begin(), client.input.begin() + offset);
+      return true;
+    }
+
+    void closeClient(TcpServerConnection connection) {
+      auto it = clients.find(connection);
+
+      if (it == clients.end()) {
+        return;
+      }
+
+      selector.removeSocket(it->second.socket);
+      clients.erase(it);
+      increment(stats.closed);
+
+      TcpServerEvent event;
+      event.type = TcpServerEventType::Disconnected;
+      event.connection = connection;
+      pushEvent(std::move(event));
+    }
+
+    void executeCommands() {
+      Command command;
+
+      while (commands.poll(command)) {
+        switch (command.type) {
+          case CommandType::Send: {
+            auto it = clients.find(command.connection);
+
+            if (it == clients.end()) {
+              break;
+            }
+
+            auto& client = it->second;
+            auto& output = client.output;
+
+            if (output.size() - client.outputOffset + TcpServerHeaderSize + command.bytes.size() > limits.maxPendingOutput) {
+              Log::warning("Client %" PRIu64 " does not read its packets, disconnecting.\n", command.connection);
+              closeClient(command.connection);
+              break;
+            }
+
+            if (output.empty()) {
+              pendingOutputs.push_back(command.connection);
+            }
+
+            auto header = priv::encodeHeader(command.bytes.size());
+            output.insert(output.end(), std::begin(header.data), std::end(header.data));
+            output.insert(output.end(), command.bytes.begin(), command.bytes.end());
+            client.outputPacketEnds.push_back(output.size());
+            break;
+          }
+
+          case CommandType::Disconnect:
+            closeClient(command.connection);
+            break;
+        }
+      }
+    }
+
+    void flushOutputs() {
+      std::vector<TcpServerConnection> closed;
+      std::size_t remaining = 0;
+
+      for (auto connection : pendingOutputs) {
+        auto it = clients.find(connection);
+
+        if (it == clients.end()) {
+          continue;
+        }
+
+        auto& client = it->second;
+
+        while (client.outputOffset < client.output.size()) {
+          auto res = client.socket.sendRawBytes(Span<const uint8_t>(client.output.data() + client.outputOffset, client.output.size() - client.outputOffset));
+
+          if (res.status == SocketStatus::Block) {
+            break;
+          }
+
+          if (res.status != SocketStatus::Data) {
+            closed.push_back(connection);
+            break;
+          }
+
+          client.outputOffset += res.length;
+          increment(stats.bytesSent, res.length);
+        }
+
+        // a packet is sent when its last byte is sent
+        while (client.outputPacketsSent < client.outputPacketEnds.size() && client.outputPacketEnds[client.outputPacketsSent] <= client.outputOffset) {
+          ++client.outputPacketsSent;
+          increment(stats.packetsSent);
+        }
+
+        if (client.outputOffset == client.output.size()) {
+          client.output.clear();
+          client.outputOffset = 0;
+          client.outputPacketEnds.clear();
+          client.outputPacketsSent = 0;
+        } else {
+          // the socket would block, try again at the next iteration
+          pendingOutputs[remaining++] = connection;
+        }
+      }
+
+      pendingOutputs.resize(remaining);
+
+      for (auto connection : closed) {
+        closeClient(connection);
+      }
+    }
+
+    void pushEvent(TcpServerEvent&& event) {
+      if (!pendingEvents.empty() || !events.push(std::move(event))) {
+        pendingEvents.push_back(std::move(event));
+      }
+    }
+
+    void flushEvents() {
+      while (!pendingEvents.empty() && events.push(std::move(pendingEvents.front()))) {
+        pendingEvents.pop_front();
+      }
+    }
+
+    std::size_t index;
+    TcpServerLimits limits;
+    TcpListener ownListener;
+    TcpListener *listener;
+    UdpSocket wakeup;
+    SocketAddress wakeupAddress;
+
+    SpscQueue<TcpServerEvent> events;
+    SpscQueue<Command> commands;
+    std::atomic_bool stop;
+    std::atomic_bool sleeping;
+    AtomicStats stats;
+
+    // only accessed by the worker thread
+    SocketSelector selector;
+    std::unordered_map<TcpServerConnection, Client> clients;
+    std::deque<TcpServerEvent> pendingEvents;
+    std::vector<TcpServerConnection> pendingOutputs;
+    std::vector<uint8_t> readBuffer;
+    uint64_t nextConnection;
+
+    std::thread thread;
+  };
+
+  TcpServer::TcpServer(const std::string& service, std::size_t workerCount, SocketFamily family, const TcpServerLimits& limits)
+  : m_nextWorker(0)
+  {
+    if (workerCount == 0) {
+      workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    TcpListener *sharedListener = nullptr;
+
+    if (!TcpListener::isReusePortSupported()) {
+      // all the workers poll the same listener, the first one accepts the connection
+      m_sharedListener = TcpListener(service, family, TcpListenerHints::ReuseAddress);
+
+      if (m_sharedListener) {
+        m_sharedListener.setNonBlocking();
+      }
+
+      sharedListener = &m_sharedListener;
+    }
+
+    for (std::size_t i = 0; i < workerCount; ++i) {
+      m_workers.push_back(std::make_unique<Worker>(i, sharedListener, service, family, limits));
+    }
+
+    if (!*this) {
+      Log::error("Unable to start the server on service '%s'.\n", service.c_str());
+      m_workers.clear();
+      return;
+    }
+
+    for (auto& worker : m_workers) {
+      Worker *current = worker.get();
+      current->thread = std::thread([current]() { current->run(); });
+    }
+  }
+
+  TcpServer::~TcpServer() {
+    for (auto& worker : m_workers) {
+      worker->stop.store(true);
+      worker->sleeping.store(true);
+      worker->wake();
+    }
+
+    for (auto& worker : m_workers) {
+      if (worker->thread.joinable()) {
+        worker->thread.join();
+      }
+    }
+  }
+
+  TcpServer::operator bool () const noexcept {
+    if (m_workers.empty()) {
+      return false;
+    }
+
+    return std::all_of(m_workers.begin(), m_workers.end(), [](const std::unique_ptr<Worker>& worker) {
+      return static_cast<bool>(*worker->listener) && static_cast<bool>(worker->wakeup);
+    });
+  }
+
+  bool TcpServer::pollEvent(TcpServerEvent& event) {
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+      auto& worker = *m_workers[m_nextWorker];
+      m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+
+      if (worker.events.poll(event)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool TcpServer::send(TcpServerConnection connection, Packet packet) {
+    std::size_t index = getWorkerOf(connection);
+    assert(index < m_workers.size());
+    auto& worker = *m_workers[index];
+
+    Worker::Command command;
+    command.type = Worker::CommandType::Send;
+    command.connection = connection;
+    command.bytes = std::move(packet.bytes);
+
+    if (!worker.commands.push(std::move(command))) {
+      return false;
+    }
+
+    worker.wake();
+    return true;
+  }
+
+  bool TcpServer::disconnect(TcpServerConnection connection) {
+    std::size_t index = getWorkerOf(connection);
+    assert(index < m_workers.size());
+    auto& worker = *m_workers[index];
+
+    Worker::Command command;
+    command.type = Worker::CommandType::Disconnect;
+    command.connection = connection;
+
+    if (!worker.commands.push(std::move(command))) {
+      return false;
+    }
+
+    worker.wake();
+    return true;
+  }
+
+  TcpServerStats TcpServer::getStats(std::size_t worker) const {
+    assert(worker < m_workers.size());
+    auto& stats = m_workers[worker]->stats;
+
+    TcpServerStats result;
+    result.accepted = stats.accepted.load(std::memory_order_relaxed);
+    result.closed = stats.closed.load(std::memory_order_relaxed);
+    result.packetsReceived = stats.packetsReceived.load(std::memory_order_relaxed);
+    result.packetsSent = stats.packetsSent.load(std::memory_order_relaxed);
+    result.bytesReceived = stats.bytesReceived.load(std::memory_order_relaxed);
+    result.bytesSent = stats.bytesSent.load(std::memory_order_relaxed);
+    return result;
+  }
+
+  TcpServerStats TcpServer::getStats() const {
+    TcpServerStats result;
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+      auto stats = getStats(i);
+      result.accepted += stats.accepted;
+      result.closed += stats.closed;
+      result.packetsReceived += stats.packetsReceived;
+      result.packetsSent += stats.packetsSent;
+      result.bytesReceived += stats.bytesReceived;
+      result.bytesSent += stats.bytesSent;
+    }
+
+    return result;
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+}
+#endif
+}
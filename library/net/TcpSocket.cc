@@ -31,6 +31,7 @@
 #else
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netdb.h>
 #endif
 
@@ -43,6 +44,50 @@ namespace gf {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 inline namespace v1 {
 #endif
+
+  namespace {
+
+    // send two buffers in a single call, without copying them in a single buffer
+    SocketDataResult sendGatheredBytes(SocketHandle handle, Span<const uint8_t> first, Span<const uint8_t> second) {
+#ifdef _WIN32
+      WSABUF buffers[2];
+      buffers[0].buf = const_cast<char *>(priv::sendPointer(first));
+      buffers[0].len = static_cast<ULONG>(first.getSize());
+      buffers[1].buf = const_cast<char *>(priv::sendPointer(second));
+      buffers[1].len = static_cast<ULONG>(second.getSize());
+
+      DWORD length = 0;
+      int res = ::WSASend(handle, buffers, 2, &length, 0, nullptr, nullptr);
+#else
+      iovec buffers[2];
+      buffers[0].iov_base = const_cast<void *>(priv::sendPointer(first));
+      buffers[0].iov_len = first.getSize();
+      buffers[1].iov_base = const_cast<void *>(priv::sendPointer(second));
+      buffers[1].iov_len = second.getSize();
+
+      msghdr message;
+      std::memset(&message, 0, sizeof(message));
+      message.msg_iov = buffers;
+      message.msg_iovlen = 2;
+
+      ssize_t res = ::sendmsg(handle, &message, priv::SendFlag);
+      ssize_t length = res;
+#endif
+
+      if (res == priv::InvalidCommunication) {
+        if (priv::nativeWouldBlock(priv::getErrorCode())) {
+          return { SocketStatus::Block, 0u };
+        }
+
+        gf::Log::error("Error while sending data. Reason: %s\n", priv::getErrorString().c_str());
+        return { SocketStatus::Error, 0u };
+      }
+
+      return { SocketStatus::Data, static_cast<std::size_t>(length) };
+    }
+
+  }
+
   TcpSocket::TcpSocket(const std::string& hostname, const std::string& service, SocketFamily family)
   {
     setHandle(priv::nativeConnect(hostname, service, family));
@@ -76,7 +121,7 @@ inline namespace v1 {
   }
 
   SocketDataResult TcpSocket::sendRawBytes(Span<const uint8_t> buffer) {
-    int res = ::send(getHandle(), priv::sendPointer(buffer), priv::sendLength(buffer), priv::NoFlag);
+    int res = ::send(getHandle(), priv::sendPointer(buffer), priv::sendLength(buffer), priv::SendFlag);
 
     if (res == priv::InvalidCommunication) {
       if (priv::nativeWouldBlock(priv::getErrorCode())) {
@@ -153,13 +198,36 @@ inline namespace v1 {
     auto size = static_cast<uint64_t>(packet.bytes.size());
     auto header = priv::encodeHeader(size);
 
-    auto status = sendBytes(header.data);
+    // the header and the bytes are sent in a single call, otherwise Nagle's
+    // algorithm holds the bytes back until the header is acknowledged
+    Span<const uint8_t> headerBytes(header.data, sizeof(header.data));
+    Span<const uint8_t> bytes(packet.bytes.data(), packet.bytes.size());
 
-    if (status != SocketStatus::Data) {
-      return status;
+    while (!headerBytes.isEmpty()) {
+      auto res = sendGatheredBytes(getHandle(), headerBytes, bytes);
+
+      switch (res.status) {
+        case SocketStatus::Data:
+          if (res.length < headerBytes.getSize()) {
+            headerBytes = headerBytes.lastExcept(res.length);
+          } else {
+            bytes = bytes.lastExcept(res.length - headerBytes.getSize());
+            headerBytes = Span<const uint8_t>();
+          }
+          break;
+        case SocketStatus::Block:
+          continue;
+        case SocketStatus::Close:
+        case SocketStatus::Error:
+          return res.status;
+      }
+    }
+
+    if (bytes.isEmpty()) {
+      return SocketStatus::Data;
     }
 
-    return sendBytes(packet.bytes);
+    return sendBytes(bytes);
   }
 
   SocketStatus TcpSocket::recvPacket(Packet& packet) {
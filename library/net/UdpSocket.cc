@@ -49,6 +49,11 @@ inline namespace v1 {
     setHandle(priv::nativeBind(service, family));
   }
 
+  UdpSocket::UdpSocket(const std::string& hostname, const std::string& service, SocketFamily family)
+  {
+    setHandle(priv::nativeBind(hostname, service, family));
+  }
+
   UdpSocket::UdpSocket(AnyType, SocketFamily family)
   {
     setHandle(priv::nativeBind("0", family));
@@ -66,7 +71,7 @@ inline namespace v1 {
 
 
   SocketDataResult UdpSocket::sendRawBytesTo(Span<const uint8_t> buffer, const SocketAddress& address) {
-    auto res = ::sendto(getHandle(), priv::sendPointer(buffer), priv::sendLength(buffer), priv::NoFlag, reinterpret_cast<const sockaddr*>(&address.storage), address.length);
+    auto res = ::sendto(getHandle(), priv::sendPointer(buffer), priv::sendLength(buffer), priv::SendFlag, reinterpret_cast<const sockaddr*>(&address.storage), address.length);
 
     if (res == priv::InvalidCommunication) {
       if (priv::nativeWouldBlock(priv::getErrorCode())) {
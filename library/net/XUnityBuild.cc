@@ -24,11 +24,13 @@
  * See: https://en.wikipedia.org/wiki/Single_Compilation_Unit
  */
 
+#include "PacketDispatcher.cc"
 #include "SocketAddress.cc"
 #include "Socket.cc"
 #include "SocketGuard.cc"
 #include "SocketPrivate.cc"
 #include "SocketSelector.cc"
 #include "TcpListener.cc"
+#include "TcpServer.cc"
 #include "TcpSocket.cc"
 #include "UdpSocket.cc"
@@ -0,0 +1,110 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/Array2DOps.h>
+
+#include <functional>
+
+#include "gtest/gtest.h"
+
+TEST(Array2DOpsTest, FillRegion) {
+  gf::Array2D<int, int> array({ 4, 3 }, 0);
+
+  gf::fillRegion(array, gf::RectI::fromMinMax({ 1, 1 }, { 6, 2 }), 7);
+
+  for (auto pos : array.getPositionRange()) {
+    if (pos.y == 1 && pos.x >= 1) {
+      EXPECT_EQ(7, array(pos));
+    } else {
+      EXPECT_EQ(0, array(pos));
+    }
+  }
+}
+
+TEST(Array2DOpsTest, CopyRegion) {
+  gf::Array2D<int, int> src({ 4, 4 }, 0);
+
+  for (auto pos : src.getPositionRange()) {
+    src(pos) = pos.y * 10 + pos.x;
+  }
+
+  gf::Array2D<int, int> dst({ 3, 3 }, -1);
+  gf::copyRegion(src, gf::RectI::fromMinMax({ -1, 1 }, { 3, 3 }), dst, { 0, 1 });
+
+  EXPECT_EQ(-1, dst({ 0, 0 }));
+  EXPECT_EQ(-1, dst({ 0, 1 }));
+  EXPECT_EQ(10, dst({ 1, 1 }));
+  EXPECT_EQ(11, dst({ 2, 1 }));
+  EXPECT_EQ(20, dst({ 1, 2 }));
+  EXPECT_EQ(21, dst({ 2, 2 }));
+}
+
+TEST(Array2DOpsTest, MapZipReduce) {
+  for (auto execution : { gf::Array2DExecution::Sequential, gf::Array2DExecution::Parallel }) {
+    gf::Array2D<double, int> array({ 256, 256 }, 1.0);
+    gf::Array2D<double, int> other({ 256, 256 }, 2.0);
+
+    gf::mapArray(array, [](double value) { return value * 3.0; }, execution);
+    gf::zipArrays(array, other, std::plus<double>(), execution);
+
+    double sum = gf::reduceArray(array, 0.0, std::plus<double>(), execution);
+    EXPECT_DOUBLE_EQ(5.0 * 256 * 256, sum);
+  }
+}
+
+TEST(Array2DOpsTest, ConvolveSeparable) {
+  gf::Array2D<double, int> array({ 5, 5 }, 0.0);
+  array({ 2, 2 }) = 16.0;
+
+  const double weights[] = { 0.25, 0.5, 0.25 };
+  auto out = gf::convolveSeparable<double, int>(array, weights, weights);
+
+  EXPECT_DOUBLE_EQ(4.0, out({ 2, 2 }));
+  EXPECT_DOUBLE_EQ(2.0, out({ 1, 2 }));
+  EXPECT_DOUBLE_EQ(1.0, out({ 1, 1 }));
+  EXPECT_DOUBLE_EQ(0.0, out({ 0, 0 }));
+
+  double sum = gf::reduceArray(out, 0.0, std::plus<double>());
+  EXPECT_DOUBLE_EQ(16.0, sum);
+}
+
+TEST(Array2DOpsTest, SummedAreaTable) {
+  gf::Array2D<int, int> array({ 4, 3 }, 0);
+
+  for (auto pos : array.getPositionRange()) {
+    array(pos) = pos.x + pos.y;
+  }
+
+  auto table = gf::computeSummedAreaTable(array);
+
+  for (auto pos : array.getPositionRange()) {
+    int expected = 0;
+
+    for (int y = 1; y <= pos.y; ++y) {
+      for (int x = 2; x <= pos.x; ++x) {
+        expected += array({ x, y });
+      }
+    }
+
+    EXPECT_EQ(expected, gf::computeRegionSum(table, gf::RectI::fromMinMax({ 2, 1 }, pos + 1)));
+  }
+
+  EXPECT_EQ(30, gf::computeRegionSum(table, gf::RectI::fromMinMax({ -2, -2 }, { 10, 10 })));
+}
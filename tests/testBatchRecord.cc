@@ -0,0 +1,64 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/BatchRecord.h>
+
+#include "gtest/gtest.h"
+
+TEST(BatchRecordTest, Unchanged) {
+  gf::Matrix3f transform = gf::identity<gf::Matrix3f>();
+
+  gf::BatchRecord record;
+  record.add(1, transform);
+  record.add(7, transform);
+
+  EXPECT_EQ(2u, record.getCount());
+  EXPECT_FALSE(record.hasChanged(0, 1, transform));
+  EXPECT_FALSE(record.hasChanged(1, 7, transform));
+}
+
+TEST(BatchRecordTest, Changed) {
+  gf::Matrix3f transform = gf::identity<gf::Matrix3f>();
+
+  gf::BatchRecord record;
+  record.add(1, transform);
+
+  // the geometry was invalidated
+  EXPECT_TRUE(record.hasChanged(0, 2, transform));
+
+  // the widget was moved
+  gf::Matrix3f moved = transform;
+  moved(0, 2) = 10.0f;
+  EXPECT_TRUE(record.hasChanged(0, 1, moved));
+
+  // the element was not recorded
+  EXPECT_TRUE(record.hasChanged(1, 1, transform));
+}
+
+TEST(BatchRecordTest, Clear) {
+  gf::Matrix3f transform = gf::identity<gf::Matrix3f>();
+
+  gf::BatchRecord record;
+  record.add(1, transform);
+  record.clear();
+
+  EXPECT_EQ(0u, record.getCount());
+  EXPECT_TRUE(record.hasChanged(0, 1, transform));
+}
@@ -0,0 +1,83 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/BlockAllocator.h>
+
+#include "gtest/gtest.h"
+
+TEST(BlockAllocatorTest, Reuse) {
+  gf::BlockAllocator<int> pool;
+
+  std::size_t a = pool.allocate();
+  std::size_t b = pool.allocate();
+  EXPECT_TRUE(pool.isAllocated(a));
+  EXPECT_EQ(2u, pool.getAllocated());
+
+  pool[a] = 42;
+  pool[b] = 69;
+
+  pool.dispose(a);
+  EXPECT_FALSE(pool.isAllocated(a));
+  EXPECT_TRUE(pool.isAllocated(b));
+  EXPECT_EQ(1u, pool.getAllocated());
+
+  EXPECT_EQ(a, pool.allocate());
+  EXPECT_EQ(0, pool[a]); // value-initialized again
+  EXPECT_EQ(69, pool[b]);
+  EXPECT_FALSE(pool.isAllocated(gf::NullIndex));
+}
+
+TEST(BlockAllocatorTest, Clear) {
+  gf::BlockAllocator<int> pool;
+  pool.reserve(20);
+
+  for (int i = 0; i < 20; ++i) {
+    pool[pool.allocate()] = i;
+  }
+
+  std::size_t capacity = pool.getCapacity();
+  EXPECT_GE(capacity, 20u);
+
+  pool.clear();
+  EXPECT_EQ(0u, pool.getAllocated());
+  EXPECT_EQ(capacity, pool.getCapacity());
+
+  EXPECT_EQ(0u, pool.allocate());
+  EXPECT_EQ(1u, pool.allocate());
+  EXPECT_EQ(2u, pool.getAllocated());
+}
+
+TEST(BlockAllocatorTest, MemoryStats) {
+  gf::MemoryUsage before = gf::MemoryStats::getUsage(gf::MemoryTag::Spatial);
+
+  {
+    gf::BlockAllocator<int, gf::MemoryTag::Spatial> pool;
+
+    for (int i = 0; i < 100; ++i) {
+      pool.allocate();
+    }
+
+    gf::BlockAllocator<int, gf::MemoryTag::Spatial> copy(pool);
+    EXPECT_EQ(100u, copy.getAllocated());
+    EXPECT_GT(gf::MemoryStats::getUsage(gf::MemoryTag::Spatial).liveBytes, before.liveBytes);
+  }
+
+  EXPECT_EQ(before.liveBytes, gf::MemoryStats::getUsage(gf::MemoryTag::Spatial).liveBytes);
+}
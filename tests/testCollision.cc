@@ -0,0 +1,114 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/Collision.h>
+
+#include <cmath>
+
+#include <gf/Math.h>
+#include <gf/Transform.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  gf::Polygon makeWall() {
+    // a thin vertical wall at x = 10
+    gf::Vector2f points[4] = { { 10.0f, -50.0f }, { 10.5f, -50.0f }, { 10.5f, 50.0f }, { 10.0f, 50.0f } };
+    return gf::Polygon(points);
+  }
+
+  gf::Polygon makeBox() {
+    gf::Vector2f points[4] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+    return gf::Polygon(points);
+  }
+
+}
+
+TEST(CollisionTest, TimeOfImpactCircles) {
+  gf::CircF circle({ 0.0f, 0.0f }, 1.0f);
+  gf::Impact impact;
+
+  EXPECT_TRUE(gf::timeOfImpact(circle, gf::Transform(), { 10.0f, 0.0f }, circle, gf::Transform({ 6.0f, 0.0f }), { 0.0f, 0.0f }, impact));
+  EXPECT_NEAR(impact.time, 0.4f, 1e-5f);
+  EXPECT_NEAR(impact.normal.x, 1.0f, 1e-5f);
+  EXPECT_NEAR(impact.normal.y, 0.0f, 1e-5f);
+
+  // both move toward each other
+  EXPECT_TRUE(gf::timeOfImpact(circle, gf::Transform(), { 5.0f, 0.0f }, circle, gf::Transform({ 6.0f, 0.0f }), { -5.0f, 0.0f }, impact));
+  EXPECT_NEAR(impact.time, 0.4f, 1e-5f);
+
+  // moving away
+  EXPECT_FALSE(gf::timeOfImpact(circle, gf::Transform(), { -10.0f, 0.0f }, circle, gf::Transform({ 6.0f, 0.0f }), { 0.0f, 0.0f }, impact));
+
+  // missing
+  EXPECT_FALSE(gf::timeOfImpact(circle, gf::Transform(), { 10.0f, 0.0f }, circle, gf::Transform({ 6.0f, 3.0f }), { 0.0f, 0.0f }, impact));
+
+  // too short
+  EXPECT_FALSE(gf::timeOfImpact(circle, gf::Transform(), { 3.0f, 0.0f }, circle, gf::Transform({ 6.0f, 0.0f }), { 0.0f, 0.0f }, impact));
+}
+
+TEST(CollisionTest, TimeOfImpactTunnelling) {
+  gf::CircF bullet({ 0.0f, 0.0f }, 0.25f);
+  gf::Polygon wall = makeWall();
+  gf::Penetration p;
+
+  // the discrete test misses the wall at both ends of the step
+  EXPECT_FALSE(gf::collides(bullet, gf::Transform(), wall, gf::Transform(), p));
+  EXPECT_FALSE(gf::collides(bullet, gf::Transform({ 20.0f, 0.0f }), wall, gf::Transform(), p));
+
+  gf::Impact impact;
+  EXPECT_TRUE(gf::timeOfImpact(bullet, gf::Transform(), { 20.0f, 0.0f }, wall, gf::Transform(), { 0.0f, 0.0f }, impact));
+  EXPECT_NEAR(impact.time * 20.0f, 9.75f, 0.02f);
+  EXPECT_NEAR(impact.normal.x, 1.0f, 1e-3f);
+
+  EXPECT_TRUE(gf::timeOfImpact(wall, gf::Transform(), { 0.0f, 0.0f }, bullet, gf::Transform(), { 20.0f, 0.0f }, impact));
+  EXPECT_NEAR(impact.time * 20.0f, 9.75f, 0.02f);
+  EXPECT_NEAR(impact.normal.x, -1.0f, 1e-3f);
+}
+
+TEST(CollisionTest, TimeOfImpactPolygons) {
+  gf::Polygon box = makeBox();
+  gf::Polygon wall = makeWall();
+  gf::Impact impact;
+
+  EXPECT_TRUE(gf::timeOfImpact(box, gf::Transform(), { 20.0f, 0.0f }, wall, gf::Transform(), { 0.0f, 0.0f }, impact));
+  EXPECT_NEAR(impact.time * 20.0f, 9.0f, 0.02f);
+  EXPECT_NEAR(impact.normal.x, 1.0f, 1e-3f);
+
+  // rotated box
+  EXPECT_TRUE(gf::timeOfImpact(box, gf::Transform(gf::Pi / 4), { 20.0f, 0.0f }, wall, gf::Transform(), { 0.0f, 0.0f }, impact));
+  EXPECT_NEAR(impact.time * 20.0f, 10.0f - std::sqrt(2.0f), 0.02f);
+
+  // parallel motion
+  EXPECT_FALSE(gf::timeOfImpact(box, gf::Transform(), { 0.0f, 20.0f }, wall, gf::Transform(), { 0.0f, 0.0f }, impact));
+
+  // overlapping at the start
+  EXPECT_TRUE(gf::timeOfImpact(box, gf::Transform({ 10.0f, 0.0f }), { 1.0f, 0.0f }, wall, gf::Transform(), { 0.0f, 0.0f }, impact));
+  EXPECT_EQ(impact.time, 0.0f);
+}
+
+TEST(CollisionTest, SweptBounds) {
+  gf::RectF bounds = gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 1.0f, 1.0f });
+  gf::RectF swept = gf::computeSweptBounds(bounds, { 10.0f, -5.0f });
+
+  EXPECT_EQ(swept.min, gf::vec(0.0f, -5.0f));
+  EXPECT_EQ(swept.max, gf::vec(11.0f, 1.0f));
+}
@@ -0,0 +1,181 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/CollisionWorld.h>
+
+#include <vector>
+
+#include <gf/Math.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  struct EventLog {
+    std::vector<gf::CollisionEvent> events;
+
+    gf::CollisionEventCallback callback() {
+      return [this](const gf::CollisionEvent& event) {
+        events.push_back(event);
+      };
+    }
+
+    std::size_t count(gf::CollisionEventType type) const {
+      std::size_t n = 0;
+
+      for (auto& event : events) {
+        if (event.type == type) {
+          ++n;
+        }
+      }
+
+      return n;
+    }
+  };
+
+}
+
+TEST(CollisionWorldTest, BeginPersistEnd) {
+  gf::CollisionWorld world;
+  auto a = world.addCircle(gf::Handle(gf::Id(1)), gf::CircF({ 0.0f, 0.0f }, 1.0f), gf::Transform({ 0.0f, 0.0f }));
+  auto b = world.addCircle(gf::Handle(gf::Id(2)), gf::CircF({ 0.0f, 0.0f }, 1.0f), gf::Transform({ 1.5f, 0.0f }));
+
+  EventLog log;
+  world.update(gf::milliseconds(16), log.callback());
+  ASSERT_EQ(log.events.size(), 1u);
+  EXPECT_EQ(log.events[0].type, gf::CollisionEventType::Begin);
+  EXPECT_EQ(log.events[0].lhsHandle.asId(), gf::Id(1));
+  EXPECT_EQ(log.events[0].rhsHandle.asId(), gf::Id(2));
+  EXPECT_NEAR(log.events[0].penetration.depth, 0.5f, 1e-5f);
+
+  log.events.clear();
+  world.update(gf::milliseconds(16), log.callback());
+  ASSERT_EQ(log.events.size(), 1u);
+  EXPECT_EQ(log.events[0].type, gf::CollisionEventType::Persist);
+
+  log.events.clear();
+  world.setTransform(b, gf::Transform({ 10.0f, 0.0f }));
+  world.update(gf::milliseconds(16), log.callback());
+  ASSERT_EQ(log.events.size(), 1u);
+  EXPECT_EQ(log.events[0].type, gf::CollisionEventType::End);
+  EXPECT_EQ(world.getPairCount(), 0u);
+
+  (void) a;
+}
+
+TEST(CollisionWorldTest, NarrowPhaseOnlyOnMovedPairs) {
+  gf::CollisionWorld world;
+  world.setSleepingEnabled(false);
+
+  for (int i = 0; i < 10; ++i) {
+    world.addRectangle(gf::Handle(gf::Id(i)), gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 1.0f, 1.0f }), gf::Transform({ i * 0.5f, 0.0f }));
+  }
+
+  EventLog log;
+  world.update(gf::milliseconds(16), log.callback());
+  EXPECT_EQ(log.count(gf::CollisionEventType::Begin), 9u);
+  EXPECT_GE(world.getNarrowPhaseCount(), 9u);
+
+  log.events.clear();
+  world.update(gf::milliseconds(16), log.callback());
+  EXPECT_EQ(world.getNarrowPhaseCount(), 0u);
+  EXPECT_EQ(log.count(gf::CollisionEventType::Persist), 9u);
+}
+
+TEST(CollisionWorldTest, RotatedRectangle) {
+  gf::CollisionWorld world;
+  world.addRectangle(gf::Handle(gf::Id(1)), gf::RectF::fromCenterSize({ 0.0f, 0.0f }, { 2.0f, 2.0f }), gf::Transform(gf::Pi / 4, { 0.0f, 0.0f }));
+  world.addCircle(gf::Handle(gf::Id(2)), gf::CircF({ 0.0f, 0.0f }, 0.2f), gf::Transform({ 1.3f, 0.0f }));
+
+  EventLog log;
+  world.update(gf::milliseconds(16), log.callback());
+  EXPECT_EQ(log.count(gf::CollisionEventType::Begin), 1u);
+}
+
+TEST(CollisionWorldTest, StaticBodies) {
+  gf::CollisionWorld world;
+  world.addRectangle(gf::Handle(gf::Id(1)), gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 2.0f, 2.0f }), gf::Transform(), gf::CollisionBodyType::Static);
+  world.addRectangle(gf::Handle(gf::Id(2)), gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 2.0f, 2.0f }), gf::Transform({ 1.0f, 0.0f }), gf::CollisionBodyType::Static);
+
+  EventLog log;
+  world.update(gf::milliseconds(16), log.callback());
+  EXPECT_TRUE(log.events.empty());
+  EXPECT_EQ(world.getPairCount(), 0u);
+}
+
+TEST(CollisionWorldTest, Sleeping) {
+  gf::CollisionWorld world;
+  world.setSleepDelay(gf::milliseconds(100));
+  world.addRectangle(gf::Handle(gf::Id(1)), gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 2.0f, 2.0f }), gf::Transform(), gf::CollisionBodyType::Static);
+  auto body = world.addCircle(gf::Handle(gf::Id(2)), gf::CircF({ 0.0f, 0.0f }, 1.0f), gf::Transform({ 2.5f, 1.0f }));
+
+  EventLog log;
+  world.update(gf::milliseconds(60), log.callback());
+  EXPECT_EQ(log.count(gf::CollisionEventType::Begin), 1u);
+  EXPECT_TRUE(world.isAwake(body));
+
+  world.update(gf::milliseconds(60), log.callback());
+  EXPECT_FALSE(world.isAwake(body));
+
+  log.events.clear();
+  world.update(gf::milliseconds(60), log.callback());
+  EXPECT_TRUE(log.events.empty());
+
+  world.setTransform(body, gf::Transform({ 2.4f, 1.0f }));
+  EXPECT_TRUE(world.isAwake(body));
+  world.update(gf::milliseconds(60), log.callback());
+  EXPECT_EQ(log.count(gf::CollisionEventType::Persist), 1u);
+}
+
+TEST(CollisionWorldTest, RemoveBody) {
+  gf::CollisionWorld world;
+  world.addCircle(gf::Handle(gf::Id(1)), gf::CircF({ 0.0f, 0.0f }, 1.0f));
+  auto b = world.addCircle(gf::Handle(gf::Id(2)), gf::CircF({ 0.0f, 0.0f }, 1.0f), gf::Transform({ 1.0f, 0.0f }));
+
+  EventLog log;
+  world.update(gf::milliseconds(16), log.callback());
+  EXPECT_EQ(log.count(gf::CollisionEventType::Begin), 1u);
+
+  // move far away and remove before the next update
+  world.setTransform(b, gf::Transform({ 100.0f, 0.0f }));
+  world.removeBody(b);
+  EXPECT_EQ(world.getBodyCount(), 1u);
+
+  log.events.clear();
+  world.update(gf::milliseconds(16), log.callback());
+  ASSERT_EQ(log.events.size(), 1u);
+  EXPECT_EQ(log.events[0].type, gf::CollisionEventType::End);
+  EXPECT_EQ(log.events[0].rhsHandle.asId(), gf::Id(2));
+}
+
+TEST(CollisionWorldTest, Cast) {
+  gf::CollisionWorld world;
+  gf::Vector2f wall[4] = { { 10.0f, -50.0f }, { 10.5f, -50.0f }, { 10.5f, 50.0f }, { 10.0f, 50.0f } };
+  world.addPolygon(gf::Handle(gf::Id(1)), gf::Polygon(wall), gf::Transform(), gf::CollisionBodyType::Static);
+  world.addRectangle(gf::Handle(gf::Id(2)), gf::RectF::fromPositionSize({ 15.0f, -50.0f }, { 1.0f, 100.0f }), gf::Transform(), gf::CollisionBodyType::Static);
+  auto bullet = world.addCircle(gf::Handle(gf::Id(3)), gf::CircF({ 0.0f, 0.0f }, 0.25f));
+
+  gf::CollisionHit hit;
+  ASSERT_TRUE(world.cast(bullet, { 30.0f, 0.0f }, hit));
+  EXPECT_EQ(hit.handle.asId(), gf::Id(1));
+  EXPECT_NEAR(hit.impact.time * 30.0f, 9.75f, 0.02f);
+
+  EXPECT_FALSE(world.cast(bullet, { -30.0f, 0.0f }, hit));
+}
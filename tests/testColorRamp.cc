@@ -0,0 +1,85 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/ColorRamp.h>
+
+#include <cstdlib>
+
+#include <gf/Image.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  gf::ColorRampD createRamp() {
+    gf::ColorRampD ramp;
+    ramp.addColorStop(0.0, gf::Color4d(0.0, 0.0, 0.5, 1.0));
+    ramp.addColorStop(0.5, gf::Color4d(0.0, 0.75, 1.0, 1.0));
+    ramp.addColorStop(0.6, gf::Color4d(0.9, 0.9, 0.25, 1.0));
+    ramp.addColorStop(1.0, gf::Color4d(1.0, 1.0, 1.0, 1.0));
+    return ramp;
+  }
+
+}
+
+TEST(ColorRampTest, BakeEmpty) {
+  gf::ColorRampD ramp;
+  gf::BakedColorRamp baked = ramp.bake();
+
+  EXPECT_TRUE(baked.isEmpty());
+  EXPECT_EQ(gf::Color4u(0xFF, 0xFF, 0xFF, 0xFF), baked.computeColor(0.5f));
+}
+
+TEST(ColorRampTest, BakeMatchesRamp) {
+  gf::ColorRampD ramp = createRamp();
+  gf::BakedColorRamp baked = ramp.bake(4096);
+
+  EXPECT_EQ(4096u, baked.getSize());
+
+  for (int i = 0; i <= 1000; ++i) {
+    double offset = i / 1000.0;
+    gf::Color4u expected = gf::ColorD::toRgba32(ramp.computeColor(offset));
+    gf::Color4u actual = baked.computeColor(static_cast<float>(offset));
+
+    for (std::size_t k = 0; k < 4; ++k) {
+      EXPECT_LE(std::abs(expected[k] - actual[k]), 1);
+    }
+  }
+}
+
+TEST(ColorRampTest, BakeClamp) {
+  gf::ColorRampD ramp = createRamp();
+  gf::BakedColorRamp baked = ramp.bake(16);
+
+  EXPECT_EQ(gf::ColorD::toRgba32(ramp.computeColor(0.0)), baked.computeColor(-1.0f));
+  EXPECT_EQ(gf::ColorD::toRgba32(ramp.computeColor(1.0)), baked.computeColor(2.0f));
+}
+
+TEST(ColorRampTest, BakeToImage) {
+  gf::ColorRampD ramp = createRamp();
+  gf::BakedColorRamp baked = ramp.bake(8);
+  gf::Image image = baked.copyToImage();
+
+  EXPECT_EQ(gf::Vector2i(8, 1), image.getSize());
+
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(baked.computeColor(i / 7.0f), image.getPixel({ i, 0 }));
+  }
+}
@@ -0,0 +1,134 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/FrameArena.h>
+
+#include "gtest/gtest.h"
+
+TEST(FrameArenaTest, Alignment) {
+  gf::FrameArena arena(256);
+
+  arena.allocate(1, 1);
+  void *ptr = arena.allocate(16, 16);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 16);
+
+  arena.allocate(3, 1);
+  ptr = arena.allocate(8, 8);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 8);
+}
+
+TEST(FrameArenaTest, Rewind) {
+  gf::FrameArena arena(256);
+
+  arena.allocate(32);
+  auto marker = arena.getMarker();
+  std::size_t used = arena.getUsedSize();
+
+  arena.allocate(64);
+  arena.allocate(512);
+  EXPECT_GT(arena.getUsedSize(), used);
+
+  arena.rewind(marker);
+  EXPECT_EQ(used, arena.getUsedSize());
+
+  {
+    gf::FrameArenaScope scope(arena);
+    arena.allocate(100);
+  }
+
+  EXPECT_EQ(used, arena.getUsedSize());
+}
+
+TEST(FrameArenaTest, Deallocate) {
+  gf::FrameArena arena(256);
+
+  void *first = arena.allocate(16, 16);
+  void *second = arena.allocate(16, 16);
+  std::size_t used = arena.getUsedSize();
+
+  arena.deallocate(first, 16); // not the last one
+  EXPECT_EQ(used, arena.getUsedSize());
+
+  arena.deallocate(second, 16);
+  EXPECT_EQ(arena.allocate(16, 16), second);
+}
+
+TEST(FrameArenaTest, ResetMergesChunks) {
+  gf::FrameArena arena(128);
+
+  for (int i = 0; i < 10; ++i) {
+    arena.allocate(100);
+  }
+
+  EXPECT_GT(arena.getHeapAllocationCount(), 1u);
+
+  std::size_t capacity = arena.getCapacity();
+  arena.reset();
+  EXPECT_EQ(capacity, arena.getCapacity());
+  EXPECT_EQ(0u, arena.getUsedSize());
+
+  auto count = arena.getHeapAllocationCount();
+
+  for (int i = 0; i < 10; ++i) {
+    arena.allocate(100);
+  }
+
+  EXPECT_EQ(count, arena.getHeapAllocationCount());
+}
+
+TEST(FrameArenaTest, SteadyStateFrames) {
+  gf::FrameArena arena(1024);
+
+  auto frame = [&arena](int n) {
+    gf::FrameVector<int> values{gf::FrameAllocator<int>(arena)};
+
+    for (int i = 0; i < n; ++i) {
+      values.push_back(i);
+    }
+
+    gf::FrameVector<double> others(values.begin(), values.end(), gf::FrameAllocator<double>(arena));
+    return others.back();
+  };
+
+  // warm up
+
+  for (int i = 0; i < 3; ++i) {
+    frame(2000);
+    arena.reset();
+  }
+
+  auto count = arena.getHeapAllocationCount();
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(1999.0, frame(2000));
+    arena.reset();
+  }
+
+  EXPECT_EQ(count, arena.getHeapAllocationCount());
+}
+
+TEST(FrameArenaTest, ThreadLocal) {
+  gf::FrameArena& arena = gf::FrameArena::getThreadLocal();
+  EXPECT_EQ(&arena, &gf::FrameArena::getThreadLocal());
+
+  gf::FrameAllocator<int> allocator;
+  EXPECT_EQ(&arena, allocator.getArena());
+  EXPECT_TRUE(allocator == gf::FrameAllocator<char>(arena));
+}
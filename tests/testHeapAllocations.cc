@@ -0,0 +1,126 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <cstdlib>
+
+#include <atomic>
+#include <new>
+
+#include <gf/FrameArena.h>
+#include <gf/StringUtils.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * These tests replace the global allocation functions to count the heap
+ * allocations, so they are built in their own executable.
+ */
+
+namespace {
+
+  std::atomic<std::size_t> g_heapAllocations(0);
+
+  std::size_t getHeapAllocations() {
+    return g_heapAllocations.load(std::memory_order_relaxed);
+  }
+
+}
+
+void *operator new(std::size_t size) {
+  g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+TEST(HeapAllocationsTest, Counter) {
+  auto before = getHeapAllocations();
+  auto words = gf::splitInWords("one two three");
+  EXPECT_GT(getHeapAllocations(), before);
+  EXPECT_EQ(3u, words.size());
+}
+
+TEST(HeapAllocationsTest, FrameArenaSteadyState) {
+  gf::FrameArena arena(1024);
+
+  auto frame = [&arena](int n) {
+    gf::FrameVector<int> values{gf::FrameAllocator<int>(arena)};
+
+    for (int i = 0; i < n; ++i) {
+      values.push_back(i);
+    }
+
+    gf::FrameVector<double> others(values.begin(), values.end(), gf::FrameAllocator<double>(arena));
+    return others.back();
+  };
+
+  // warm up
+
+  for (int i = 0; i < 3; ++i) {
+    frame(2000);
+    arena.reset();
+  }
+
+  auto before = getHeapAllocations();
+  double sum = 0.0;
+
+  for (int i = 0; i < 10; ++i) {
+    sum += frame(2000);
+    arena.reset();
+  }
+
+  EXPECT_EQ(before, getHeapAllocations());
+  EXPECT_EQ(19990.0, sum);
+}
+
+TEST(HeapAllocationsTest, SplitInFrameArena) {
+  gf::FrameArena arena(1024);
+  std::size_t count = 0;
+
+  auto frame = [&arena,&count]() {
+    gf::FrameArenaScope scope(arena);
+
+    for (auto paragraph : gf::splitInParagraphs("The quick brown fox\njumps over\tthe lazy dog", gf::FrameAllocator<gf::StringRef>(arena))) {
+      count += gf::splitInWords(paragraph, gf::FrameAllocator<gf::StringRef>(arena)).size();
+    }
+  };
+
+  frame(); // warm up
+
+  auto before = getHeapAllocations();
+
+  for (int i = 0; i < 10; ++i) {
+    frame();
+  }
+
+  EXPECT_EQ(before, getHeapAllocations());
+  EXPECT_EQ(99u, count);
+}
@@ -0,0 +1,103 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/Heightmap.h>
+
+#include <cstring>
+
+#include <gf/Noises.h>
+#include <gf/Random.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  gf::Heightmap createHeightmap(gf::Vector2i size) {
+    gf::Random random(42);
+    gf::PerlinNoise2D noise(random, 1.0);
+
+    gf::Heightmap heightmap(size);
+    heightmap.addNoise(noise, 4.0);
+    heightmap.normalize();
+    return heightmap;
+  }
+
+  bool areSameImages(const gf::Image& lhs, const gf::Image& rhs) {
+    if (lhs.getSize() != rhs.getSize()) {
+      return false;
+    }
+
+    auto size = lhs.getSize();
+    return std::memcmp(lhs.getPixelsPtr(), rhs.getPixelsPtr(), static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height) * 4) == 0;
+  }
+
+}
+
+TEST(HeightmapTest, GrayscaleExecution) {
+  gf::Heightmap heightmap = createHeightmap({ 300, 200 });
+
+  gf::Image sequential = heightmap.copyToGrayscaleImage(gf::Array2DExecution::Sequential);
+  gf::Image parallel = heightmap.copyToGrayscaleImage(gf::Array2DExecution::Parallel);
+
+  EXPECT_TRUE(areSameImages(sequential, parallel));
+
+  for (int y = 0; y < 200; ++y) {
+    for (int x = 0; x < 300; ++x) {
+      auto value = static_cast<uint8_t>(heightmap.getValue({ x, y }) * 255);
+      EXPECT_EQ(gf::Color4u(value, value, value, 0xFF), sequential.getPixel({ x, y }));
+    }
+  }
+}
+
+TEST(HeightmapTest, ColoredExecution) {
+  gf::Heightmap heightmap = createHeightmap({ 300, 200 });
+
+  gf::ColorRampD ramp;
+  ramp.addColorStop(0.0, gf::Color4d(0.0, 0.0, 0.5, 1.0));
+  ramp.addColorStop(0.5, gf::Color4d(0.0, 0.75, 1.0, 1.0));
+  ramp.addColorStop(1.0, gf::Color4d(1.0, 1.0, 1.0, 1.0));
+
+  for (auto render : { gf::Heightmap::Render::Colored, gf::Heightmap::Render::Shaded }) {
+    gf::Image sequential = heightmap.copyToColoredImage(ramp, 0.5, render, gf::Array2DExecution::Sequential);
+    gf::Image parallel = heightmap.copyToColoredImage(ramp, 0.5, render, gf::Array2DExecution::Parallel);
+
+    EXPECT_TRUE(areSameImages(sequential, parallel));
+  }
+}
+
+TEST(HeightmapTest, ShadedUnderWater) {
+  gf::Heightmap heightmap = createHeightmap({ 64, 64 });
+
+  gf::ColorRampD ramp;
+  ramp.addColorStop(0.0, gf::Color4d(0.0, 0.0, 0.5, 1.0));
+  ramp.addColorStop(1.0, gf::Color4d(1.0, 1.0, 1.0, 1.0));
+  gf::BakedColorRamp baked = ramp.bake();
+
+  gf::Image colored = heightmap.copyToColoredImage(baked, 0.5, gf::Heightmap::Render::Colored);
+  gf::Image shaded = heightmap.copyToColoredImage(baked, 0.5, gf::Heightmap::Render::Shaded);
+
+  for (int y = 0; y < 64; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      if (heightmap.getValue({ x, y }) < 0.5) {
+        EXPECT_EQ(colored.getPixel({ x, y }), shaded.getPixel({ x, y }));
+      }
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/Hexagon.h>
+#include <gf/Map.h>
+
+#include "gtest/gtest.h"
+
+TEST(HexagonTest, AxialConversion) {
+  gf::MapCellAxis axes[] = { gf::MapCellAxis::X, gf::MapCellAxis::Y };
+  gf::MapCellIndex indices[] = { gf::MapCellIndex::Odd, gf::MapCellIndex::Even };
+
+  for (auto axis : axes) {
+    for (auto index : indices) {
+      gf::HexagonHelper helper(axis, index);
+
+      for (int x = -5; x < 5; ++x) {
+        for (int y = -5; y < 5; ++y) {
+          gf::Vector2i offset(x, y);
+          EXPECT_EQ(offset, helper.convertAxialToOffset(helper.convertOffsetToAxial(offset)));
+        }
+      }
+    }
+  }
+}
+
+TEST(HexagonTest, Neighbors) {
+  gf::HexagonHelper helper(gf::MapCellAxis::X, gf::MapCellIndex::Odd);
+
+  for (int x = 0; x < 4; ++x) {
+    for (int y = 0; y < 4; ++y) {
+      gf::Vector2i coords(x, y);
+      gf::Vector2f center = helper.computeCenter(coords, 1.0f);
+
+      for (auto neighbor : helper.computeNeighbors(coords)) {
+        EXPECT_EQ(helper.computeDistance(coords, neighbor), 1);
+        gf::Vector2f d = helper.computeCenter(neighbor, 1.0f) - center;
+        EXPECT_NEAR(d.x * d.x + d.y * d.y, 3.0f, 1e-5f);
+      }
+    }
+  }
+}
+
+TEST(HexagonTest, Corners) {
+  gf::HexagonHelper helper(gf::MapCellAxis::Y, gf::MapCellIndex::Even);
+  auto expected = helper.computeCorners({ 2, 3 }, 10.0f);
+
+  gf::Vector2f corners[6];
+  helper.computeCorners({ 2, 3 }, 10.0f, corners);
+
+  for (std::size_t i = 0; i < 6; ++i) {
+    EXPECT_FLOAT_EQ(corners[i].x, expected[i].x);
+    EXPECT_FLOAT_EQ(corners[i].y, expected[i].y);
+  }
+}
+
+TEST(HexagonMapTest, Route) {
+  gf::HexagonMap map({ 10, 10 }, gf::MapCellAxis::X, gf::MapCellIndex::Odd);
+  map.reset(gf::EmptyCell);
+
+  for (int y = 0; y < 9; ++y) {
+    map.setWalkable({ 5, y }, false);
+  }
+
+  auto route = map.computeRoute({ 2, 2 }, { 8, 2 });
+  ASSERT_FALSE(route.empty());
+  EXPECT_EQ(route.front(), gf::Vector2i(2, 2));
+  EXPECT_EQ(route.back(), gf::Vector2i(8, 2));
+
+  for (std::size_t i = 1; i < route.size(); ++i) {
+    EXPECT_EQ(map.getHelper().computeDistance(route[i - 1], route[i]), 1);
+    EXPECT_TRUE(map.isWalkable(route[i]));
+  }
+
+  auto other = map.computeRoute({ 2, 2 }, { 8, 2 }, gf::Route::Dijkstra);
+  EXPECT_EQ(route.size(), other.size());
+
+  map.setWalkable({ 5, 9 }, false);
+  EXPECT_TRUE(map.computeRoute({ 2, 2 }, { 8, 2 }).empty());
+}
+
+TEST(HexagonMapTest, FlowField) {
+  gf::HexagonMap map({ 8, 8 }, gf::MapCellAxis::Y, gf::MapCellIndex::Even);
+  map.reset(gf::EmptyCell);
+  map.setWalkable({ 0, 0 }, false);
+
+  auto field = map.computeFlowField({ 4, 4 });
+  EXPECT_EQ(field({ 4, 4 }), gf::Vector2i(4, 4));
+  EXPECT_EQ(field({ 0, 0 }), gf::Vector2i(-1, -1));
+
+  auto route = map.computeRoute({ 7, 7 }, { 4, 4 });
+  std::size_t steps = 0;
+
+  for (gf::Vector2i curr = { 7, 7 }; curr != gf::Vector2i(4, 4); curr = field(curr)) {
+    ++steps;
+  }
+
+  EXPECT_EQ(steps + 1, route.size());
+}
+
+TEST(HexagonMapTest, FieldOfVision) {
+  gf::HexagonMap map({ 11, 11 }, gf::MapCellAxis::X, gf::MapCellIndex::Odd);
+  map.reset(gf::EmptyCell);
+  map.setTransparent({ 6, 5 }, false);
+
+  map.computeFieldOfVision({ 5, 5 });
+  EXPECT_TRUE(map.isInFieldOfVision({ 5, 5 }));
+  EXPECT_TRUE(map.isInFieldOfVision({ 6, 5 }));
+  EXPECT_TRUE(map.isInFieldOfVision({ 4, 5 }));
+  EXPECT_FALSE(map.isInFieldOfVision({ 7, 5 }));
+  EXPECT_FALSE(map.isInFieldOfVision({ 8, 5 }));
+  EXPECT_TRUE(map.isExplored({ 4, 5 }));
+
+  map.clearFieldOfVision();
+  map.computeLocalFieldOfVision({ 5, 5 }, 2, gf::FieldOfVisionLimit::Excluded);
+  EXPECT_FALSE(map.isInFieldOfVision({ 6, 5 }));
+  EXPECT_TRUE(map.isInFieldOfVision({ 3, 5 }));
+  EXPECT_FALSE(map.isInFieldOfVision({ 2, 5 }));
+}
@@ -0,0 +1,98 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/MemoryStats.h>
+
+#include <gf/Image.h>
+#include <gf/Spatial.h>
+
+#include "gtest/gtest.h"
+
+TEST(MemoryStatsTest, TrackedVector) {
+  auto before = gf::MemoryStats::getUsage(gf::MemoryTag::General);
+
+  {
+    gf::TrackedVector<int, gf::MemoryTag::General> values(100, 0);
+    auto during = gf::MemoryStats::getUsage(gf::MemoryTag::General);
+    EXPECT_EQ(before.liveBytes + 100 * sizeof(int), during.liveBytes);
+    EXPECT_EQ(before.allocationCount + 1, during.allocationCount);
+    EXPECT_GE(during.peakBytes, during.liveBytes);
+  }
+
+  auto after = gf::MemoryStats::getUsage(gf::MemoryTag::General);
+  EXPECT_EQ(before.liveBytes, after.liveBytes);
+  EXPECT_EQ(before.deallocationCount + 1, after.deallocationCount);
+}
+
+TEST(MemoryStatsTest, Reservation) {
+  auto before = gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes;
+
+  {
+    gf::MemoryReservation reservation(gf::MemoryTag::General, 1000);
+    EXPECT_EQ(before + 1000, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+
+    gf::MemoryReservation copy(reservation);
+    EXPECT_EQ(before + 2000, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+
+    gf::MemoryReservation moved(std::move(copy));
+    EXPECT_EQ(before + 2000, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+
+    moved.resize(500);
+    EXPECT_EQ(before + 1500, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+  }
+
+  EXPECT_EQ(before, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+}
+
+TEST(MemoryStatsTest, Peak) {
+  gf::MemoryStats::resetPeaks();
+  auto before = gf::MemoryStats::getUsage(gf::MemoryTag::General);
+  EXPECT_EQ(before.liveBytes, before.peakBytes);
+
+  {
+    gf::MemoryReservation reservation(gf::MemoryTag::General, 4096);
+  }
+
+  auto after = gf::MemoryStats::getUsage(gf::MemoryTag::General);
+  EXPECT_EQ(before.liveBytes, after.liveBytes);
+  EXPECT_EQ(before.liveBytes + 4096, after.peakBytes);
+}
+
+TEST(MemoryStatsTest, Subsystems) {
+  auto images = gf::MemoryStats::getUsage(gf::MemoryTag::Images).liveBytes;
+  auto spatial = gf::MemoryStats::getUsage(gf::MemoryTag::Spatial).liveBytes;
+
+  {
+    gf::Image image(gf::Vector2i(16, 16));
+    EXPECT_EQ(images + 16 * 16 * 4, gf::MemoryStats::getUsage(gf::MemoryTag::Images).liveBytes);
+
+    gf::DynamicTree tree;
+    tree.insert(gf::Handle(), gf::RectF::fromPositionSize({ 0.0f, 0.0f }, { 1.0f, 1.0f }));
+    EXPECT_GT(gf::MemoryStats::getUsage(gf::MemoryTag::Spatial).liveBytes, spatial);
+  }
+
+  EXPECT_EQ(images, gf::MemoryStats::getUsage(gf::MemoryTag::Images).liveBytes);
+  EXPECT_EQ(spatial, gf::MemoryStats::getUsage(gf::MemoryTag::Spatial).liveBytes);
+}
+
+TEST(MemoryStatsTest, TagNames) {
+  EXPECT_STREQ("Images", gf::MemoryStats::getTagName(gf::MemoryTag::Images));
+  EXPECT_STREQ("GPU buffers", gf::MemoryStats::getTagName(gf::MemoryTag::GpuBuffers));
+}
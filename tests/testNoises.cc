@@ -0,0 +1,169 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/Noises.h>
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include <gf/Random.h>
+#include <gf/VectorOps.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  // the gradient noise, computed from the accessors like in gradient_noise.frag
+  double computeGradientNoise(const gf::GradientNoise2D& noise, double x, double y) {
+    double lx = std::floor(x);
+    double ly = std::floor(y);
+    double rx = x - lx;
+    double ry = y - ly;
+
+    auto qx = static_cast<uint8_t>(std::fmod(lx, 256.0));
+    auto qy = static_cast<uint8_t>(std::fmod(ly, 256.0));
+
+    double p00 = gf::dot(noise.getGradient(qx, qy), gf::Vector2d(rx, ry));
+    double p10 = gf::dot(noise.getGradient(qx + 1, qy), gf::Vector2d(rx - 1.0, ry));
+    double p01 = gf::dot(noise.getGradient(qx, qy + 1), gf::Vector2d(rx, ry - 1.0));
+    double p11 = gf::dot(noise.getGradient(qx + 1, qy + 1), gf::Vector2d(rx - 1.0, ry - 1.0));
+
+    double u = noise.getStep()(rx);
+    double v = noise.getStep()(ry);
+
+    return gf::lerp(gf::lerp(p00, p10, u), gf::lerp(p01, p11, u), v);
+  }
+
+}
+
+TEST(NoisesTest, GradientNoise2D) {
+  gf::Random random(42);
+  gf::GradientNoise2D noise(random, gf::cubicStep);
+
+  EXPECT_EQ(noise.getStep(), static_cast<gf::Step<double>>(gf::cubicStep));
+
+  for (int j = 0; j < 256; j += 17) {
+    for (int i = 0; i < 256; i += 13) {
+      auto gradient = noise.getGradient(static_cast<uint8_t>(i), static_cast<uint8_t>(j));
+      EXPECT_NEAR(gf::euclideanLength(gradient), 1.0, 1e-10);
+    }
+  }
+
+  for (double y = 0.1; y < 10.0; y += 0.7) {
+    for (double x = 0.2; x < 10.0; x += 0.9) {
+      EXPECT_NEAR(noise(x, y), computeGradientNoise(noise, x, y), 1e-10);
+    }
+  }
+}
+
+TEST(NoisesTest, SimplexNoise2D) {
+  gf::Random random(42);
+  gf::SimplexNoise2D noise(random);
+
+  for (int j = 0; j < 256; ++j) {
+    for (int i = 0; i < 256; ++i) {
+      auto gradient = noise.getGradient(static_cast<uint8_t>(i), static_cast<uint8_t>(j));
+      EXPECT_TRUE(std::abs(gradient.x) == 1.0 || std::abs(gradient.x) == 2.0);
+      EXPECT_TRUE(std::abs(gradient.y) == 1.0 || std::abs(gradient.y) == 2.0);
+      EXPECT_EQ(std::abs(gradient.x) + std::abs(gradient.y), 3.0);
+    }
+  }
+}
+
+TEST(NoisesTest, WorleyNoise2D) {
+  static constexpr std::size_t Count = 10;
+
+  gf::Random random(42);
+  gf::WorleyNoise2D noise(random, Count, gf::euclideanDistance<double, 2>, { 1.0 });
+
+  EXPECT_EQ(noise.getDistance(), static_cast<gf::Distance2<double>>(gf::euclideanDistance<double, 2>));
+  ASSERT_EQ(noise.getCoefficients().size(), 1u);
+  EXPECT_EQ(noise.getCoefficients()[0], 1.0);
+
+  // each point and its three copies in the neighbor tiles
+  std::vector<gf::Vector2d> cells = noise.getCells();
+  ASSERT_EQ(cells.size(), 4 * Count);
+
+  for (auto cell : cells) {
+    EXPECT_GE(cell.x, -1.0);
+    EXPECT_LE(cell.x, 2.0);
+    EXPECT_GE(cell.y, -1.0);
+    EXPECT_LE(cell.y, 2.0);
+  }
+
+  for (double y = 0.05; y < 1.0; y += 0.1) {
+    for (double x = 0.05; x < 1.0; x += 0.1) {
+      double nearest = std::numeric_limits<double>::max();
+
+      for (auto cell : cells) {
+        nearest = std::min(nearest, gf::euclideanDistance(gf::Vector2d(x, y), cell));
+      }
+
+      EXPECT_NEAR(noise(x, y), nearest, 1e-10);
+    }
+  }
+}
+
+TEST(NoisesTest, FractalNoise2D) {
+  gf::Random random(42);
+  gf::GradientNoise2D gradient(random, gf::quinticStep);
+  gf::FractalNoise2D noise(gradient, 0.5, 4, 1.5, 0.25, 2.0);
+
+  EXPECT_EQ(noise.getScale(), 0.5);
+  EXPECT_EQ(noise.getOctaves(), 4u);
+  EXPECT_EQ(noise.getLacunarity(), 1.5);
+  EXPECT_EQ(noise.getPersistence(), 0.25);
+  EXPECT_EQ(noise.getDimension(), 2.0);
+
+  for (double x = 0.3; x < 20.0; x += 1.1) {
+    double y = 2.0 * x + 0.1;
+    double expected = 0.0;
+    double frequency = 1.0;
+    double amplitude = 1.0;
+
+    for (std::size_t k = 0; k < noise.getOctaves(); ++k) {
+      expected += computeGradientNoise(gradient, x * noise.getScale() * frequency, y * noise.getScale() * frequency) * std::pow(amplitude, noise.getDimension());
+      frequency *= noise.getLacunarity();
+      amplitude *= noise.getPersistence();
+    }
+
+    EXPECT_NEAR(noise(x, y), expected, 1e-10);
+  }
+}
+
+TEST(NoisesTest, PerlinNoise2D) {
+  gf::Random random(42);
+  gf::PerlinNoise2D noise(random, 2.0, 6);
+
+  const gf::FractalNoise2D& fractal = noise.getFractalNoise();
+  EXPECT_EQ(fractal.getScale(), 2.0);
+  EXPECT_EQ(fractal.getOctaves(), 6u);
+
+  const gf::GradientNoise2D& gradient = noise.getGradientNoise();
+  EXPECT_EQ(gradient.getStep(), static_cast<gf::Step<double>>(gf::quinticStep));
+
+  gf::GradientNoise2D copy = gradient;
+  gf::FractalNoise2D expected(copy, fractal.getScale(), fractal.getOctaves(), fractal.getLacunarity(), fractal.getPersistence(), fractal.getDimension());
+
+  for (double x = 0.3; x < 20.0; x += 1.1) {
+    EXPECT_NEAR(noise(x, 20.0 - x), expected(x, 20.0 - x), 1e-10);
+  }
+}
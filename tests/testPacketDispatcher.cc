@@ -0,0 +1,218 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/PacketDispatcher.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace gf::literals;
+
+namespace {
+
+  struct Ping {
+    static constexpr gf::Id type = "Ping"_id;
+    int32_t value = 0;
+  };
+
+  template<typename Archive>
+  Archive& operator|(Archive& ar, Ping& data) {
+    return ar | data.value;
+  }
+
+  struct Chat {
+    static constexpr gf::Id type = "Chat"_id;
+    std::string author;
+    std::vector<int32_t> data;
+  };
+
+  template<typename Archive>
+  Archive& operator|(Archive& ar, Chat& data) {
+    return ar | data.author | data.data;
+  }
+
+  struct Unknown {
+    static constexpr gf::Id type = "Unknown"_id;
+  };
+
+  template<typename Archive>
+  Archive& operator|(Archive& ar, Unknown&) {
+    return ar;
+  }
+
+  template<typename T>
+  gf::Packet makePacket(const T& data) {
+    gf::Packet packet;
+    packet.is(data);
+    return packet;
+  }
+
+  void appendFrame(std::vector<uint8_t>& buffer, const gf::Packet& packet) {
+    uint64_t size = packet.bytes.size();
+
+    for (int i = 7; i >= 0; --i) {
+      buffer.push_back(static_cast<uint8_t>(size >> (8 * i)));
+    }
+
+    buffer.insert(buffer.end(), packet.bytes.begin(), packet.bytes.end());
+  }
+
+}
+
+TEST(PacketDispatcherTest, Dispatch) {
+  gf::PacketDispatcher dispatcher;
+
+  int32_t sum = 0;
+  std::string author;
+
+  dispatcher.registerHandler<Ping>([&sum](Ping& ping) {
+    sum += ping.value;
+  });
+
+  dispatcher.registerHandler<Chat>([&author](Chat& chat) {
+    author = chat.author;
+  });
+
+  EXPECT_TRUE(dispatcher.hasHandler(Ping::type));
+  EXPECT_TRUE(dispatcher.hasHandler(Chat::type));
+  EXPECT_FALSE(dispatcher.hasHandler(Unknown::type));
+
+  Ping ping;
+  ping.value = 42;
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(ping)));
+  EXPECT_EQ(sum, 42);
+
+  Chat chat;
+  chat.author = "gf";
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(chat)));
+  EXPECT_EQ(author, "gf");
+
+  EXPECT_FALSE(dispatcher.dispatch(makePacket(Unknown())));
+
+  dispatcher.unregisterHandler(Ping::type);
+  EXPECT_FALSE(dispatcher.hasHandler(Ping::type));
+  EXPECT_FALSE(dispatcher.dispatch(makePacket(ping)));
+  EXPECT_EQ(sum, 42);
+}
+
+TEST(PacketDispatcherTest, Reuse) {
+  gf::PacketDispatcher dispatcher;
+
+  const int32_t *storage = nullptr;
+  std::size_t calls = 0;
+
+  dispatcher.registerHandler<Chat>([&](Chat& chat) {
+    if (calls == 0) {
+      storage = chat.data.data();
+    } else {
+      EXPECT_EQ(chat.data.data(), storage);
+    }
+
+    ++calls;
+  });
+
+  Chat chat;
+  chat.data.assign(64, 1);
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(chat)));
+
+  chat.data.assign(32, 2);
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(chat)));
+
+  EXPECT_EQ(calls, 2u);
+}
+
+TEST(PacketDispatcherTest, Buffer) {
+  gf::PacketDispatcher dispatcher;
+
+  std::vector<int32_t> values;
+
+  dispatcher.registerHandler<Ping>([&values](Ping& ping) {
+    values.push_back(ping.value);
+  });
+
+  std::vector<uint8_t> buffer;
+
+  for (int32_t i = 0; i < 10; ++i) {
+    Ping ping;
+    ping.value = i;
+    appendFrame(buffer, makePacket(ping));
+  }
+
+  appendFrame(buffer, makePacket(Unknown()));
+
+  std::size_t complete = buffer.size();
+
+  Ping last;
+  last.value = 10;
+  appendFrame(buffer, makePacket(last));
+  buffer.pop_back();
+
+  std::size_t dispatched = 0;
+  std::size_t consumed = dispatcher.dispatchBuffer(gf::span(buffer.data(), buffer.size()), &dispatched);
+
+  EXPECT_EQ(consumed, complete);
+  EXPECT_EQ(dispatched, 10u);
+  ASSERT_EQ(values.size(), 10u);
+
+  for (int32_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+TEST(PacketDispatcherTest, Table) {
+  static constexpr int32_t Count = 200;
+  gf::PacketDispatcher dispatcher;
+
+  std::vector<gf::Id> types;
+  std::vector<int32_t> received;
+
+  for (int32_t i = 0; i < Count; ++i) {
+    std::string name = "Type" + std::to_string(i);
+    gf::Id type = gf::hash(name.c_str(), name.size());
+    types.push_back(type);
+
+    dispatcher.registerHandler<Ping>(type, [&received, i](Ping& ping) {
+      EXPECT_EQ(ping.value, i);
+      received.push_back(i);
+    });
+  }
+
+  for (int32_t i = 0; i < Count; i += 2) {
+    dispatcher.unregisterHandler(types[i]);
+  }
+
+  for (int32_t i = 0; i < Count; ++i) {
+    EXPECT_EQ(dispatcher.hasHandler(types[i]), i % 2 == 1);
+
+    gf::Packet packet;
+    gf::BufferOutputStream stream(&packet.bytes);
+    gf::Serializer serializer(stream);
+    Ping ping;
+    ping.value = i;
+    serializer | types[i] | ping;
+
+    EXPECT_EQ(dispatcher.dispatch(packet), i % 2 == 1);
+  }
+
+  EXPECT_EQ(received.size(), static_cast<std::size_t>(Count / 2));
+}
@@ -0,0 +1,208 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/PoolAllocator.h>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <gf/Clock.h>
+#include <gf/MemoryStats.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  struct Counted {
+    Counted()
+    : value(0)
+    {
+      ++alive;
+    }
+
+    Counted(const Counted& other)
+    : value(other.value)
+    {
+      ++alive;
+    }
+
+    ~Counted() {
+      --alive;
+    }
+
+    int value;
+
+    static int alive;
+  };
+
+  int Counted::alive = 0;
+
+  struct Cached {
+    int value;
+  };
+
+  using CachedPool = gf::PoolAllocator<Cached, 16, gf::MemoryTag::General>;
+
+  // released after the thread cache of the main thread is destroyed
+  CachedPool g_staticPool;
+
+}
+
+TEST(PoolAllocatorTest, StableAddresses) {
+  gf::PoolAllocator<int, 4> pool;
+
+  std::size_t first = pool.allocate();
+  int *address = &pool[first];
+  *address = 42;
+
+  for (int i = 0; i < 100; ++i) {
+    pool[pool.allocate()] = i;
+  }
+
+  EXPECT_EQ(address, &pool[first]);
+  EXPECT_EQ(42, pool[first]);
+  EXPECT_EQ(101u, pool.getAllocated());
+  EXPECT_GE(pool.getCapacity(), 101u);
+}
+
+TEST(PoolAllocatorTest, Reuse) {
+  gf::PoolAllocator<int, 4> pool;
+
+  std::size_t a = pool.allocate();
+  std::size_t b = pool.allocate();
+  EXPECT_TRUE(pool.isAllocated(a));
+
+  pool.dispose(a);
+  EXPECT_FALSE(pool.isAllocated(a));
+  EXPECT_TRUE(pool.isAllocated(b));
+  EXPECT_EQ(1u, pool.getAllocated());
+
+  EXPECT_EQ(a, pool.allocate());
+  EXPECT_EQ(0, pool[a]); // value-initialized again
+  EXPECT_FALSE(pool.isAllocated(gf::NullIndex));
+}
+
+TEST(PoolAllocatorTest, Clear) {
+  gf::PoolAllocator<Counted, 8> pool;
+
+  for (int i = 0; i < 20; ++i) {
+    pool.allocate();
+  }
+
+  EXPECT_EQ(20, Counted::alive);
+  std::size_t capacity = pool.getCapacity();
+
+  pool.clear();
+  EXPECT_EQ(0, Counted::alive);
+  EXPECT_EQ(0u, pool.getAllocated());
+  EXPECT_EQ(capacity, pool.getCapacity());
+
+  EXPECT_EQ(0u, pool.allocate());
+  EXPECT_EQ(1u, pool.allocate());
+  EXPECT_EQ(capacity, pool.getCapacity());
+}
+
+TEST(PoolAllocatorTest, CopyAndMove) {
+  {
+    gf::PoolAllocator<Counted, 8> pool;
+
+    for (int i = 0; i < 10; ++i) {
+      pool[pool.allocate()].value = i;
+    }
+
+    pool.dispose(3);
+
+    gf::PoolAllocator<Counted, 8> copy(pool);
+    EXPECT_EQ(18, Counted::alive);
+    EXPECT_EQ(9u, copy.getAllocated());
+    EXPECT_FALSE(copy.isAllocated(3));
+    EXPECT_EQ(7, copy[7].value);
+    EXPECT_EQ(3u, copy.allocate());
+
+    gf::PoolAllocator<Counted, 8> moved(std::move(pool));
+    EXPECT_EQ(9u, moved.getAllocated());
+    EXPECT_EQ(0u, pool.getAllocated());
+    EXPECT_EQ(9, moved[9].value);
+  }
+
+  EXPECT_EQ(0, Counted::alive);
+}
+
+TEST(PoolAllocatorTest, CachedPages) {
+  auto live = gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes;
+
+  {
+    CachedPool pool;
+    pool.allocate();
+  }
+
+  // the page is in the thread cache and is still accounted
+  auto cached = gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes;
+  EXPECT_GT(cached, live);
+
+  {
+    CachedPool pool;
+    pool.allocate();
+    EXPECT_EQ(cached, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+  }
+
+  EXPECT_EQ(cached, gf::MemoryStats::getUsage(gf::MemoryTag::General).liveBytes);
+}
+
+TEST(PoolAllocatorTest, StaticPool) {
+  for (int i = 0; i < 100; ++i) {
+    g_staticPool[g_staticPool.allocate()].value = i;
+  }
+
+  EXPECT_EQ(100u, g_staticPool.getAllocated());
+}
+
+TEST(PoolAllocatorTest, AllocationThroughput) {
+  static constexpr std::size_t Count = 100000;
+
+  struct Payload {
+    float data[12];
+  };
+
+  gf::Clock clock;
+
+  std::vector<std::unique_ptr<Payload>> heap;
+
+  for (std::size_t i = 0; i < Count; ++i) {
+    heap.emplace_back(new Payload());
+  }
+
+  heap.clear();
+  std::cout << "Heap allocation time: " << clock.restart().asMicroseconds() << "us\n";
+
+  // the second round reuses the pages of the first one from the thread cache
+
+  for (int round = 1; round <= 2; ++round) {
+    gf::PoolAllocator<Payload> pool;
+
+    for (std::size_t i = 0; i < Count; ++i) {
+      pool.allocate();
+    }
+
+    EXPECT_EQ(Count, pool.getAllocated());
+    std::cout << "Pool allocation time (round " << round << "): " << clock.restart().asMicroseconds() << "us\n";
+  }
+}
@@ -0,0 +1,125 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/SnapshotHistory.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <gf/Map.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+  struct Body {
+    float x;
+    float y;
+    int32_t health;
+  };
+
+}
+
+TEST(SnapshotHistoryTest, Array) {
+  gf::SnapshotHistory history(4, 64);
+  gf::Array2D<int32_t, int> array({ 32, 32 }, 0);
+  history.track(array);
+
+  std::size_t pages = array.getDataSize() * sizeof(int32_t) / 64;
+
+  EXPECT_EQ(history.save(), pages);
+  EXPECT_EQ(history.save(), 0u);
+
+  array({ 3, 3 }) = 42;
+  EXPECT_EQ(history.save(), 1u);
+
+  array({ 30, 30 }) = 69;
+  array({ 3, 3 }) = 0;
+  EXPECT_EQ(history.save(), 2u);
+  EXPECT_EQ(history.getSnapshotCount(), 4u);
+
+  array({ 10, 10 }) = 1;
+
+  EXPECT_TRUE(history.restore());
+  EXPECT_EQ(array({ 10, 10 }), 0);
+  EXPECT_EQ(array({ 30, 30 }), 69);
+
+  EXPECT_TRUE(history.restore(1));
+  EXPECT_EQ(array({ 3, 3 }), 42);
+  EXPECT_EQ(array({ 30, 30 }), 0);
+  EXPECT_EQ(history.getSnapshotCount(), 3u);
+
+  EXPECT_FALSE(history.restore(3));
+}
+
+TEST(SnapshotHistoryTest, Capacity) {
+  gf::SnapshotHistory history(3);
+  gf::Array2D<int32_t, int> array({ 4, 4 }, 0);
+  history.track(array);
+
+  for (int32_t i = 0; i < 10; ++i) {
+    array({ 0, 0 }) = i;
+    history.save();
+  }
+
+  EXPECT_EQ(history.getSnapshotCount(), 3u);
+  EXPECT_TRUE(history.restore(2));
+  EXPECT_EQ(array({ 0, 0 }), 7);
+  EXPECT_EQ(history.getSnapshotCount(), 1u);
+}
+
+TEST(SnapshotHistoryTest, Pool) {
+  gf::SnapshotHistory history(4, 256);
+  std::vector<Body> bodies(100, Body{ 0.0f, 0.0f, 10 });
+  history.track(bodies);
+
+  history.save();
+
+  bodies[50].health = 5;
+  bodies.push_back(Body{ 1.0f, 1.0f, 1 });
+  history.save();
+
+  bodies.resize(10);
+  bodies[0].x = 2.0f;
+
+  EXPECT_TRUE(history.restore());
+  ASSERT_EQ(bodies.size(), 101u);
+  EXPECT_EQ(bodies[0].x, 0.0f);
+  EXPECT_EQ(bodies[50].health, 5);
+  EXPECT_EQ(bodies[100].health, 1);
+
+  EXPECT_TRUE(history.restore(1));
+  ASSERT_EQ(bodies.size(), 100u);
+  EXPECT_EQ(bodies[50].health, 10);
+}
+
+TEST(SnapshotHistoryTest, SquareMap) {
+  gf::SnapshotHistory history(2);
+  gf::SquareMap map({ 16, 16 });
+  map.trackState(history);
+
+  history.save();
+
+  map.setWalkable({ 5, 5 });
+  EXPECT_TRUE(map.isWalkable({ 5, 5 }));
+
+  EXPECT_TRUE(history.restore());
+  EXPECT_FALSE(map.isWalkable({ 5, 5 }));
+}
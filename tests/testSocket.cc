@@ -18,6 +18,7 @@
  *    misrepresented as being the original software.
  * 3. This notice may not be removed or altered from any source distribution.
  */
+#include <gf/Packet.h>
 #include <gf/SocketSelector.h>
 #include <gf/TcpListener.h>
 #include <gf/TcpSocket.h>
@@ -165,6 +166,54 @@ namespace {
     clientThread.join();
   }
 
+  template<gf::SocketFamily Family>
+  void testTcpSocketPacket() {
+    gf::TcpListener listener(TestService, Family);
+    ASSERT_TRUE(listener);
+
+    std::thread clientThread([]() {
+      gf::TcpSocket socket(Host, TestService, Family);
+      ASSERT_TRUE(socket);
+
+      for (uint8_t i = 0; i < 3; ++i) {
+        gf::Packet packet;
+        packet.bytes.assign(i * 1000u + 1u, i);
+        EXPECT_EQ(socket.sendPacket(packet), gf::SocketStatus::Data);
+      }
+
+      // larger than the socket buffer, so that it is sent in several parts
+      gf::Packet packet;
+      packet.bytes.resize(4 * 1024 * 1024);
+
+      for (std::size_t i = 0; i < packet.bytes.size(); ++i) {
+        packet.bytes[i] = static_cast<uint8_t>(i * 7);
+      }
+
+      EXPECT_EQ(socket.sendPacket(packet), gf::SocketStatus::Data);
+    });
+
+    gf::TcpSocket socket = listener.accept();
+    ASSERT_TRUE(socket);
+
+    for (uint8_t i = 0; i < 3; ++i) {
+      gf::Packet packet;
+      EXPECT_EQ(socket.recvPacket(packet), gf::SocketStatus::Data);
+      EXPECT_EQ(packet.bytes, std::vector<uint8_t>(i * 1000u + 1u, i));
+    }
+
+    gf::Packet packet;
+    EXPECT_EQ(socket.recvPacket(packet), gf::SocketStatus::Data);
+    ASSERT_EQ(packet.bytes.size(), 4u * 1024u * 1024u);
+
+    for (std::size_t i = 0; i < packet.bytes.size(); i += 4099) {
+      EXPECT_EQ(packet.bytes[i], static_cast<uint8_t>(i * 7));
+    }
+
+    EXPECT_EQ(socket.recvPacket(packet), gf::SocketStatus::Close);
+
+    clientThread.join();
+  }
+
   template<gf::SocketFamily Family>
   void testUdpSocketService() {
     gf::UdpSocket socket(TestService, Family);
@@ -347,6 +396,18 @@ TEST(SocketTest, TcpListenerNonBlockingV6) {
   testTcpListenerNonBlocking<gf::SocketFamily::IPv6>();
 }
 
+TEST(SocketTest, TcpSocketPacketUnspec) {
+  testTcpSocketPacket<gf::SocketFamily::Unspec>();
+}
+
+TEST(SocketTest, TcpSocketPacketV4) {
+  testTcpSocketPacket<gf::SocketFamily::IPv4>();
+}
+
+TEST(SocketTest, TcpSocketPacketV6) {
+  testTcpSocketPacket<gf::SocketFamily::IPv6>();
+}
+
 TEST(SocketTest, UdpSocketDefault) {
   gf::UdpSocket socket;
 
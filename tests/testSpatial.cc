@@ -234,6 +234,58 @@ namespace {
 
     EXPECT_EQ(result.set.size(), SampleSize);
   }
+
+  template<typename T>
+  void testMoveRandom(T& spatial) {
+    gf::Random random(51);
+    gf::SimpleSpatialIndex reference;
+
+    std::vector<gf::RectF> boxes;
+    std::vector<gf::SpatialId> ids;
+    std::vector<gf::SpatialId> referenceIds;
+
+    for (std::size_t i = 0; i < SampleSize; ++i) {
+      gf::Vector2f position(random.computeUniformFloat(3.0f, 96.0f), random.computeUniformFloat(3.0f, 96.0f));
+      auto box = gf::RectF::fromPositionSize(position, { 0.5f, 0.5f });
+      boxes.push_back(box);
+      ids.push_back(spatial.insert(gf::Handle(i), box));
+      referenceIds.push_back(reference.insert(gf::Handle(i), box));
+    }
+
+    gf::Clock clock;
+
+    for (std::size_t step = 0; step < 10; ++step) {
+      for (std::size_t i = 0; i < SampleSize; ++i) {
+        gf::Vector2f move(random.computeUniformFloat(-0.2f, 0.2f), random.computeUniformFloat(-0.2f, 0.2f));
+        boxes[i] = gf::RectF::fromPositionSize(boxes[i].getPosition() + move, boxes[i].getSize());
+        spatial.modify(ids[i], boxes[i]);
+        reference.modify(referenceIds[i], boxes[i]);
+      }
+    }
+
+    gf::Time moveTime = clock.restart();
+    std::cout << "Move time: " << moveTime.asMicroseconds() / 10 << "us\n";
+
+    for (std::size_t i = 0; i < QuerySize; ++i) {
+      auto queryBox = getRandomQueryBox(random);
+
+      Callback referenceResult;
+      reference.query(queryBox, std::ref(referenceResult), gf::SpatialQuery::Intersect);
+
+      Callback spatialResult;
+      spatial.query(queryBox, std::ref(spatialResult), gf::SpatialQuery::Intersect);
+
+      EXPECT_EQ(referenceResult.set, spatialResult.set);
+    }
+
+    for (auto id : ids) {
+      spatial.remove(id);
+    }
+
+    Callback result;
+    spatial.query(Bounds.grow(10.0f), std::ref(result), gf::SpatialQuery::Intersect);
+    EXPECT_TRUE(result.set.empty());
+  }
 }
 
 /*
@@ -289,6 +341,45 @@ TEST(SpatialTest, QuadtreeModifyRandom) {
   testModifyRandom(spatial);
 }
 
+TEST(SpatialTest, QuadtreeMoveRandom) {
+  gf::Quadtree spatial(Bounds);
+  testMoveRandom(spatial);
+}
+
+/*
+ * LooseQuadtree
+ */
+
+TEST(SpatialTest, LooseQuadtreeInsertSimple) {
+  gf::LooseQuadtree spatial(Bounds);
+  testInsertSimple(spatial);
+}
+
+TEST(SpatialTest, LooseQuadtreeInsertRandom) {
+  gf::LooseQuadtree spatial(Bounds);
+  testInsertRandom(spatial);
+}
+
+TEST(SpatialTest, LooseQuadtreeQueryRandom) {
+  gf::LooseQuadtree spatial(Bounds);
+  testQueryRandom(spatial);
+}
+
+TEST(SpatialTest, LooseQuadtreeRemoveRandom) {
+  gf::LooseQuadtree spatial(Bounds);
+  testRemoveRandom(spatial);
+}
+
+TEST(SpatialTest, LooseQuadtreeModifyRandom) {
+  gf::LooseQuadtree spatial(Bounds);
+  testModifyRandom(spatial);
+}
+
+TEST(SpatialTest, LooseQuadtreeMoveRandom) {
+  gf::LooseQuadtree spatial(Bounds);
+  testMoveRandom(spatial);
+}
+
 /*
  * DynamicTree
  */
@@ -0,0 +1,100 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/SpscQueue.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+TEST(SpscQueueTest, Capacity) {
+  gf::SpscQueue<int> queue(5);
+
+  EXPECT_EQ(queue.getCapacity(), 7u);
+  EXPECT_TRUE(queue.isEmpty());
+
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_TRUE(queue.push(i));
+  }
+
+  EXPECT_FALSE(queue.push(7));
+  EXPECT_FALSE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, Order) {
+  gf::SpscQueue<int> queue(4);
+  int value = 0;
+
+  EXPECT_FALSE(queue.poll(value));
+
+  for (int round = 0; round < 10; ++round) {
+    EXPECT_TRUE(queue.push(round));
+    EXPECT_TRUE(queue.push(round + 100));
+
+    EXPECT_TRUE(queue.poll(value));
+    EXPECT_EQ(value, round);
+    EXPECT_TRUE(queue.poll(value));
+    EXPECT_EQ(value, round + 100);
+  }
+
+  EXPECT_FALSE(queue.poll(value));
+  EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, MoveOnly) {
+  gf::SpscQueue<std::unique_ptr<int>> queue(2);
+
+  EXPECT_TRUE(queue.push(std::make_unique<int>(42)));
+
+  std::unique_ptr<int> value;
+  EXPECT_TRUE(queue.poll(value));
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, 42);
+}
+
+TEST(SpscQueueTest, Threads) {
+  static constexpr uint64_t Count = 100000;
+  gf::SpscQueue<uint64_t> queue(64);
+
+  std::thread producer([&queue]() {
+    for (uint64_t i = 0; i < Count; ++i) {
+      while (!queue.push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t expected = 0;
+  uint64_t value = 0;
+
+  while (expected < Count) {
+    if (queue.poll(value)) {
+      EXPECT_EQ(value, expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+  EXPECT_TRUE(queue.isEmpty());
+}
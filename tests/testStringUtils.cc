@@ -0,0 +1,99 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2018 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/StringUtils.h>
+
+#include <string>
+
+#include <gf/FrameArena.h>
+
+#include "gtest/gtest.h"
+
+TEST(StringUtilsTest, FormatString) {
+  const char *null = nullptr;
+  EXPECT_EQ("", gf::formatString(null));
+  EXPECT_EQ("42 foo", gf::formatString("%i %s", 42, "foo"));
+
+  std::string big(1000, 'x');
+  EXPECT_EQ(big, gf::formatString("%s", big.c_str()));
+}
+
+TEST(StringUtilsTest, FormatBufferInline) {
+  gf::FormatBuffer buffer;
+  EXPECT_EQ(0u, buffer.getSize());
+  EXPECT_STREQ("", buffer.getData());
+
+  gf::StringRef ref = buffer.format("HP: %i/%i", 7, 10);
+  EXPECT_EQ("HP: 7/10", std::string(ref.getData(), ref.getSize()));
+  EXPECT_EQ(ref.getData(), buffer.getData());
+  EXPECT_EQ(8u, buffer.getSize());
+  EXPECT_STREQ("HP: 7/10", buffer.getData());
+}
+
+TEST(StringUtilsTest, FormatBufferFallback) {
+  gf::FormatBuffer buffer;
+
+  std::string big(gf::FormatBuffer::InlineSize, 'x');
+  gf::StringRef ref = buffer.format("%s!", big.c_str());
+  EXPECT_EQ(big.size() + 1, ref.getSize());
+  EXPECT_EQ(big + "!", std::string(ref.getData(), ref.getSize()));
+  EXPECT_EQ('\0', buffer.getData()[ref.getSize()]);
+
+  // the heap buffer is reused for the next strings
+  const char *data = ref.getData();
+  ref = buffer.format("%s", "short");
+  EXPECT_EQ(data, ref.getData());
+  EXPECT_EQ("short", std::string(ref.getData(), ref.getSize()));
+}
+
+TEST(StringUtilsTest, FormatBufferNull) {
+  gf::FormatBuffer buffer;
+  buffer.format("%s", "foo");
+
+  const char *null = nullptr;
+  gf::StringRef ref = buffer.format(null);
+  EXPECT_EQ(0u, ref.getSize());
+  EXPECT_STREQ("", buffer.getData());
+}
+
+TEST(StringUtilsTest, SplitInParagraphs) {
+  auto paragraphs = gf::splitInParagraphs("\nfirst line\n\nsecond line\n");
+  ASSERT_EQ(2u, paragraphs.size());
+  EXPECT_EQ("first line", std::string(paragraphs[0].getData(), paragraphs[0].getSize()));
+  EXPECT_EQ("second line", std::string(paragraphs[1].getData(), paragraphs[1].getSize()));
+}
+
+TEST(StringUtilsTest, SplitInWords) {
+  auto words = gf::splitInWords(" one \t two  three");
+  ASSERT_EQ(3u, words.size());
+  EXPECT_EQ("one", std::string(words[0].getData(), words[0].getSize()));
+  EXPECT_EQ("two", std::string(words[1].getData(), words[1].getSize()));
+  EXPECT_EQ("three", std::string(words[2].getData(), words[2].getSize()));
+}
+
+TEST(StringUtilsTest, SplitWithAllocator) {
+  gf::FrameArena arena(1024);
+  gf::FrameArenaScope scope(arena);
+
+  gf::FrameVector<gf::StringRef> words = gf::splitInWords("one two\tthree", gf::FrameAllocator<gf::StringRef>(arena));
+  ASSERT_EQ(3u, words.size());
+  EXPECT_EQ("three", std::string(words[2].getData(), words[2].getSize()));
+  EXPECT_GT(arena.getUsedSize(), 0u);
+}
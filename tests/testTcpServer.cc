@@ -0,0 +1,251 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <gf/TcpServer.h>
+
+#include <cstdint>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gf/TcpSocket.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+  constexpr const char *TestService = "12346";
+  constexpr const char *Host = "localhost";
+
+  // poll the events until the predicate is true or a timeout occurs
+  template<typename Func>
+  bool pollUntil(gf::TcpServer& server, Func func) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    gf::TcpServerEvent event;
+
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (!server.pollEvent(event)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+
+      if (func(event)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+}
+
+TEST(TcpServerTest, Echo) {
+  static constexpr int ClientCount = 8;
+  static constexpr int PacketCount = 3;
+
+  gf::TcpServer server(TestService, 2, gf::SocketFamily::IPv4);
+  ASSERT_TRUE(server);
+  EXPECT_EQ(server.getWorkerCount(), 2u);
+
+  std::thread clientThread([]() {
+    std::vector<gf::TcpSocket> sockets;
+
+    for (int i = 0; i < ClientCount; ++i) {
+      sockets.emplace_back(Host, TestService, gf::SocketFamily::IPv4);
+      ASSERT_TRUE(sockets.back());
+    }
+
+    for (int k = 0; k < PacketCount; ++k) {
+      for (int i = 0; i < ClientCount; ++i) {
+        gf::Packet packet;
+        packet.bytes.assign(static_cast<std::size_t>(100 * k + i + 1), static_cast<uint8_t>(i));
+        EXPECT_EQ(sockets[i].sendPacket(packet), gf::SocketStatus::Data);
+      }
+    }
+
+    for (int i = 0; i < ClientCount; ++i) {
+      for (int k = 0; k < PacketCount; ++k) {
+        gf::Packet packet;
+        EXPECT_EQ(sockets[i].recvPacket(packet), gf::SocketStatus::Data);
+        EXPECT_EQ(packet.bytes, std::vector<uint8_t>(static_cast<std::size_t>(100 * k + i + 1), static_cast<uint8_t>(i)));
+      }
+    }
+  });
+
+  std::set<gf::TcpServerConnection> connections;
+  int received = 0;
+  int disconnected = 0;
+
+  bool done = pollUntil(server, [&](gf::TcpServerEvent& event) {
+    switch (event.type) {
+      case gf::TcpServerEventType::Connected:
+        EXPECT_LT(gf::TcpServer::getWorkerOf(event.connection), server.getWorkerCount());
+        EXPECT_TRUE(connections.insert(event.connection).second);
+        break;
+      case gf::TcpServerEventType::Received:
+        EXPECT_EQ(connections.count(event.connection), 1u);
+        EXPECT_TRUE(server.send(event.connection, std::move(event.packet)));
+        ++received;
+        break;
+      case gf::TcpServerEventType::Disconnected:
+        EXPECT_EQ(connections.count(event.connection), 1u);
+        ++disconnected;
+        break;
+    }
+
+    return disconnected == ClientCount;
+  });
+
+  clientThread.join();
+
+  EXPECT_TRUE(done);
+  EXPECT_EQ(connections.size(), static_cast<std::size_t>(ClientCount));
+  EXPECT_EQ(received, ClientCount * PacketCount);
+
+  auto stats = server.getStats();
+  EXPECT_EQ(stats.accepted, static_cast<uint64_t>(ClientCount));
+  EXPECT_EQ(stats.closed, static_cast<uint64_t>(ClientCount));
+  EXPECT_EQ(stats.packetsReceived, static_cast<uint64_t>(ClientCount * PacketCount));
+  EXPECT_EQ(stats.packetsSent, static_cast<uint64_t>(ClientCount * PacketCount));
+  EXPECT_EQ(stats.bytesReceived, stats.bytesSent);
+}
+
+TEST(TcpServerTest, Disconnect) {
+  gf::TcpServer server(TestService, 1, gf::SocketFamily::IPv4);
+  ASSERT_TRUE(server);
+
+  gf::TcpSocket socket(Host, TestService, gf::SocketFamily::IPv4);
+  ASSERT_TRUE(socket);
+
+  gf::TcpServerConnection connection = 0;
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    connection = event.connection;
+    return event.type == gf::TcpServerEventType::Connected;
+  }));
+
+  EXPECT_TRUE(server.disconnect(connection));
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    return event.type == gf::TcpServerEventType::Disconnected && event.connection == connection;
+  }));
+
+  gf::Packet packet;
+  EXPECT_EQ(socket.recvPacket(packet), gf::SocketStatus::Close);
+}
+
+TEST(TcpServerTest, PacketTooLarge) {
+  gf::TcpServerLimits limits;
+  limits.maxPacketSize = 16;
+
+  gf::TcpServer server(TestService, 1, gf::SocketFamily::IPv4, limits);
+  ASSERT_TRUE(server);
+
+  gf::TcpSocket socket(Host, TestService, gf::SocketFamily::IPv4);
+  ASSERT_TRUE(socket);
+
+  gf::Packet packet;
+  packet.bytes.assign(16, 0x42);
+  EXPECT_EQ(socket.sendPacket(packet), gf::SocketStatus::Data);
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    return event.type == gf::TcpServerEventType::Received && event.packet.bytes.size() == 16;
+  }));
+
+  packet.bytes.assign(17, 0x42);
+  EXPECT_EQ(socket.sendPacket(packet), gf::SocketStatus::Data);
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    return event.type == gf::TcpServerEventType::Disconnected;
+  }));
+
+  EXPECT_EQ(socket.recvPacket(packet), gf::SocketStatus::Close);
+}
+
+TEST(TcpServerTest, PendingOutputTooLarge) {
+  gf::TcpServerLimits limits;
+  limits.maxPendingOutput = 1024;
+
+  gf::TcpServer server(TestService, 1, gf::SocketFamily::IPv4, limits);
+  ASSERT_TRUE(server);
+
+  gf::TcpSocket socket(Host, TestService, gf::SocketFamily::IPv4);
+  ASSERT_TRUE(socket);
+
+  gf::TcpServerConnection connection = 0;
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    connection = event.connection;
+    return event.type == gf::TcpServerEventType::Connected;
+  }));
+
+  gf::Packet packet;
+  packet.bytes.assign(2048, 0x42);
+  EXPECT_TRUE(server.send(connection, packet));
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    return event.type == gf::TcpServerEventType::Disconnected && event.connection == connection;
+  }));
+
+  EXPECT_EQ(socket.recvPacket(packet), gf::SocketStatus::Close);
+}
+
+TEST(TcpServerTest, PacketsSentWhenCompleted) {
+  static constexpr uint64_t PacketCount = 32;
+
+  gf::TcpServerLimits limits;
+  limits.maxPendingOutput = 64 * 1024 * 1024;
+
+  gf::TcpServer server(TestService, 1, gf::SocketFamily::IPv4, limits);
+  ASSERT_TRUE(server);
+
+  gf::TcpSocket socket(Host, TestService, gf::SocketFamily::IPv4);
+  ASSERT_TRUE(socket);
+
+  gf::TcpServerConnection connection = 0;
+
+  EXPECT_TRUE(pollUntil(server, [&](gf::TcpServerEvent& event) {
+    connection = event.connection;
+    return event.type == gf::TcpServerEventType::Connected;
+  }));
+
+  gf::Packet packet;
+  packet.bytes.assign(1024 * 1024, 0x42);
+
+  for (uint64_t i = 0; i < PacketCount; ++i) {
+    EXPECT_TRUE(server.send(connection, packet));
+  }
+
+  // the client does not read yet, so the packets do not fit in the socket
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_LT(server.getStats().packetsSent, PacketCount);
+
+  for (uint64_t i = 0; i < PacketCount; ++i) {
+    ASSERT_EQ(socket.recvPacket(packet), gf::SocketStatus::Data);
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+  while (server.getStats().packetsSent < PacketCount && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  EXPECT_EQ(server.getStats().packetsSent, PacketCount);
+}
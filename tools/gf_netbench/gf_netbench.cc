@@ -0,0 +1,986 @@
+/*
+ * Gamedev Framework (gf)
+ * Copyright (C) 2016-2019 Julien Bernard
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <gf/Clock.h>
+#include <gf/Id.h>
+#include <gf/Packet.h>
+#include <gf/Random.h>
+#include <gf/SocketSelector.h>
+#include <gf/TcpListener.h>
+#include <gf/TcpServer.h>
+#include <gf/TcpSocket.h>
+#include <gf/Time.h>
+#include <gf/UdpSocket.h>
+#include <gf/Unused.h>
+
+using namespace gf::literals;
+
+namespace {
+
+  constexpr const char *Host = "127.0.0.1";
+  constexpr gf::SocketFamily Family = gf::SocketFamily::IPv4;
+  constexpr std::size_t DatagramSizeMax = 65507;
+
+  /*
+   * options
+   */
+
+  enum class Protocol {
+    Tcp,
+    Udp,
+  };
+
+  struct Impairment {
+    gf::Time latency;
+    gf::Time jitter;
+    double loss = 0.0;
+    double reorder = 0.0;
+    uint64_t bandwidth = 0; // in bytes per second, 0 means unlimited
+
+    bool isActive() const {
+      return latency > gf::Time::zero() || jitter > gf::Time::zero() || loss > 0.0 || reorder > 0.0 || bandwidth > 0;
+    }
+  };
+
+  struct Options {
+    Protocol protocol = Protocol::Tcp;
+    int clients = 100;
+    int messages = 100;
+    int threads = 2;
+    int workers = 0;
+    std::size_t size = 64;
+    gf::Time timeout = gf::milliseconds(1000);
+    int port = 23456;
+    Impairment impairment;
+  };
+
+  void printUsage(const char *program) {
+    std::printf("Usage: %s [options]\n", program);
+    std::printf("\n");
+    std::printf("Options:\n");
+    std::printf("  --protocol=tcp|udp  The transport protocol (default: tcp)\n");
+    std::printf("  --clients=N         The number of simulated clients (default: 100)\n");
+    std::printf("  --messages=N        The number of round trips per client (default: 100)\n");
+    std::printf("  --threads=N         The number of client threads (default: 2)\n");
+    std::printf("  --workers=N         The number of workers of a gf::TcpServer, 0 for a single-threaded\n"
+                "                      server with a gf::SocketSelector (default: 0, TCP only)\n");
+    std::printf("  --size=N            The size of the payload in bytes (default: 64)\n");
+    std::printf("  --timeout=MS        The time before a UDP message is considered lost, either by the\n"
+              "                      impairment or by the system (default: 1000)\n");
+    std::printf("  --port=N            The port of the echo server, the relay uses the next one (default: 23456)\n");
+    std::printf("\n");
+    std::printf("Impairment (applied in each direction):\n");
+    std::printf("  --latency=MS        The one-way latency\n");
+    std::printf("  --jitter=MS         The maximum deviation of the latency\n");
+    std::printf("  --loss=P            The probability of losing a packet (retransmission delay with TCP)\n");
+    std::printf("  --reorder=P         The probability of delaying a datagram behind the next ones (UDP only)\n");
+    std::printf("  --bandwidth=N       The capacity of the link in bytes per second\n");
+  }
+
+  bool parseOptions(int argc, char *argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+
+      if (arg == "--help") {
+        return false;
+      }
+
+      auto separator = arg.find('=');
+
+      if (arg.compare(0, 2, "--") != 0 || separator == std::string::npos) {
+        std::fprintf(stderr, "Invalid argument: '%s'\n", arg.c_str());
+        return false;
+      }
+
+      std::string name = arg.substr(2, separator - 2);
+      std::string value = arg.substr(separator + 1);
+
+      if (name == "protocol") {
+        if (value == "tcp") {
+          options.protocol = Protocol::Tcp;
+        } else if (value == "udp") {
+          options.protocol = Protocol::Udp;
+        } else {
+          std::fprintf(stderr, "Unknown protocol: '%s'\n", value.c_str());
+          return false;
+        }
+      } else if (name == "clients") {
+        options.clients = std::max(1, std::atoi(value.c_str()));
+      } else if (name == "messages") {
+        options.messages = std::max(1, std::atoi(value.c_str()));
+      } else if (name == "threads") {
+        options.threads = std::max(1, std::atoi(value.c_str()));
+      } else if (name == "workers") {
+        options.workers = std::max(0, std::atoi(value.c_str()));
+      } else if (name == "size") {
+        options.size = std::min(static_cast<std::size_t>(std::strtoul(value.c_str(), nullptr, 10)), DatagramSizeMax - 64);
+      } else if (name == "timeout") {
+        options.timeout = gf::microseconds(static_cast<int64_t>(std::atof(value.c_str()) * 1000));
+      } else if (name == "port") {
+        options.port = std::atoi(value.c_str());
+      } else if (name == "latency") {
+        options.impairment.latency = gf::microseconds(static_cast<int64_t>(std::atof(value.c_str()) * 1000));
+      } else if (name == "jitter") {
+        options.impairment.jitter = gf::microseconds(static_cast<int64_t>(std::atof(value.c_str()) * 1000));
+      } else if (name == "loss") {
+        options.impairment.loss = std::atof(value.c_str());
+      } else if (name == "reorder") {
+        options.impairment.reorder = std::atof(value.c_str());
+      } else if (name == "bandwidth") {
+        options.impairment.bandwidth = std::strtoull(value.c_str(), nullptr, 10);
+      } else {
+        std::fprintf(stderr, "Unknown option: '%s'\n", name.c_str());
+        return false;
+      }
+    }
+
+    options.threads = std::min(options.threads, options.clients);
+    return true;
+  }
+
+  /*
+   * messages
+   */
+
+  struct EchoMessage {
+    static constexpr gf::Id type = "gf_netbench.EchoMessage"_id;
+    uint32_t client;
+    uint32_t sequence;
+    int64_t timestamp;
+    std::vector<uint8_t> payload;
+  };
+
+  template<typename Archive>
+  Archive& operator|(Archive& ar, EchoMessage& message) {
+    return ar | message.client | message.sequence | message.timestamp | message.payload;
+  }
+
+  // all the timestamps are relative to the start of the program
+  gf::Clock g_clock;
+
+  gf::Time now() {
+    return g_clock.getElapsedTime();
+  }
+
+  gf::Packet createMessage(uint32_t client, uint32_t sequence, std::size_t size) {
+    EchoMessage message;
+    message.client = client;
+    message.sequence = sequence;
+    message.timestamp = now().asMicroseconds();
+    message.payload.resize(size);
+
+    gf::Packet packet;
+    packet.is(message);
+    return packet;
+  }
+
+  /*
+   * impairment
+   */
+
+  struct Delivery {
+    gf::Time time;
+    uint64_t order;
+    std::size_t connection;
+    std::vector<uint8_t> bytes;
+  };
+
+  struct DeliveryLater {
+    bool operator()(const Delivery& lhs, const Delivery& rhs) const {
+      return lhs.time > rhs.time || (lhs.time == rhs.time && lhs.order > rhs.order);
+    }
+  };
+
+  struct LinkStats {
+    uint64_t forwarded = 0;
+    uint64_t dropped = 0;
+    uint64_t retransmitted = 0;
+    uint64_t reordered = 0;
+  };
+
+  // one direction of an impaired link, it decides when (and if) each packet is delivered
+  class ImpairedLink {
+  public:
+    ImpairedLink(const Impairment& impairment, bool reliable, gf::Random& random)
+    : m_impairment(impairment)
+    , m_reliable(reliable)
+    , m_random(random)
+    , m_order(0)
+    {
+    }
+
+    void push(std::size_t connection, std::vector<uint8_t> bytes) {
+      gf::Time current = now();
+      gf::Time time = current;
+
+      if (m_impairment.bandwidth > 0) {
+        // the packets are serialized one after the other on the link
+        gf::Time start = std::max(current, m_linkFree);
+        m_linkFree = start + gf::microseconds(static_cast<int64_t>(bytes.size() * UINT64_C(1000000) / m_impairment.bandwidth));
+        time = m_linkFree;
+      }
+
+      int64_t jitter = m_impairment.jitter.asMicroseconds();
+      int64_t delay = m_impairment.latency.asMicroseconds() + m_random.computeUniformInteger(-jitter, jitter);
+      time += gf::microseconds(std::max(delay, INT64_C(0)));
+
+      if (m_random.computeBernoulli(m_impairment.loss)) {
+        if (!m_reliable) {
+          ++m_stats.dropped;
+          return;
+        }
+
+        // the packet is lost and then retransmitted after a retransmission timeout
+        time += std::max(gf::milliseconds(200), m_impairment.latency + m_impairment.latency);
+        ++m_stats.retransmitted;
+      }
+
+      if (m_reliable) {
+        // a stream is delivered in order, a late packet blocks the following ones of the same connection
+        if (connection >= m_lastDeliveries.size()) {
+          m_lastDeliveries.resize(connection + 1);
+        }
+
+        time = std::max(time, m_lastDeliveries[connection]);
+        m_lastDeliveries[connection] = time;
+      } else if (m_random.computeBernoulli(m_impairment.reorder)) {
+        // hold the datagram back so that the next ones overtake it
+        time += m_impairment.latency + m_impairment.jitter + gf::milliseconds(1);
+        ++m_stats.reordered;
+      }
+
+      m_queue.push(Delivery{ time, m_order++, connection, std::move(bytes) });
+    }
+
+    bool pop(Delivery& delivery) {
+      if (m_queue.empty() || m_queue.top().time > now()) {
+        return false;
+      }
+
+      delivery = m_queue.top();
+      m_queue.pop();
+      ++m_stats.forwarded;
+      return true;
+    }
+
+    gf::Time getNextDeliveryTime() const {
+      if (m_queue.empty()) {
+        return gf::seconds(1e6f);
+      }
+
+      return m_queue.top().time;
+    }
+
+    const LinkStats& getStats() const {
+      return m_stats;
+    }
+
+  private:
+    Impairment m_impairment;
+    bool m_reliable;
+    gf::Random& m_random;
+    std::priority_queue<Delivery, std::vector<Delivery>, DeliveryLater> m_queue;
+    uint64_t m_order;
+    gf::Time m_linkFree;
+    std::vector<gf::Time> m_lastDeliveries;
+    LinkStats m_stats;
+  };
+
+  gf::Time computeWaitDuration(const ImpairedLink& upstream, const ImpairedLink& downstream) {
+    gf::Time next = std::min(upstream.getNextDeliveryTime(), downstream.getNextDeliveryTime());
+    gf::Time duration = next - now();
+    return std::max(gf::Time::zero(), std::min(duration, gf::milliseconds(100)));
+  }
+
+  /*
+   * TCP
+   */
+
+  // the connections are accepted in a burst, otherwise a connection would
+  // wait for the next event to be accepted and the backlog could overflow
+  bool hasPendingConnection(gf::TcpListener& listener) {
+    gf::SocketSelector selector;
+    selector.addSocket(listener);
+    return selector.wait(gf::Time::zero()) == gf::SocketSelectorStatus::Event;
+  }
+
+  void runTcpServer(gf::TcpListener& listener, const std::atomic_bool& stop) {
+    gf::SocketSelector selector;
+    selector.addSocket(listener);
+
+    std::vector<std::unique_ptr<gf::TcpSocket>> sockets;
+    gf::Packet packet;
+
+    while (!stop) {
+      if (selector.wait(gf::milliseconds(100)) != gf::SocketSelectorStatus::Event) {
+        continue;
+      }
+
+      for (auto& socket : sockets) {
+        if (!*socket || !selector.isReady(*socket)) {
+          continue;
+        }
+
+        if (socket->recvPacket(packet) != gf::SocketStatus::Data || socket->sendPacket(packet) != gf::SocketStatus::Data) {
+          selector.removeSocket(*socket);
+          *socket = gf::TcpSocket();
+        }
+      }
+
+      sockets.erase(std::remove_if(sockets.begin(), sockets.end(), [](const std::unique_ptr<gf::TcpSocket>& socket) { return !*socket; }), sockets.end());
+
+      if (selector.isReady(listener)) {
+        do {
+          auto socket = std::make_unique<gf::TcpSocket>(listener.accept());
+
+          if (*socket) {
+            selector.addSocket(*socket);
+            sockets.push_back(std::move(socket));
+          }
+        } while (hasPendingConnection(listener));
+      }
+    }
+  }
+
+  void runTcpShardedServer(gf::TcpServer& server, const std::atomic_bool& stop) {
+    gf::TcpServerEvent event;
+
+    while (!stop) {
+      if (!server.pollEvent(event)) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      if (event.type == gf::TcpServerEventType::Received) {
+        while (!server.send(event.connection, event.packet)) {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  struct TcpRelayConnection {
+    gf::TcpSocket client;
+    gf::TcpSocket server;
+  };
+
+  void runTcpRelay(gf::TcpListener& listener, const Options& options, ImpairedLink& upstream, ImpairedLink& downstream, const std::atomic_bool& stop) {
+    gf::SocketSelector selector;
+    selector.addSocket(listener);
+
+    std::vector<std::unique_ptr<TcpRelayConnection>> connections;
+    std::string service = std::to_string(options.port);
+    gf::Packet packet;
+
+    auto close = [&selector](TcpRelayConnection& connection) {
+      if (connection.client) {
+        selector.removeSocket(connection.client);
+        connection.client = gf::TcpSocket();
+      }
+
+      if (connection.server) {
+        selector.removeSocket(connection.server);
+        connection.server = gf::TcpSocket();
+      }
+    };
+
+    while (!stop) {
+      if (selector.wait(computeWaitDuration(upstream, downstream)) == gf::SocketSelectorStatus::Event) {
+        for (std::size_t i = 0; i < connections.size(); ++i) {
+          auto& connection = *connections[i];
+
+          if (connection.client && selector.isReady(connection.client)) {
+            if (connection.client.recvPacket(packet) == gf::SocketStatus::Data) {
+              upstream.push(i, std::move(packet.bytes));
+            } else {
+              close(connection);
+            }
+          }
+
+          if (connection.server && selector.isReady(connection.server)) {
+            if (connection.server.recvPacket(packet) == gf::SocketStatus::Data) {
+              downstream.push(i, std::move(packet.bytes));
+            } else {
+              close(connection);
+            }
+          }
+        }
+
+        if (selector.isReady(listener)) {
+          do {
+            auto connection = std::make_unique<TcpRelayConnection>();
+            connection->client = listener.accept();
+            connection->server = gf::TcpSocket(Host, service, Family);
+
+            if (connection->client && connection->server) {
+              selector.addSocket(connection->client);
+              selector.addSocket(connection->server);
+            }
+
+            connections.push_back(std::move(connection));
+          } while (hasPendingConnection(listener));
+        }
+      }
+
+      Delivery delivery;
+
+      while (upstream.pop(delivery)) {
+        auto& connection = *connections[delivery.connection];
+        packet.bytes = std::move(delivery.bytes);
+
+        if (connection.server && connection.server.sendPacket(packet) != gf::SocketStatus::Data) {
+          close(connection);
+        }
+      }
+
+      while (downstream.pop(delivery)) {
+        auto& connection = *connections[delivery.connection];
+        packet.bytes = std::move(delivery.bytes);
+
+        if (connection.client && connection.client.sendPacket(packet) != gf::SocketStatus::Data) {
+          close(connection);
+        }
+      }
+    }
+  }
+
+  struct ClientStats {
+    std::vector<int64_t> latencies; // in microseconds
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t errors = 0;
+  };
+
+  void runTcpClients(uint32_t first, uint32_t count, const Options& options, const std::string& service, ClientStats& stats) {
+    struct Client {
+      gf::TcpSocket socket;
+      uint32_t id = 0;
+      uint32_t sequence = 0;
+    };
+
+    std::vector<std::unique_ptr<Client>> clients;
+    gf::SocketSelector selector;
+
+    // all the clients are connected before the first message, so that the
+    // connections do not count in the latency
+    for (uint32_t i = 0; i < count; ++i) {
+      auto client = std::make_unique<Client>();
+      client->id = first + i;
+      client->socket = gf::TcpSocket(Host, service, Family);
+
+      if (!client->socket) {
+        ++stats.errors;
+        continue;
+      }
+
+      selector.addSocket(client->socket);
+      clients.push_back(std::move(client));
+    }
+
+    std::size_t remaining = clients.size();
+
+    for (auto& client : clients) {
+      if (client->socket.sendPacket(createMessage(client->id, 0, options.size)) == gf::SocketStatus::Data) {
+        ++stats.sent;
+      } else {
+        ++stats.errors;
+        selector.removeSocket(client->socket);
+        client->socket = gf::TcpSocket();
+        --remaining;
+      }
+    }
+    gf::Packet packet;
+
+    while (remaining > 0) {
+      auto status = selector.wait(options.timeout + options.impairment.latency + options.impairment.latency + gf::seconds(1));
+
+      if (status != gf::SocketSelectorStatus::Event) {
+        // the server does not answer anymore
+        stats.errors += remaining;
+        break;
+      }
+
+      for (auto& client : clients) {
+        if (!client->socket || !selector.isReady(client->socket)) {
+          continue;
+        }
+
+        if (client->socket.recvPacket(packet) != gf::SocketStatus::Data) {
+          ++stats.errors;
+        } else {
+          auto message = packet.as<EchoMessage>();
+          stats.latencies.push_back(now().asMicroseconds() - message.timestamp);
+          ++stats.received;
+
+          if (++client->sequence < static_cast<uint32_t>(options.messages)) {
+            if (client->socket.sendPacket(createMessage(client->id, client->sequence, options.size)) == gf::SocketStatus::Data) {
+              ++stats.sent;
+              continue;
+            }
+
+            ++stats.errors;
+          }
+        }
+
+        selector.removeSocket(client->socket);
+        client->socket = gf::TcpSocket();
+        --remaining;
+      }
+    }
+  }
+
+  /*
+   * UDP
+   */
+
+  void runUdpServer(gf::UdpSocket& socket, const std::atomic_bool& stop) {
+    gf::SocketSelector selector;
+    selector.addSocket(socket);
+
+    socket.setNonBlocking();
+
+    std::vector<uint8_t> buffer(DatagramSizeMax);
+    gf::SocketAddress address;
+
+    while (!stop) {
+      if (selector.wait(gf::milliseconds(100)) != gf::SocketSelectorStatus::Event) {
+        continue;
+      }
+
+      for (;;) {
+        auto res = socket.recvRawBytesFrom(buffer, address);
+
+        if (res.status != gf::SocketStatus::Data) {
+          break;
+        }
+
+        socket.sendRawBytesTo(gf::Span<const uint8_t>(buffer.data(), res.length), address);
+      }
+    }
+  }
+
+  uint32_t getClientOf(std::vector<uint8_t> bytes) {
+    gf::Packet packet;
+    packet.bytes = std::move(bytes);
+    return packet.as<EchoMessage>().client;
+  }
+
+  void runUdpRelay(gf::UdpSocket& clientSide, const Options& options, ImpairedLink& upstream, ImpairedLink& downstream, const std::atomic_bool& stop) {
+    gf::UdpSocket serverSide(gf::Any, Family);
+    gf::SocketAddress serverAddress = serverSide.getRemoteAddress(Host, std::to_string(options.port));
+
+    gf::SocketSelector selector;
+    selector.addSocket(clientSide);
+    selector.addSocket(serverSide);
+
+    clientSide.setNonBlocking();
+    serverSide.setNonBlocking();
+
+    // the addresses of the clients, the index is used as the connection of the deliveries
+    std::vector<gf::SocketAddress> addresses;
+    std::map<uint32_t, std::size_t> connections;
+
+    std::vector<uint8_t> buffer(DatagramSizeMax);
+    gf::SocketAddress address;
+
+    while (!stop) {
+      if (selector.wait(computeWaitDuration(upstream, downstream)) == gf::SocketSelectorStatus::Event) {
+        for (;;) {
+          auto res = clientSide.recvRawBytesFrom(buffer, address);
+
+          if (res.status != gf::SocketStatus::Data) {
+            break;
+          }
+
+          std::vector<uint8_t> bytes(buffer.begin(), buffer.begin() + res.length);
+          auto result = connections.insert(std::make_pair(getClientOf(bytes), addresses.size()));
+
+          if (result.second) {
+            addresses.push_back(address);
+          }
+
+          upstream.push(result.first->second, std::move(bytes));
+        }
+
+        for (;;) {
+          auto res = serverSide.recvRawBytesFrom(buffer, address);
+
+          if (res.status != gf::SocketStatus::Data) {
+            break;
+          }
+
+          std::vector<uint8_t> bytes(buffer.begin(), buffer.begin() + res.length);
+          auto it = connections.find(getClientOf(bytes));
+
+          if (it != connections.end()) {
+            downstream.push(it->second, std::move(bytes));
+          }
+        }
+      }
+
+      Delivery delivery;
+
+      while (upstream.pop(delivery)) {
+        serverSide.sendRawBytesTo(delivery.bytes, serverAddress);
+      }
+
+      while (downstream.pop(delivery)) {
+        clientSide.sendRawBytesTo(delivery.bytes, addresses[delivery.connection]);
+      }
+    }
+  }
+
+  void runUdpClients(uint32_t first, uint32_t count, const Options& options, const std::string& service, ClientStats& stats) {
+    struct Client {
+      uint32_t sequence = 0;
+      gf::Time sentAt;
+      bool done = false;
+    };
+
+    // all the clients of a thread share the same socket, the messages tell them apart
+    gf::UdpSocket socket(gf::Any, Family);
+    gf::SocketAddress address = socket.getRemoteAddress(Host, service);
+
+    gf::SocketSelector selector;
+    selector.addSocket(socket);
+    socket.setNonBlocking();
+
+    std::vector<Client> clients(count);
+    std::size_t remaining = count;
+
+    auto send = [&](uint32_t index) {
+      auto& client = clients[index];
+
+      if (client.sequence >= static_cast<uint32_t>(options.messages)) {
+        client.done = true;
+        --remaining;
+        return;
+      }
+
+      gf::Packet packet = createMessage(first + index, client.sequence, options.size);
+
+      if (socket.sendBytesTo(packet.bytes, address)) {
+        ++stats.sent;
+      } else {
+        ++stats.errors;
+      }
+
+      client.sentAt = now();
+    };
+
+    for (uint32_t i = 0; i < count; ++i) {
+      send(i);
+    }
+
+    std::vector<uint8_t> buffer(DatagramSizeMax);
+    gf::SocketAddress sender;
+    gf::Packet packet;
+
+    while (remaining > 0) {
+      if (selector.wait(gf::milliseconds(10)) == gf::SocketSelectorStatus::Event) {
+        for (;;) {
+          auto res = socket.recvRawBytesFrom(buffer, sender);
+
+          if (res.status != gf::SocketStatus::Data) {
+            break;
+          }
+
+          packet.bytes.assign(buffer.begin(), buffer.begin() + res.length);
+          auto message = packet.as<EchoMessage>();
+          uint32_t index = message.client - first;
+
+          if (index >= count || clients[index].done || clients[index].sequence != message.sequence) {
+            // a late answer for a message that has already been declared lost
+            continue;
+          }
+
+          stats.latencies.push_back(now().asMicroseconds() - message.timestamp);
+          ++stats.received;
+          ++clients[index].sequence;
+          send(index);
+        }
+      }
+
+      gf::Time current = now();
+
+      for (uint32_t i = 0; i < count; ++i) {
+        auto& client = clients[i];
+
+        if (!client.done && current - client.sentAt > options.timeout) {
+          ++stats.lost;
+          ++client.sequence;
+          send(i);
+        }
+      }
+    }
+  }
+
+  /*
+   * report
+   */
+
+  void raiseFileLimit(const Options& options) {
+#ifndef _WIN32
+    // each TCP client needs up to four descriptors (client, relay and server sides)
+    rlimit limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+      rlim_t needed = static_cast<rlim_t>(options.clients) * 4 + 64;
+
+      if (limit.rlim_cur < needed) {
+        limit.rlim_cur = std::min(needed, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+      }
+    }
+#else
+    gf::unused(options);
+#endif
+  }
+
+  double computePercentile(const std::vector<int64_t>& sorted, double percentile) {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+
+    auto index = static_cast<std::size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[index]);
+  }
+
+  void printReport(const Options& options, const ClientStats& stats, const LinkStats& upstream, const LinkStats& downstream, const gf::TcpServer *server, gf::Time duration) {
+    std::vector<int64_t> latencies = stats.latencies;
+    std::sort(latencies.begin(), latencies.end());
+
+    double mean = 0.0;
+
+    for (auto latency : latencies) {
+      mean += static_cast<double>(latency);
+    }
+
+    if (!latencies.empty()) {
+      mean /= static_cast<double>(latencies.size());
+    }
+
+    double seconds = std::max(duration.asSeconds(), 1e-6f);
+
+    std::printf("{\n");
+    std::printf("  \"protocol\": \"%s\",\n", options.protocol == Protocol::Tcp ? "tcp" : "udp");
+    std::printf("  \"clients\": %i,\n", options.clients);
+    std::printf("  \"messages_per_client\": %i,\n", options.messages);
+    std::printf("  \"threads\": %i,\n", options.threads);
+    std::printf("  \"workers\": %i,\n", options.workers);
+    std::printf("  \"payload_size\": %zu,\n", options.size);
+    std::printf("  \"impairment\": {\n");
+    std::printf("    \"latency_ms\": %.3f,\n", options.impairment.latency.asMicroseconds() / 1000.0);
+    std::printf("    \"jitter_ms\": %.3f,\n", options.impairment.jitter.asMicroseconds() / 1000.0);
+    std::printf("    \"loss\": %g,\n", options.impairment.loss);
+    std::printf("    \"reorder\": %g,\n", options.impairment.reorder);
+    std::printf("    \"bandwidth\": %" PRIu64 "\n", options.impairment.bandwidth);
+    std::printf("  },\n");
+    std::printf("  \"duration_s\": %.3f,\n", seconds);
+    std::printf("  \"sent\": %" PRIu64 ",\n", stats.sent);
+    std::printf("  \"received\": %" PRIu64 ",\n", stats.received);
+    std::printf("  \"lost\": %" PRIu64 ",\n", stats.lost);
+    std::printf("  \"errors\": %" PRIu64 ",\n", stats.errors);
+    std::printf("  \"round_trips_per_second\": %.1f,\n", static_cast<double>(stats.received) / seconds);
+    std::printf("  \"packets_per_second\": %.1f,\n", static_cast<double>(stats.sent + stats.received) / seconds);
+    std::printf("  \"latency_us\": {\n");
+    std::printf("    \"min\": %.0f,\n", computePercentile(latencies, 0.0));
+    std::printf("    \"mean\": %.1f,\n", mean);
+    std::printf("    \"p50\": %.0f,\n", computePercentile(latencies, 0.50));
+    std::printf("    \"p90\": %.0f,\n", computePercentile(latencies, 0.90));
+    std::printf("    \"p99\": %.0f,\n", computePercentile(latencies, 0.99));
+    std::printf("    \"max\": %.0f\n", computePercentile(latencies, 1.0));
+    std::printf("  },\n");
+    std::printf("  \"link\": {\n");
+    std::printf("    \"forwarded\": %" PRIu64 ",\n", upstream.forwarded + downstream.forwarded);
+    std::printf("    \"dropped\": %" PRIu64 ",\n", upstream.dropped + downstream.dropped);
+    std::printf("    \"retransmitted\": %" PRIu64 ",\n", upstream.retransmitted + downstream.retransmitted);
+    std::printf("    \"reordered\": %" PRIu64 "\n", upstream.reordered + downstream.reordered);
+
+    if (server == nullptr) {
+      std::printf("  }\n");
+      std::printf("}\n");
+      return;
+    }
+
+    std::printf("  },\n");
+    std::printf("  \"server_workers\": [\n");
+
+    for (std::size_t i = 0; i < server->getWorkerCount(); ++i) {
+      auto workerStats = server->getStats(i);
+      std::printf("    { \"accepted\": %" PRIu64 ", \"packets_received\": %" PRIu64 ", \"packets_sent\": %" PRIu64 " }%s\n", workerStats.accepted, workerStats.packetsReceived, workerStats.packetsSent, i + 1 < server->getWorkerCount() ? "," : "");
+    }
+
+    std::printf("  ]\n");
+    std::printf("}\n");
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  raiseFileLimit(options);
+
+  bool impaired = options.impairment.isActive();
+  std::string serverService = std::to_string(options.port);
+  std::string relayService = std::to_string(options.port + 1);
+  std::string clientService = impaired ? relayService : serverService;
+
+  std::atomic_bool stop(false);
+
+  gf::Random random;
+  bool reliable = (options.protocol == Protocol::Tcp);
+  ImpairedLink upstream(options.impairment, reliable, random);
+  ImpairedLink downstream(options.impairment, reliable, random);
+
+  // the sockets are bound before any client starts
+  gf::TcpListener tcpServer;
+  std::unique_ptr<gf::TcpServer> tcpShardedServer;
+  gf::TcpListener tcpRelay;
+  gf::UdpSocket udpServer;
+  gf::UdpSocket udpRelay;
+
+  std::thread serverThread;
+  std::thread relayThread;
+
+  if (options.protocol == Protocol::Tcp) {
+    if (options.workers > 0) {
+      tcpShardedServer = std::make_unique<gf::TcpServer>(serverService, static_cast<std::size_t>(options.workers), Family);
+
+      if (!*tcpShardedServer) {
+        std::fprintf(stderr, "Could not listen on port %s\n", serverService.c_str());
+        return 1;
+      }
+
+      serverThread = std::thread(runTcpShardedServer, std::ref(*tcpShardedServer), std::cref(stop));
+    } else {
+      tcpServer = gf::TcpListener(serverService, Family);
+
+      if (!tcpServer) {
+        std::fprintf(stderr, "Could not listen on port %s\n", serverService.c_str());
+        return 1;
+      }
+
+      serverThread = std::thread(runTcpServer, std::ref(tcpServer), std::cref(stop));
+    }
+
+    if (impaired) {
+      tcpRelay = gf::TcpListener(relayService, Family);
+
+      if (!tcpRelay) {
+        std::fprintf(stderr, "Could not listen on port %s\n", relayService.c_str());
+        stop = true;
+        serverThread.join();
+        return 1;
+      }
+
+      relayThread = std::thread(runTcpRelay, std::ref(tcpRelay), std::cref(options), std::ref(upstream), std::ref(downstream), std::cref(stop));
+    }
+  } else {
+    udpServer = gf::UdpSocket(serverService, Family);
+
+    if (!udpServer) {
+      std::fprintf(stderr, "Could not bind port %s\n", serverService.c_str());
+      return 1;
+    }
+
+    serverThread = std::thread(runUdpServer, std::ref(udpServer), std::cref(stop));
+
+    if (impaired) {
+      udpRelay = gf::UdpSocket(relayService, Family);
+
+      if (!udpRelay) {
+        std::fprintf(stderr, "Could not bind port %s\n", relayService.c_str());
+        stop = true;
+        serverThread.join();
+        return 1;
+      }
+
+      relayThread = std::thread(runUdpRelay, std::ref(udpRelay), std::cref(options), std::ref(upstream), std::ref(downstream), std::cref(stop));
+    }
+  }
+
+  std::vector<ClientStats> stats(static_cast<std::size_t>(options.threads));
+  std::vector<std::thread> clientThreads;
+
+  gf::Time start = now();
+  uint32_t first = 0;
+
+  for (int i = 0; i < options.threads; ++i) {
+    auto count = static_cast<uint32_t>(options.clients / options.threads + (i < options.clients % options.threads ? 1 : 0));
+
+    if (options.protocol == Protocol::Tcp) {
+      clientThreads.emplace_back(runTcpClients, first, count, std::cref(options), std::cref(clientService), std::ref(stats[i]));
+    } else {
+      clientThreads.emplace_back(runUdpClients, first, count, std::cref(options), std::cref(clientService), std::ref(stats[i]));
+    }
+
+    first += count;
+  }
+
+  for (auto& thread : clientThreads) {
+    thread.join();
+  }
+
+  gf::Time duration = now() - start;
+
+  stop = true;
+  serverThread.join();
+
+  if (relayThread.joinable()) {
+    relayThread.join();
+  }
+
+  ClientStats total;
+
+  for (auto& threadStats : stats) {
+    total.latencies.insert(total.latencies.end(), threadStats.latencies.begin(), threadStats.latencies.end());
+    total.sent += threadStats.sent;
+    total.received += threadStats.received;
+    total.lost += threadStats.lost;
+    total.errors += threadStats.errors;
+  }
+
+  printReport(options, total, upstream.getStats(), downstream.getStats(), tcpShardedServer.get(), duration);
+  return total.errors == 0 ? 0 : 2;
+}